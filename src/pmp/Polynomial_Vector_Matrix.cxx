@@ -1,19 +1,15 @@
 #include "Polynomial_Vector_Matrix.hxx"
 
+#include "convert/Prefactor_Cache.hxx"
 #include "sdpb_util/Boost_Float.hxx"
 #include "sdpb_util/assert.hxx"
 
 #include <boost/math/constants/constants.hpp>
 
-std::vector<Boost_Float> sample_points(const size_t &num_points);
-
 std::vector<Boost_Float>
 sample_scalings(const std::vector<Boost_Float> &points,
                 const Damped_Rational &damped_rational);
 
-Polynomial_Vector bilinear_basis(const Damped_Rational &damped_rational,
-                                 const size_t &half_max_degree);
-
 namespace
 {
   std::vector<El::BigFloat>
@@ -86,16 +82,20 @@ namespace
     if(sample_points_opt.has_value())
       return sample_points_opt.value();
 
-    return to_BigFloat_Vector(sample_points(max_degree + 1));
+    return Prefactor_Cache::sample_points(max_degree + 1);
   }
 
   std::vector<El::BigFloat> sample_scalings_or_default(
     const std::optional<std::vector<El::BigFloat>> &sample_scalings_opt,
+    const bool default_sample_points,
     const std::vector<El::BigFloat> &sample_points,
     const Damped_Rational &damped_rational)
   {
     if(sample_scalings_opt.has_value())
       return sample_scalings_opt.value();
+    // Custom sample points are unlikely to repeat, so we don't cache them
+    if(default_sample_points)
+      return Prefactor_Cache::sample_scalings(damped_rational, sample_points);
     return to_BigFloat_Vector(
       sample_scalings(to_Boost_Float_Vector(sample_points), damped_rational));
   }
@@ -106,7 +106,7 @@ namespace
     if(bilinear_basis_opt.has_value())
       return bilinear_basis_opt.value();
 
-    return bilinear_basis(damped_rational, max_degree / 2);
+    return Prefactor_Cache::bilinear_basis(damped_rational, max_degree / 2);
   }
 }
 
@@ -122,8 +122,9 @@ Polynomial_Vector_Matrix::Polynomial_Vector_Matrix(
   this->polynomials = polynomials;
   const auto prefactor = prefactor_or_default(prefactor_opt);
   sample_points = sample_points_or_default(sample_points_opt, max_degree);
-  sample_scalings = sample_scalings_or_default(sample_scalings_opt,
-                                               this->sample_points, prefactor);
+  sample_scalings = sample_scalings_or_default(
+    sample_scalings_opt, !sample_points_opt.has_value(), this->sample_points,
+    prefactor);
   bilinear_basis
     = bilinear_basis_or_default(bilinear_basis_opt, prefactor, max_degree);
 
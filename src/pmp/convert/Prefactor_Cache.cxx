@@ -0,0 +1,125 @@
+#include "Prefactor_Cache.hxx"
+
+#include "sdpb_util/Boost_Float.hxx"
+
+#include <map>
+#include <mutex>
+
+std::vector<Boost_Float> sample_points(const size_t &num_points);
+
+std::vector<Boost_Float>
+sample_scalings(const std::vector<Boost_Float> &points,
+                const Damped_Rational &damped_rational);
+
+Polynomial_Vector bilinear_basis(const Damped_Rational &damped_rational,
+                                 const size_t &half_max_degree);
+
+namespace
+{
+  std::vector<El::BigFloat>
+  to_BigFloat_Vector(const std::vector<Boost_Float> &input)
+  {
+    std::vector<El::BigFloat> output;
+    output.reserve(input.size());
+    for(const auto &x : input)
+      output.push_back(to_BigFloat(x));
+    return output;
+  }
+
+  std::vector<Boost_Float>
+  to_Boost_Float_Vector(const std::vector<El::BigFloat> &input)
+  {
+    std::vector<Boost_Float> output;
+    output.reserve(input.size());
+    for(const auto &x : input)
+      output.push_back(to_Boost_Float(x));
+    return output;
+  }
+
+  std::string precision_key()
+  {
+    return El::BuildString(Boost_Float::default_precision(), ":",
+                           El::gmp::Precision());
+  }
+
+  std::string key(const Damped_Rational &damped_rational, const size_t n)
+  {
+    std::stringstream ss;
+    ss << precision_key() << ";" << n << ";"
+       << to_string(damped_rational.constant) << ";"
+       << to_string(damped_rational.base);
+    for(const auto &pole : damped_rational.poles)
+      ss << ";" << to_string(pole);
+    return ss.str();
+  }
+
+  // All caches share a single mutex:
+  // contention is negligible compared to computing a missing value.
+  std::mutex mutex;
+  Prefactor_Cache::Stats cache_stats;
+  std::map<std::string, std::vector<El::BigFloat>> points_cache;
+  std::map<std::string, std::vector<El::BigFloat>> scalings_cache;
+  std::map<std::string, Polynomial_Vector> bilinear_basis_cache;
+
+  // Find value in cache, or compute and insert it.
+  // NB: compute() is called under lock, it should not access the cache.
+  template <class T, class F>
+  T get_or_compute(std::map<std::string, T> &cache, const std::string &key,
+                   const F &compute)
+  {
+    std::lock_guard lock(mutex);
+    if(const auto it = cache.find(key); it != cache.end())
+      {
+        ++cache_stats.hits;
+        return it->second;
+      }
+    ++cache_stats.misses;
+    return cache.emplace(key, compute()).first->second;
+  }
+}
+
+namespace Prefactor_Cache
+{
+  std::vector<El::BigFloat> sample_points(const size_t num_points)
+  {
+    return get_or_compute(
+      points_cache, precision_key() + ";" + std::to_string(num_points),
+      [num_points] {
+        return to_BigFloat_Vector(::sample_points(num_points));
+      });
+  }
+
+  std::vector<El::BigFloat>
+  sample_scalings(const Damped_Rational &damped_rational,
+                  const std::vector<El::BigFloat> &sample_points)
+  {
+    return get_or_compute(
+      scalings_cache, key(damped_rational, sample_points.size()), [&] {
+        return to_BigFloat_Vector(::sample_scalings(
+          to_Boost_Float_Vector(sample_points), damped_rational));
+      });
+  }
+
+  Polynomial_Vector bilinear_basis(const Damped_Rational &damped_rational,
+                                   const size_t half_max_degree)
+  {
+    return get_or_compute(
+      bilinear_basis_cache, key(damped_rational, half_max_degree),
+      [&] { return ::bilinear_basis(damped_rational, half_max_degree); });
+  }
+
+  Stats stats()
+  {
+    std::lock_guard lock(mutex);
+    return cache_stats;
+  }
+
+  void clear()
+  {
+    std::lock_guard lock(mutex);
+    cache_stats = {};
+    points_cache.clear();
+    scalings_cache.clear();
+    bilinear_basis_cache.clear();
+  }
+}
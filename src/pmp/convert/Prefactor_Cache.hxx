@@ -0,0 +1,39 @@
+#pragma once
+
+#include "pmp/Damped_Rational.hxx"
+#include "pmp/Polynomial.hxx"
+
+#include <El.hpp>
+
+#include <vector>
+
+// Process-wide memoization of the default sample points, sample scalings
+// and bilinear basis for Polynomial_Vector_Matrix.
+//
+// In a typical PMP, thousands of matrices share the same prefactor
+// and degree, and bilinear_basis() is expensive,
+// so we compute each distinct value only once.
+//
+// Cache keys include current MPFR and GMP precision,
+// so changing precision does not return stale values.
+namespace Prefactor_Cache
+{
+  struct Stats
+  {
+    size_t hits = 0;
+    size_t misses = 0;
+  };
+
+  std::vector<El::BigFloat> sample_points(size_t num_points);
+  // Scalings for the default sample points,
+  // i.e. sample_points == Prefactor_Cache::sample_points(num_points).
+  // Cache key depends only on sample_points.size().
+  std::vector<El::BigFloat>
+  sample_scalings(const Damped_Rational &damped_rational,
+                  const std::vector<El::BigFloat> &sample_points);
+  Polynomial_Vector bilinear_basis(const Damped_Rational &damped_rational,
+                                   size_t half_max_degree);
+
+  Stats stats();
+  void clear();
+}
@@ -1,4 +1,5 @@
 #include "pmp_read/pmp_read.hxx"
+#include "sdpb_util/Thread_Pool.hxx"
 
 void precompute(
   const Boost_Float &base, std::vector<Boost_Float> &sorted_poles,
@@ -42,13 +43,13 @@ Polynomial_Vector bilinear_basis(const Damped_Rational &damped_rational,
   precompute(damped_rational.base, sorted_poles, equal_ranges, lengths,
              products, integral_matrix);
 
-  std::vector<El::BigFloat> bilinear_table;
-  for(int64_t m = 0; m <= int64_t(2 * half_max_degree); ++m)
-    {
-      bilinear_table.emplace_back(
-        to_BigFloat(bilinear_form(damped_rational, sorted_poles, equal_ranges,
-                                  lengths, products, integral_matrix, m)));
-    }
+  // Table entries are independent, so we compute them in parallel
+  std::vector<El::BigFloat> bilinear_table(2 * half_max_degree + 1);
+  Thread_Pool::global().parallel_for(bilinear_table.size(), [&](size_t m) {
+    bilinear_table[m]
+      = to_BigFloat(bilinear_form(damped_rational, sorted_poles, equal_ranges,
+                                  lengths, products, integral_matrix, m));
+  });
 
   El::Matrix<El::BigFloat> anti_band_matrix(half_max_degree + 1,
                                             half_max_degree + 1);
@@ -1,4 +1,5 @@
 #include "../Damped_Rational.hxx"
+#include "sdpb_util/Thread_Pool.hxx"
 
 #include <El.hpp>
 
@@ -11,18 +12,17 @@ std::vector<Boost_Float>
 sample_scalings(const std::vector<Boost_Float> &points,
                 const Damped_Rational &damped_rational)
 {
-  std::vector<Boost_Float> result;
-  result.reserve(points.size());
-  for(auto &point : points)
-    {
-      Boost_Float numerator(damped_rational.constant
-                            * pow(damped_rational.base, point));
-      Boost_Float denominator(1);
-      for(auto &pole : damped_rational.poles)
-        {
-          denominator *= (point - pole);
-        }
-      result.emplace_back(numerator / denominator);
-    }
+  std::vector<Boost_Float> result(points.size());
+  Thread_Pool::global().parallel_for(points.size(), [&](size_t i) {
+    const auto &point = points[i];
+    Boost_Float numerator(damped_rational.constant
+                          * pow(damped_rational.base, point));
+    Boost_Float denominator(1);
+    for(auto &pole : damped_rational.poles)
+      {
+        denominator *= (point - pole);
+      }
+    result[i] = numerator / denominator;
+  });
   return result;
 }
@@ -0,0 +1,55 @@
+#include "Pmp2binary_Parameters.hxx"
+#include "pmp_read/pmp_read.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <boost/program_options.hpp>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+namespace po = boost::program_options;
+
+void write_binary_pmp(const fs::path &output_path,
+                      const Polynomial_Matrix_Program &pmp, Timers &timers);
+
+int main(int argc, char **argv)
+{
+  Environment env(argc, argv);
+
+  try
+    {
+      const Pmp2binary_Parameters parameters(argc, argv);
+      if(!parameters.is_valid())
+        return 0;
+
+      Environment::set_precision(parameters.precision);
+
+      Timers timers(env, parameters.verbosity);
+      Scoped_Timer timer(timers, "pmp2binary");
+      const auto pmp
+        = read_polynomial_matrix_program(env, parameters.input_file, timers);
+      write_binary_pmp(parameters.output_path, pmp, timers);
+      if(parameters.verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
+        {
+          El::Output("Converted ", pmp.num_matrices, " matrices in ",
+                     (double)timer.timer().elapsed_milliseconds() / 1000,
+                     " seconds, output: ", parameters.output_path.string());
+        }
+
+      if(parameters.verbosity >= Verbosity::debug)
+        {
+          timers.write_profile(parameters.output_path.string()
+                               + ".profiling/profiling."
+                               + std::to_string(El::mpi::Rank()));
+        }
+    }
+  catch(std::exception &e)
+    {
+      std::cerr << "Error: " << e.what() << "\n" << std::flush;
+      El::mpi::Abort(El::mpi::COMM_WORLD, 1);
+    }
+  catch(...)
+    {
+      std::cerr << "Unknown Error\n" << std::flush;
+      El::mpi::Abort(El::mpi::COMM_WORLD, 1);
+    }
+}
@@ -0,0 +1,87 @@
+#include "pmp_read/Binary_PMP_Format.hxx"
+#include "pmp_read/pmp_read.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+// Each rank serializes its own matrices.
+// Rank 0 writes header, objective, normalization and index,
+// and then all ranks write their matrices at the corresponding offsets.
+void write_binary_pmp(const fs::path &output_path,
+                      const Polynomial_Matrix_Program &pmp, Timers &timers)
+{
+  Scoped_Timer timer(timers, "write_binary_pmp");
+  const auto &comm = El::mpi::COMM_WORLD;
+
+  std::vector<Binary_PMP_Format::Writer> matrix_writers(pmp.matrices.size());
+  std::vector<uint64_t> matrix_sizes(pmp.num_matrices, 0);
+  {
+    Scoped_Timer serialize_timer(timers, "serialize");
+    for(size_t i = 0; i < pmp.matrices.size(); ++i)
+      {
+        matrix_writers.at(i).write(pmp.matrices.at(i));
+        matrix_sizes.at(pmp.matrix_index_local_to_global.at(i))
+          = matrix_writers.at(i).buffer.size();
+      }
+    El::mpi::AllReduce(matrix_sizes.data(), matrix_sizes.size(), El::mpi::SUM,
+                       comm);
+  }
+
+  Binary_PMP_Format::Header header;
+  header.limb_bits = GMP_NUMB_BITS;
+  header.precision = El::gmp::Precision();
+  header.num_matrices = pmp.num_matrices;
+  header.objective_offset = sizeof(header);
+
+  // Objective and normalization are synchronized among all ranks,
+  // so each rank can compute the offsets.
+  Binary_PMP_Format::Writer vectors_writer;
+  vectors_writer.write(pmp.objective);
+  if(pmp.normalization.has_value())
+    {
+      header.normalization_offset
+        = header.objective_offset + vectors_writer.buffer.size();
+      vectors_writer.write(pmp.normalization.value());
+    }
+
+  std::vector<Binary_PMP_Format::Index_Entry> index(pmp.num_matrices);
+  uint64_t offset = header.objective_offset + vectors_writer.buffer.size();
+  for(size_t i = 0; i < pmp.num_matrices; ++i)
+    {
+      index.at(i) = {offset, matrix_sizes.at(i)};
+      offset += matrix_sizes.at(i);
+    }
+  header.index_offset = offset;
+
+  if(comm.Rank() == 0)
+    {
+      if(output_path.has_parent_path())
+        fs::create_directories(output_path.parent_path());
+      std::ofstream os(output_path, std::ios::binary | std::ios::trunc);
+      os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      os.write(vectors_writer.buffer.data(), vectors_writer.buffer.size());
+      os.seekp(header.index_offset);
+      os.write(reinterpret_cast<const char *>(index.data()),
+               index.size() * sizeof(Binary_PMP_Format::Index_Entry));
+      ASSERT(os.good(), "Error when writing ", output_path);
+    }
+  El::mpi::Barrier(comm);
+
+  {
+    Scoped_Timer write_timer(timers, "write_matrices");
+    std::fstream os(output_path,
+                    std::ios::binary | std::ios::in | std::ios::out);
+    ASSERT(os.good(), "Cannot open ", output_path);
+    for(size_t i = 0; i < pmp.matrices.size(); ++i)
+      {
+        const auto &buffer = matrix_writers.at(i).buffer;
+        os.seekp(index.at(pmp.matrix_index_local_to_global.at(i)).offset);
+        os.write(buffer.data(), buffer.size());
+      }
+    ASSERT(os.good(), "Error when writing ", output_path);
+  }
+  El::mpi::Barrier(comm);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Block_File_Format.hxx"
+#include "pmp/Polynomial_Vector_Matrix.hxx"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Content-hash cache of block_info_XXX.json and block_data_XXX files,
+// used by incremental pmp2sdp (--incremental).
+//
+// Each block is identified by a hash of its Polynomial_Vector_Matrix
+// (after applying normalization), GMP precision and block file format.
+// If the hash is found in the cache, pmp2sdp skips
+// Dual_Constraint_Group computation and copies the cached files instead.
+//
+// NB: the hash is computed from the already constructed matrix,
+// so the input is still parsed and default sample points, sample scalings
+// and bilinear basis are still computed (they are cached by
+// Prefactor_Cache for each distinct prefactor).
+// Only the Dual_Constraint_Group computation and block file writing are saved.
+//
+// Without --zip, files are hard-linked from the cache to the output directory
+// (when possible), so that each block is written to disk only once.
+//
+// Cache files (uncompressed):
+//   <dir>/<hash>.block_info.json
+//   <dir>/<hash>.block_data.{bin,json,mmap}
+struct Block_Cache
+{
+  using Hash = uint64_t;
+
+  std::filesystem::path dir;
+  Block_File_Format format;
+
+  Block_Cache(const std::filesystem::path &dir, Block_File_Format format);
+
+  [[nodiscard]] Hash hash(const Polynomial_Vector_Matrix &pvm) const;
+
+  [[nodiscard]] bool contains(Hash hash) const;
+  [[nodiscard]] std::filesystem::path block_info_path(Hash hash) const;
+  [[nodiscard]] std::filesystem::path block_data_path(Hash hash) const;
+
+  // Remove cached blocks that are not listed in used_hashes
+  void prune(const std::vector<Hash> &used_hashes) const;
+};
+
+std::string to_string(Block_Cache::Hash hash);
@@ -0,0 +1,54 @@
+#include "../Block_Cache.hxx"
+
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+Block_Cache::Block_Cache(const fs::path &dir, const Block_File_Format format)
+    : dir(dir), format(format)
+{}
+
+bool Block_Cache::contains(const Hash hash) const
+{
+  return fs::exists(block_info_path(hash))
+         && fs::exists(block_data_path(hash));
+}
+
+fs::path Block_Cache::block_info_path(const Hash hash) const
+{
+  return dir / (to_string(hash) + ".block_info.json");
+}
+
+fs::path Block_Cache::block_data_path(const Hash hash) const
+{
+  std::stringstream extension;
+  extension << format;
+  return dir / (to_string(hash) + ".block_data." + extension.str());
+}
+
+void Block_Cache::prune(const std::vector<Hash> &used_hashes) const
+{
+  std::set<fs::path> used_paths;
+  for(const auto &hash : used_hashes)
+    {
+      used_paths.insert(block_info_path(hash));
+      used_paths.insert(block_data_path(hash));
+    }
+  std::vector<fs::path> unused_paths;
+  for(const auto &entry : fs::directory_iterator(dir))
+    {
+      if(used_paths.count(entry.path()) == 0)
+        unused_paths.push_back(entry.path());
+    }
+  for(const auto &path : unused_paths)
+    fs::remove(path);
+}
+
+std::string to_string(const Block_Cache::Hash hash)
+{
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return ss.str();
+}
@@ -0,0 +1,69 @@
+#include "../Block_Cache.hxx"
+
+#include <vector>
+
+// 64-bit FNV-1a hash of all data that affects block files.
+// It is not cryptographically strong, but accidental collisions
+// are very unlikely for any realistic number of blocks.
+
+namespace
+{
+  struct Hasher
+  {
+    Block_Cache::Hash hash = 14695981039346656037ULL;
+
+    void add_bytes(const void *data, const size_t size)
+    {
+      const auto *bytes = static_cast<const unsigned char *>(data);
+      for(size_t i = 0; i < size; ++i)
+        {
+          hash ^= bytes[i];
+          hash *= 1099511628211ULL;
+        }
+    }
+    void add(const uint64_t value) { add_bytes(&value, sizeof(value)); }
+
+    void add(const El::BigFloat &value)
+    {
+      // Serialized BigFloat includes precision, sign, exponent and limbs
+      buffer.resize(value.SerializedSize());
+      value.Serialize(buffer.data());
+      add_bytes(buffer.data(), buffer.size());
+    }
+    void add(const std::vector<El::BigFloat> &values)
+    {
+      add(values.size());
+      for(const auto &value : values)
+        add(value);
+    }
+    void add(const Polynomial &polynomial) { add(polynomial.coefficients); }
+    void add(const Polynomial_Vector &polynomials)
+    {
+      add(polynomials.size());
+      for(const auto &polynomial : polynomials)
+        add(polynomial);
+    }
+
+  private:
+    std::vector<El::byte> buffer;
+  };
+}
+
+Block_Cache::Hash Block_Cache::hash(const Polynomial_Vector_Matrix &pvm) const
+{
+  Hasher hasher;
+  hasher.add(El::gmp::Precision());
+  hasher.add(static_cast<uint64_t>(format));
+
+  hasher.add(pvm.polynomials.Height());
+  hasher.add(pvm.polynomials.Width());
+  for(int i = 0; i < pvm.polynomials.Height(); ++i)
+    for(int j = 0; j < pvm.polynomials.Width(); ++j)
+      {
+        hasher.add(pvm.polynomials(i, j));
+      }
+  hasher.add(pvm.sample_points);
+  hasher.add(pvm.sample_scalings);
+  hasher.add(pvm.bilinear_basis);
+  return hasher.hash;
+}
@@ -5,10 +5,14 @@
 #include <iostream>
 #include <string>
 
+// mmap_bin: block_data_XXX.mmap, fixed-size layout suitable for mmap(),
+// see Mmap_Block_Format.hxx
+// (NB: we cannot call it just 'mmap' because of the POSIX mmap() function)
 enum Block_File_Format
 {
   bin,
-  json
+  json,
+  mmap_bin
 };
 
 inline std::istream &operator>>(std::istream &in, Block_File_Format &format)
@@ -19,6 +23,8 @@ inline std::istream &operator>>(std::istream &in, Block_File_Format &format)
     format = bin;
   else if(token == "json")
     format = json;
+  else if(token == "mmap")
+    format = mmap_bin;
   else
     in.setstate(std::ios_base::failbit);
   return in;
@@ -31,6 +37,8 @@ operator<<(std::ostream &out, const Block_File_Format &format)
     out << "bin";
   else if(format == json)
     out << "json";
+  else if(format == mmap_bin)
+    out << "mmap";
   else
     THROW(std::out_of_range, "Block_File_Format=", std::to_string(format));
   return out;
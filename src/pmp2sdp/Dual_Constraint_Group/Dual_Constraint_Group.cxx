@@ -12,9 +12,18 @@ void write_block_json(std::ostream &output_stream,
                       const Dual_Constraint_Group &group);
 
 El::Matrix<El::BigFloat>
-sample_bilinear_basis(const int maxDegree, const int numSamples,
+sample_powers(const size_t max_degree,
+              const std::vector<El::BigFloat> &sample_points);
+
+El::Matrix<El::BigFloat>
+sample_polynomials(const std::vector<const Polynomial *> &polynomials,
+                   const El::Matrix<El::BigFloat> &powers,
+                   const std::vector<El::BigFloat> &scalings);
+
+El::Matrix<El::BigFloat>
+sample_bilinear_basis(const int maxDegree,
                       const Polynomial_Vector &bilinearBasis,
-                      const std::vector<El::BigFloat> &samplePoints,
+                      const El::Matrix<El::BigFloat> &samplePowers,
                       const std::vector<El::BigFloat> &sampleScalings);
 
 // Construct a Dual_Constraint_Group from a Polynomial_Vector_Matrix by
@@ -50,23 +59,52 @@ Dual_Constraint_Group::Dual_Constraint_Group(
   // The rest multiply decision variables y
   constraint_matrix.Resize(numConstraints, vectorDim - 1);
 
-  // Populate B and c by sampling the polynomial matrix
+  // Populate B and c by sampling the polynomial matrix.
+  // All polynomials polys(r,c)[n] are sampled at once as a matrix product,
+  // see sample_polynomials().
+  std::vector<const Polynomial *> polynomials;
+  polynomials.reserve(dim * (dim + 1) / 2 * vectorDim);
+  size_t num_coefficients = 1;
+  for(size_t c = 0; c < dim; c++)
+    for(size_t r = 0; r <= c; r++)
+      for(size_t n = 0; n < vectorDim; ++n)
+        {
+          const auto &polynomial = polys(r, c).at(n);
+          polynomials.push_back(&polynomial);
+          num_coefficients
+            = std::max(num_coefficients, polynomial.coefficients.size());
+        }
+  // Bilinear basis is sampled up to q_{degree/2}(x)
+  for(size_t i = 0; i <= degree / 2 && i < m.bilinear_basis.size(); ++i)
+    {
+      num_coefficients = std::max(num_coefficients,
+                                  m.bilinear_basis.at(i).coefficients.size());
+    }
+
+  // Powers x_k^d are shared by all polynomials in the block
+  const auto powers = sample_powers(num_coefficients - 1, m.sample_points);
+
+  // samples(i,k) = s_k * polynomials[i](x_k)
+  const auto samples
+    = sample_polynomials(polynomials, powers, m.sample_scalings);
+
   int p = 0;
+  size_t polynomial_index = 0;
   for(size_t c = 0; c < dim; c++)
     {
       for(size_t r = 0; r <= c; r++)
         {
           for(size_t k = 0; k < num_points; k++)
             {
-              El::BigFloat x(m.sample_points.at(k));
-              El::BigFloat scale(m.sample_scalings.at(k));
-              constraint_constants[p] = scale * polys(r, c)[0](x);
+              constraint_constants[p] = samples.Get(polynomial_index, k);
               for(size_t n = 1; n < vectorDim; ++n)
                 {
-                  constraint_matrix.Set(p, n - 1, -scale * polys(r, c)[n](x));
+                  constraint_matrix.Set(
+                    p, n - 1, -samples.Get(polynomial_index + n, k));
                 }
               ++p;
             }
+          polynomial_index += vectorDim;
         }
     }
 
@@ -78,8 +116,8 @@ Dual_Constraint_Group::Dual_Constraint_Group(
   //   Y_2: {\sqrt(x) q_0(x), ..., \sqrt(x) q_delta2(x)
   //
   const size_t delta1(degree / 2);
-  bilinear_bases[0] = sample_bilinear_basis(
-    delta1, num_points, m.bilinear_basis, m.sample_points, m.sample_scalings);
+  bilinear_bases[0] = sample_bilinear_basis(delta1, m.bilinear_basis, powers,
+                                            m.sample_scalings);
 
   // For degree==0, the second block will have zero size.
   const size_t delta2((degree + 1) / 2 - 1);
@@ -90,6 +128,6 @@ Dual_Constraint_Group::Dual_Constraint_Group(
     {
       scaled_samples.emplace_back(m.sample_points[ii] * m.sample_scalings[ii]);
     }
-  bilinear_bases[1] = sample_bilinear_basis(
-    delta2, num_points, m.bilinear_basis, m.sample_points, scaled_samples);
+  bilinear_bases[1] = sample_bilinear_basis(delta2, m.bilinear_basis, powers,
+                                            scaled_samples);
 }
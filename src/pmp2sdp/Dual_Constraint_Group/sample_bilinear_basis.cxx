@@ -11,28 +11,38 @@
 //
 // Input:
 // - maxDegree: the maximal degree of q_m(x) to include
-// - numSamples: number of sample points x_k
 // - bilinearBasis: the vector {q_0(x), q_1(x), ..., q_n(x)}
-// - samplePoints: the points {x_0, x_1, ... }
+// - samplePowers: the powers x_k^d of sample points {x_0, x_1, ... },
+//   see sample_powers()
 // - sampleScalings: the scale factors {s_0, s_1, ... }
 //
 
 #include "pmp/Polynomial.hxx"
 
 El::Matrix<El::BigFloat>
-sample_bilinear_basis(const int maxDegree, const int numSamples,
+sample_polynomials(const std::vector<const Polynomial *> &polynomials,
+                   const El::Matrix<El::BigFloat> &powers,
+                   const std::vector<El::BigFloat> &scalings);
+
+El::Matrix<El::BigFloat>
+sample_bilinear_basis(const int maxDegree,
                       const Polynomial_Vector &bilinearBasis,
-                      const std::vector<El::BigFloat> &samplePoints,
+                      const El::Matrix<El::BigFloat> &samplePowers,
                       const std::vector<El::BigFloat> &sampleScalings)
 {
-  El::Matrix<El::BigFloat> b(maxDegree + 1, numSamples);
-  for(int k = 0; k < numSamples; k++)
-    {
-      El::BigFloat x(samplePoints.at(k)), scale(Sqrt(sampleScalings.at(k)));
-      for(int i = 0; i <= maxDegree; i++)
-        {
-          b.Set(i, k, scale * bilinearBasis.at(i)(x));
-        }
-    }
-  return b;
+  const int numSamples = samplePowers.Width();
+  // For maxDegree < 0, the result has zero height
+  if(maxDegree < 0)
+    return El::Matrix<El::BigFloat>(0, numSamples);
+
+  std::vector<const Polynomial *> polynomials;
+  for(int i = 0; i <= maxDegree; i++)
+    polynomials.push_back(&bilinearBasis.at(i));
+
+  std::vector<El::BigFloat> scales;
+  scales.reserve(numSamples);
+  for(const auto &scaling : sampleScalings)
+    scales.push_back(Sqrt(scaling));
+
+  return sample_polynomials(polynomials, samplePowers, scales);
 }
@@ -0,0 +1,84 @@
+// Sampling polynomials as a matrix product.
+//
+// Instead of evaluating each polynomial p_i(x) at each sample point x_k
+// via Horner's method (one BigFloat at a time), we compute
+//
+//   s_k p_i(x_k) = \sum_d C_{i,d} V_{d,k},
+//
+// where C_{i,d} is the coefficient of x^d in p_i(x),
+// and V_{d,k} = s_k x_k^d is a scaled Vandermonde matrix.
+// The powers x_k^d are computed once per block,
+// and the product C V is a single (blocked) BigFloat GEMM.
+
+#include "pmp/Polynomial.hxx"
+
+// Powers x_k^d for d = 0..max_degree:
+//   {{ 1,            ..., 1            },
+//    { x_0,          ..., x_K          },
+//    ...
+//    { x_0^max_degree, ..., x_K^max_degree }}
+El::Matrix<El::BigFloat>
+sample_powers(const size_t max_degree,
+              const std::vector<El::BigFloat> &sample_points)
+{
+  El::Matrix<El::BigFloat> powers(max_degree + 1, sample_points.size());
+  for(size_t k = 0; k < sample_points.size(); ++k)
+    {
+      El::BigFloat power(1);
+      for(size_t d = 0; d <= max_degree; ++d)
+        {
+          powers.Set(d, k, power);
+          power *= sample_points.at(k);
+        }
+    }
+  return powers;
+}
+
+// Returns matrix M_{i,k} = s_k p_i(x_k)
+//
+// Input:
+// - polynomials: {p_0(x), p_1(x), ...}
+// - powers: matrix of powers x_k^d, see sample_powers().
+//   It should contain at least (max deg p_i + 1) rows.
+// - scalings: scale factors {s_0, s_1, ...}
+El::Matrix<El::BigFloat>
+sample_polynomials(const std::vector<const Polynomial *> &polynomials,
+                   const El::Matrix<El::BigFloat> &powers,
+                   const std::vector<El::BigFloat> &scalings)
+{
+  const auto num_points = powers.Width();
+  ASSERT_EQUAL(scalings.size(), num_points);
+
+  size_t num_coefficients = 1;
+  for(const auto *polynomial : polynomials)
+    {
+      num_coefficients
+        = std::max(num_coefficients, polynomial->coefficients.size());
+    }
+  ASSERT(num_coefficients <= static_cast<size_t>(powers.Height()),
+         "Not enough powers to sample polynomial of degree ",
+         num_coefficients - 1, DEBUG_STRING(powers.Height()));
+
+  // C_{i,d}
+  El::Matrix<El::BigFloat> coefficients;
+  El::Zeros(coefficients, polynomials.size(), num_coefficients);
+  for(size_t i = 0; i < polynomials.size(); ++i)
+    {
+      const auto &polynomial_coefficients = polynomials.at(i)->coefficients;
+      for(size_t d = 0; d < polynomial_coefficients.size(); ++d)
+        coefficients.Set(i, d, polynomial_coefficients.at(d));
+    }
+
+  // V_{d,k} = s_k x_k^d
+  El::Matrix<El::BigFloat> vandermonde(num_coefficients, num_points);
+  for(El::Int k = 0; k < num_points; ++k)
+    for(size_t d = 0; d < num_coefficients; ++d)
+      {
+        vandermonde.Set(d, k, scalings.at(k) * powers.Get(d, k));
+      }
+
+  El::Matrix<El::BigFloat> result;
+  El::Gemm(El::NORMAL, El::NORMAL, El::BigFloat(1), coefficients, vandermonde,
+           result);
+  return result;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "sdpb_util/assert.hxx"
+
+#include <El.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+// Layout of block_data_XXX.mmap files (Block_File_Format::mmap_bin).
+//
+// Unlike .bin files written via boost::serialization, everything here
+// has fixed size, so that a reader can memory-map the file and find any
+// matrix element directly, without parsing the preceding data:
+//
+// - Header (see below), padded to 'alignment' bytes.
+// - Four matrices in the order B, c, bilinear_bases_even, bilinear_bases_odd.
+//   Each matrix is stored in column-major order, starting at
+//   Matrix_Header::offset (a multiple of 'alignment').
+//   Each element is a BigFloat serialized by El::BigFloat::Serialize()
+//   (precision, sign, exponent and limbs), padded to element_size bytes.
+//
+// All integers are written in native byte order.
+namespace Mmap_Block_Format
+{
+  constexpr std::array<char, 8> magic
+    = {'S', 'D', 'P', 'B', 'M', 'M', 'A', 'P'};
+  constexpr uint64_t version = 1;
+  constexpr size_t alignment = 64;
+
+  enum Matrix_Index
+  {
+    B,
+    c,
+    bilinear_bases_even,
+    bilinear_bases_odd,
+    num_matrices
+  };
+
+  struct Matrix_Header
+  {
+    uint64_t height = 0;
+    uint64_t width = 0;
+    // Offset in bytes from the beginning of the file
+    uint64_t offset = 0;
+  };
+
+  struct Header
+  {
+    std::array<char, 8> magic = Mmap_Block_Format::magic;
+    uint64_t version = Mmap_Block_Format::version;
+    uint64_t precision = 0;
+    uint64_t element_size = 0;
+    std::array<Matrix_Header, num_matrices> matrices{};
+  };
+  static_assert(sizeof(Header) % alignment == 0);
+
+  inline size_t align(const size_t num_bytes)
+  {
+    return (num_bytes + alignment - 1) / alignment * alignment;
+  }
+
+  // Serialized size of BigFloat with current precision,
+  // padded to 8 bytes to keep limbs aligned
+  inline size_t get_element_size()
+  {
+    const size_t size = El::BigFloat().SerializedSize();
+    return (size + 7) / 8 * 8;
+  }
+
+  // Header and matrix element accessors for a memory-mapped file.
+  class View
+  {
+  public:
+    View(const char *data, const size_t size) : data(data)
+    {
+      ASSERT(size >= sizeof(Header), "block data is too small: ", size,
+             " bytes");
+      std::memcpy(&header, data, sizeof(Header));
+      ASSERT(header.magic == magic, "Invalid .mmap block data header");
+      ASSERT_EQUAL(header.version, version);
+      ASSERT(header.precision == El::gmp::Precision(),
+             "Read GMP precision: ", header.precision,
+             ", expected: ", El::gmp::Precision());
+      ASSERT_EQUAL(header.element_size, get_element_size());
+      for(const auto &matrix : header.matrices)
+        {
+          ASSERT(matrix.offset % alignment == 0
+                   && matrix.offset
+                          + matrix.height * matrix.width * header.element_size
+                        <= size,
+                 "Invalid matrix offset in .mmap block data: offset=",
+                 matrix.offset, " height=", matrix.height,
+                 " width=", matrix.width, " file size=", size);
+        }
+    }
+
+    [[nodiscard]] const Matrix_Header &matrix(const Matrix_Index index) const
+    {
+      return header.matrices.at(index);
+    }
+
+    void get(const Matrix_Index index, const size_t row, const size_t column,
+             El::BigFloat &value) const
+    {
+      const auto &m = matrix(index);
+      const auto *element
+        = data + m.offset + (column * m.height + row) * header.element_size;
+      value.Deserialize(reinterpret_cast<const El::byte *>(element));
+    }
+
+    [[nodiscard]] El::Matrix<El::BigFloat>
+    read_matrix(const Matrix_Index index) const
+    {
+      const auto &m = matrix(index);
+      El::Matrix<El::BigFloat> result(m.height, m.width);
+      for(size_t column = 0; column < m.width; ++column)
+        for(size_t row = 0; row < m.height; ++row)
+          {
+            get(index, row, column, result(row, column));
+          }
+      return result;
+    }
+
+  private:
+    const char *data;
+    Header header;
+  };
+}
@@ -59,7 +59,8 @@ namespace
   {
     ASSERT(sdp.num_blocks > 0);
     ASSERT(
-      sdp.dual_constraint_groups.size() <= sdp.num_blocks,
+      sdp.dual_constraint_groups.size() + sdp.cached_blocks.size()
+        <= sdp.num_blocks,
       "sdp.dual_constraint_groups.size()=", sdp.dual_constraint_groups.size(),
       " should not exceed sdp.num_blocks=", sdp.num_blocks);
     for(const auto &group : sdp.dual_constraint_groups)
@@ -68,6 +69,12 @@ namespace
                "group.block_index=", group.block_index,
                " should be less than sdp.num_blocks=", sdp.num_blocks);
       }
+    for(const auto &cached_block : sdp.cached_blocks)
+      {
+        ASSERT(cached_block.block_index < sdp.num_blocks,
+               "cached_block.block_index=", cached_block.block_index,
+               " should be less than sdp.num_blocks=", sdp.num_blocks);
+      }
     // TODO: we should also check that block indices from all ranks
     // are unique and cover [0, num_blocks) range.
     // This is checked indirectly in write_sdp().
@@ -76,7 +83,7 @@ namespace
 
 Output_SDP::Output_SDP(const Polynomial_Matrix_Program &pmp,
                        const std::vector<std::string> &command_arguments,
-                       Timers &timers)
+                       Timers &timers, const Block_Cache *block_cache)
     : normalization(pmp.normalization),
       num_blocks(pmp.num_matrices),
       command_arguments(command_arguments)
@@ -101,6 +108,7 @@ Output_SDP::Output_SDP(const Polynomial_Matrix_Program &pmp,
   if(has_nontrivial_normalization)
     {
       const auto max_index = max_normalization_index(normalization.value());
+      normalization_max_index = max_index;
       // (a_{max_index} / n_{max_index}) goes to b_0 = objective_const
       objective_const
         = pmp.objective.at(max_index) / normalization.value().at(max_index);
@@ -116,15 +124,6 @@ Output_SDP::Output_SDP(const Polynomial_Matrix_Program &pmp,
             }
         }
 
-      Scoped_Timer pvm_timer(timers, "matrices");
-      for(size_t i = 0; i < pmp.matrices.size(); ++i)
-        {
-          const auto &matrix = pmp.matrices.at(i);
-          const auto block_index = pmp.matrix_index_local_to_global.at(i);
-          dual_constraint_groups.emplace_back(
-            block_index, convert_pvm_using_normalization(
-                           matrix, normalization.value(), max_index));
-        }
     }
   else
     {
@@ -133,17 +132,58 @@ Output_SDP::Output_SDP(const Polynomial_Matrix_Program &pmp,
       // b_i = a_i
       dual_objective_b.reserve(pmp.objective.size() - 1);
       dual_objective_b.assign(pmp.objective.begin() + 1, pmp.objective.end());
-
-      // If normalization == (1,0,0...0),
-      // then all PVM matrices in (2.2) in SDPB Manual are the same as in (3.1),
-      // and there is no need to convert them via convert_pvm_using_normalization()
-      Scoped_Timer pvm_timer(timers, "matrices");
-      for(size_t i = 0; i < pmp.matrices.size(); ++i)
-        {
-          const auto &matrix = pmp.matrices.at(i);
-          const auto block_index = pmp.matrix_index_local_to_global.at(i);
-          dual_constraint_groups.emplace_back(block_index, matrix);
-        }
     }
+
+  {
+    Scoped_Timer pvm_timer(timers, "matrices");
+    for(size_t i = 0; i < pmp.matrices.size(); ++i)
+      {
+        add_matrix(pmp.matrix_index_local_to_global.at(i), pmp.matrices.at(i),
+                   block_cache);
+      }
+  }
   validate(*this);
 }
+
+void Output_SDP::add_matrix(const size_t block_index,
+                            const Polynomial_Vector_Matrix &pvm,
+                            const Block_Cache *block_cache)
+{
+  ASSERT(block_index < num_blocks, DEBUG_STRING(block_index),
+         DEBUG_STRING(num_blocks));
+  // If normalization == (1,0,0...0),
+  // then all PVM matrices in (2.2) in SDPB Manual are the same as in (3.1),
+  // and there is no need to convert them via convert_pvm_using_normalization()
+  if(normalization_max_index.has_value())
+    {
+      add_block(block_index,
+                convert_pvm_using_normalization(
+                  pvm, normalization.value(), normalization_max_index.value()),
+                block_cache);
+    }
+  else
+    {
+      add_block(block_index, pvm, block_cache);
+    }
+}
+
+void Output_SDP::add_block(const size_t block_index,
+                           const Polynomial_Vector_Matrix &pvm,
+                           const Block_Cache *block_cache)
+{
+  if(block_cache == nullptr)
+    {
+      dual_constraint_groups.emplace_back(block_index, pvm);
+      return;
+    }
+  const auto hash = block_cache->hash(pvm);
+  if(block_cache->contains(hash))
+    {
+      cached_blocks.push_back({block_index, hash});
+    }
+  else
+    {
+      dual_constraint_groups.emplace_back(block_index, pvm);
+      dual_constraint_group_hashes.push_back(hash);
+    }
+}
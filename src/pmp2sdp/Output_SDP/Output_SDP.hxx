@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pmp/Polynomial_Matrix_Program.hxx"
+#include "../Block_Cache.hxx"
 #include "../Dual_Constraint_Group.hxx"
 #include "sdpb_util/Timers/Timers.hxx"
 
@@ -29,5 +30,33 @@ struct Output_SDP : boost::noncopyable
   // Command-line arguments
   std::vector<std::string> command_arguments;
 
-  Output_SDP(const Polynomial_Matrix_Program &pmp, const std::vector<std::string> &command_arguments, Timers& timers);
+  // Incremental mode, see Block_Cache.
+  // Hashes of dual_constraint_groups, to be stored in the cache.
+  std::vector<Block_Cache::Hash> dual_constraint_group_hashes;
+  // Blocks found in the cache, they are not in dual_constraint_groups.
+  struct Cached_Block
+  {
+    size_t block_index;
+    Block_Cache::Hash hash;
+  };
+  std::vector<Cached_Block> cached_blocks;
+
+  // block_cache can be nullptr (non-incremental mode)
+  Output_SDP(const Polynomial_Matrix_Program &pmp,
+             const std::vector<std::string> &command_arguments, Timers &timers,
+             const Block_Cache *block_cache = nullptr);
+
+  // Convert PMP matrix to a dual constraint group (or find it in the cache)
+  // and add it to dual_constraint_groups (or cached_blocks).
+  // Used for matrices that are not stored in pmp.matrices,
+  // see Streaming_PMP_Reader.
+  void add_matrix(size_t block_index, const Polynomial_Vector_Matrix &pvm,
+                  const Block_Cache *block_cache = nullptr);
+
+private:
+  // Set for nontrivial normalization, see max_normalization_index()
+  std::optional<size_t> normalization_max_index;
+
+  void add_block(size_t block_index, const Polynomial_Vector_Matrix &pvm,
+                 const Block_Cache *block_cache);
 };
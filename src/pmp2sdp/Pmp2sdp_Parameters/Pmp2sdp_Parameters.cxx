@@ -30,10 +30,28 @@ Pmp2sdp_Parameters::Pmp2sdp_Parameters(int argc, char **argv)
     "outputFormat,f",
     po::value<Block_File_Format>(&output_format)
       ->default_value(Block_File_Format::bin),
-    "Output format for SDP blocks. Could be either 'bin' or 'json'");
+    "Output format for SDP blocks. Could be 'bin', 'json' or 'mmap'");
   options.add_options()(
     "zip,z", po::bool_switch(&zip),
     "Store output to zip file instead of plain directory.");
+  options.add_options()(
+    "zipShards", po::value<size_t>(&zip_shards)->default_value(1),
+    "Split zip output into several archives: sdp.zip contains control, "
+    "objectives, normalization, block_info files and shards.json manifest, "
+    "while block_data files are distributed among sdp.shard_K.zip, "
+    "K=0..(zipShards-1). Each group of SDPB processes then reads only the "
+    "shards containing its blocks. Requires --zip.");
+  options.add_options()(
+    "incremental", po::bool_switch(&incremental),
+    "Reuse block files from the previous pmp2sdp run for unchanged "
+    "polynomial matrices. Block files are cached in OUTPUT.block_cache "
+    "directory, by content hash of each matrix, precision and output "
+    "format.");
+  options.add_options()(
+    "numThreads", po::value<size_t>(&num_threads)->default_value(1),
+    "Number of threads per process for computing bilinear bases and "
+    "sample scalings. Useful if there are spare cores, e.g. when running "
+    "fewer processes than cores.");
   options.add_options()(
     "verbosity,v",
     po::value<Verbosity>(&verbosity)->default_value(Verbosity::regular),
@@ -68,6 +86,10 @@ Pmp2sdp_Parameters::Pmp2sdp_Parameters(int argc, char **argv)
              "Input file does not exist: ", input_file);
       ASSERT(!fs::is_directory(input_file) && input_file != ".",
              "Input file is a directory, not a file:", input_file);
+      ASSERT(zip_shards > 0, "--zipShards should be positive");
+      ASSERT(num_threads > 0, "--numThreads should be positive");
+      ASSERT(zip || zip_shards == 1, "--zipShards=", zip_shards,
+             " requires --zip option.");
     }
   catch(po::error &e)
     {
@@ -87,6 +109,9 @@ boost::property_tree::ptree to_property_tree(const Pmp2sdp_Parameters &p)
   result.put("output", p.output_path.string());
   result.put("precision", p.precision);
   result.put("outputFormat", p.output_format);
+  result.put("zipShards", p.zip_shards);
+  result.put("incremental", p.incremental);
+  result.put("numThreads", p.num_threads);
   result.put("verbosity", static_cast<int>(p.verbosity));
 
   return result;
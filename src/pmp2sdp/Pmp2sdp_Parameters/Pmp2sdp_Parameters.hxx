@@ -15,6 +15,9 @@ struct Pmp2sdp_Parameters
   std::filesystem::path output_path;
   Block_File_Format output_format;
   bool zip = false;
+  size_t zip_shards = 1;
+  bool incremental = false;
+  size_t num_threads = 1;
   Verbosity verbosity;
 
   std::vector<std::string> command_arguments;
@@ -2,10 +2,12 @@
 #include "Pmp2sdp_Parameters/Pmp2sdp_Parameters.hxx"
 #include "Dual_Constraint_Group.hxx"
 #include "write_sdp.hxx"
-#include "pmp_read/pmp_read.hxx"
+#include "pmp_read/Streaming_PMP_Reader.hxx"
 #include "sdpb_util/Verbosity.hxx"
+#include "sdpb_util/Thread_Pool.hxx"
 #include "sdpb_util/Timers/Timers.hxx"
 
+#include <optional>
 #include <string>
 #include <boost/program_options.hpp>
 #include <filesystem>
@@ -40,16 +42,58 @@ int main(int argc, char **argv)
         }
 
       Environment::set_precision(parameters.precision);
+      Thread_Pool::set_global_num_threads(parameters.num_threads);
 
       Timers timers(env, parameters.verbosity);
       Scoped_Timer timer(timers, "pmp2sdp");
 
-      auto pmp
-        = read_polynomial_matrix_program(env, parameters.input_file, timers);
+      // Matrices are read, converted and written one by one,
+      // so that we never keep the whole PMP or SDP in memory.
+      const Streaming_PMP_Reader pmp_reader(env, parameters.input_file,
+                                            timers);
 
-      Output_SDP sdp(pmp, parameters.command_arguments, timers);
-      write_sdp(parameters.output_path, sdp, parameters.output_format,
-                parameters.zip, timers, parameters.verbosity);
+      std::optional<Block_Cache> block_cache;
+      if(parameters.incremental)
+        {
+          auto cache_dir = parameters.output_path;
+          cache_dir += ".block_cache";
+          block_cache.emplace(cache_dir, parameters.output_format);
+        }
+      const auto *block_cache_ptr
+        = block_cache.has_value() ? &block_cache.value() : nullptr;
+
+      Output_SDP sdp(pmp_reader.pmp(), parameters.command_arguments, timers,
+                     block_cache_ptr);
+      Output_SDP_Writer writer(parameters.output_path, sdp,
+                               parameters.output_format, parameters.zip,
+                               timers, parameters.verbosity,
+                               parameters.zip_shards, block_cache_ptr);
+      pmp_reader.for_each_matrix(
+        [&](const size_t block_index, Polynomial_Vector_Matrix &&matrix) {
+          Scoped_Timer block_timer(timers,
+                                   "block_" + std::to_string(block_index));
+          // Convert PVM to dual constraint group,
+          // write it and release memory
+          {
+            const auto pvm = std::move(matrix);
+            sdp.add_matrix(block_index, pvm, block_cache_ptr);
+          }
+          writer.write_new_blocks(sdp);
+        },
+        timers);
+      {
+        Scoped_Timer write_timer(timers, "write_sdp");
+        writer.finish(sdp);
+      }
+      if(block_cache.has_value()
+         && parameters.verbosity >= Verbosity::regular)
+        {
+          const size_t num_cached_blocks = El::mpi::Reduce(
+            sdp.cached_blocks.size(), El::mpi::SUM, 0, El::mpi::COMM_WORLD);
+          if(El::mpi::Rank() == 0)
+            El::Output("Reused ", num_cached_blocks, " of ", sdp.num_blocks,
+                       " SDP blocks from ", block_cache->dir);
+        }
       if(parameters.verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
         {
           El::Output("Processed ", sdp.num_blocks, " SDP blocks in ",
@@ -2,6 +2,7 @@
 #include "write_vector.hxx"
 #include "sdpb_util/ostream/set_stream_precision.hxx"
 #include "Block_File_Format.hxx"
+#include "Mmap_Block_Format.hxx"
 #include "sdpb_util/assert.hxx"
 
 #include <boost/serialization/vector.hpp>
@@ -100,6 +101,70 @@ namespace
     ar << group.bilinear_bases[0];
     ar << group.bilinear_bases[1];
   }
+
+  void write_block_data_mmap(std::ostream &output_stream,
+                             const Dual_Constraint_Group &group)
+  {
+    namespace Format = Mmap_Block_Format;
+
+    ASSERT_EQUAL(group.bilinear_bases.size(), 2);
+    std::array<const El::Matrix<El::BigFloat> *, Format::num_matrices>
+      matrices;
+    matrices[Format::B] = &group.constraint_matrix;
+    El::Matrix<El::BigFloat> c(group.constraint_constants.size(), 1);
+    for(size_t i = 0; i < group.constraint_constants.size(); ++i)
+      c(i, 0) = group.constraint_constants[i];
+    matrices[Format::c] = &c;
+    matrices[Format::bilinear_bases_even] = &group.bilinear_bases[0];
+    matrices[Format::bilinear_bases_odd] = &group.bilinear_bases[1];
+
+    Format::Header header;
+    header.precision = El::gmp::Precision();
+    header.element_size = Format::get_element_size();
+    size_t offset = Format::align(sizeof(Format::Header));
+    for(size_t index = 0; index < Format::num_matrices; ++index)
+      {
+        auto &matrix_header = header.matrices.at(index);
+        matrix_header.height = matrices.at(index)->Height();
+        matrix_header.width = matrices.at(index)->Width();
+        matrix_header.offset = offset;
+        offset = Format::align(offset
+                               + matrix_header.height * matrix_header.width
+                                   * header.element_size);
+      }
+
+    size_t num_bytes_written = 0;
+    auto write_padding = [&](const size_t new_position) {
+      ASSERT(new_position >= num_bytes_written);
+      const std::vector<char> zeros(new_position - num_bytes_written, 0);
+      output_stream.write(zeros.data(), zeros.size());
+      num_bytes_written = new_position;
+    };
+
+    output_stream.write(reinterpret_cast<const char *>(&header),
+                        sizeof(header));
+    num_bytes_written += sizeof(header);
+
+    std::vector<El::byte> element(header.element_size, 0);
+    for(size_t index = 0; index < Format::num_matrices; ++index)
+      {
+        const auto &matrix = *matrices.at(index);
+        write_padding(header.matrices.at(index).offset);
+        for(int column = 0; column < matrix.Width(); ++column)
+          for(int row = 0; row < matrix.Height(); ++row)
+            {
+              const auto &value = matrix.CRef(row, column);
+              ASSERT(value.SerializedSize() <= header.element_size,
+                     "BigFloat precision differs from the default one: ",
+                     value.Precision());
+              value.Serialize(element.data());
+              output_stream.write(reinterpret_cast<const char *>(element.data()),
+                                  element.size());
+              num_bytes_written += element.size();
+            }
+      }
+    write_padding(offset);
+  }
 }
 
 void write_block_data(std::ostream &os, const Dual_Constraint_Group &group,
@@ -109,6 +174,7 @@ void write_block_data(std::ostream &os, const Dual_Constraint_Group &group,
     {
     case bin: write_block_data_bin(os, group); break;
     case json: write_block_data_json(os, group); break;
+    case mmap_bin: write_block_data_mmap(os, group); break;
     default: RUNTIME_ERROR("Unknown Block_File_Format: ", format);
     }
 }
\ No newline at end of file
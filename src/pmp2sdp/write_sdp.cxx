@@ -8,6 +8,7 @@
 #include "sdpb_util/ostream/pretty_print_bytes.hxx"
 
 #include <filesystem>
+#include <numeric>
 
 #include <boost/iostreams/device/file.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
@@ -29,14 +30,15 @@ void write_normalization_json(std::ostream &output_stream,
 void write_block_info_json(std::ostream &output_stream,
                            const Dual_Constraint_Group &group);
 
+void write_shards_json(
+  std::ostream &output_stream,
+  const std::vector<fs::path> &shard_paths,
+  const std::vector<std::vector<size_t>> &shard_block_indices);
+
 void write_block_data(std::ostream &output_stream,
                       const Dual_Constraint_Group &group,
                       Block_File_Format format);
 
-void print_matrix_sizes(
-  const int &rank, const std::vector<El::BigFloat> &dual_objective_b,
-  const std::vector<Dual_Constraint_Group> &dual_constraint_groups);
-
 namespace
 {
   size_t write_data_and_count_bytes(
@@ -65,6 +67,37 @@ namespace
     return counter.num_bytes;
   }
 
+  // Copy file to temp_dir (gzipped, if zip=true)
+  size_t copy_file_and_count_bytes(const fs::path &from_path,
+                                   const fs::path &to_path, const bool zip)
+  {
+    return write_data_and_count_bytes(
+      to_path,
+      [&](std::ostream &os) {
+        std::ifstream is(from_path, std::ios::binary);
+        ASSERT(is.good(), "Cannot open ", from_path);
+        os << is.rdbuf();
+      },
+      zip, true);
+  }
+
+  // Hard-link file to temp_dir, so that it is written to disk only once.
+  // Fall back to copying if zip=true (temp_dir files are gzipped)
+  // or if the link cannot be created, e.g. for a cache on another filesystem.
+  size_t link_or_copy_file_and_count_bytes(const fs::path &from_path,
+                                           const fs::path &to_path,
+                                           const bool zip)
+  {
+    if(!zip)
+      {
+        std::error_code error;
+        fs::create_hard_link(from_path, to_path, error);
+        if(!error)
+          return fs::file_size(to_path);
+      }
+    return copy_file_and_count_bytes(from_path, to_path, zip);
+  }
+
   fs::path get_block_info_path(const fs::path &temp_dir, size_t block_index)
   {
     return temp_dir / El::BuildString("block_info_", block_index, ".json");
@@ -78,6 +111,7 @@ namespace
       {
       case json: name += ".json"; break;
       case bin: name += ".bin"; break;
+      case mmap_bin: name += ".mmap"; break;
       default: RUNTIME_ERROR("Unsupported Block_File_Format: ", format);
       }
     return temp_dir / name;
@@ -95,6 +129,48 @@ namespace
   {
     return temp_dir / "normalization.json";
   }
+  fs::path get_shards_path(const fs::path &temp_dir)
+  {
+    return temp_dir / "shards.json";
+  }
+
+  // sdp.zip -> sdp.shard_K.zip
+  fs::path get_zip_shard_path(const fs::path &output_path,
+                              const size_t shard_index)
+  {
+    fs::path result(output_path);
+    result.replace_filename(El::BuildString(output_path.stem().string(),
+                                            ".shard_", shard_index,
+                                            output_path.extension().string()));
+    return result;
+  }
+
+  // Split blocks into (at most) num_shards contiguous ranges
+  // having approximately the same total size of block_data files.
+  // Each range is non-empty.
+  // NB: the result should be the same on all ranks.
+  std::vector<std::vector<size_t>>
+  split_blocks_into_shards(const std::vector<size_t> &block_data_sizes,
+                           const size_t num_shards)
+  {
+    const size_t num_blocks = block_data_sizes.size();
+    const size_t total_size = std::accumulate(
+      block_data_sizes.begin(), block_data_sizes.end(), size_t(0));
+
+    std::vector<std::vector<size_t>> result(1);
+    size_t accumulated_size = 0;
+    for(size_t block_index = 0; block_index < num_blocks; ++block_index)
+      {
+        result.back().push_back(block_index);
+        accumulated_size += block_data_sizes.at(block_index);
+        // Current shard has reached its share of total size,
+        // start the next one.
+        if(result.size() < num_shards && block_index + 1 < num_blocks
+           && accumulated_size * num_shards >= total_size * result.size())
+          result.emplace_back();
+      }
+    return result;
+  }
 
   void archive_gzipped_file(const fs::path &path, const int64_t &num_bytes,
                             Archive_Writer &writer)
@@ -106,12 +182,45 @@ namespace
     writer.write_entry(Archive_Entry(path, num_bytes), input_stream);
   }
 
+  void archive_block_data(const fs::path &temp_dir,
+                          const Block_File_Format output_format,
+                          const std::vector<size_t> &block_indices,
+                          const std::vector<size_t> &block_data_sizes,
+                          Archive_Writer &writer, Timers &timers)
+  {
+    Scoped_Timer block_data_timer(timers, "block_data");
+    for(const auto block_index : block_indices)
+      {
+        Scoped_Timer index_timer(timers, std::to_string(block_index));
+        const auto block_data_path
+          = get_block_data_path(temp_dir, block_index, output_format);
+        archive_gzipped_file(block_data_path, block_data_sizes.at(block_index),
+                             writer);
+        fs::remove(block_data_path);
+      }
+  }
+
+  // Write block_data_XXX files for a given shard to sdp.shard_K.zip
+  void write_zip_shard(const fs::path &shard_path,
+                       const Block_File_Format output_format,
+                       const fs::path &temp_dir,
+                       const std::vector<size_t> &block_indices,
+                       const std::vector<size_t> &block_data_sizes,
+                       Timers &timers)
+  {
+    Scoped_Timer shard_timer(timers, shard_path.filename().string());
+    Archive_Writer writer(shard_path);
+    archive_block_data(temp_dir, output_format, block_indices,
+                       block_data_sizes, writer, timers);
+  }
+
   void
   write_to_zip(const fs::path &output_path, const Output_SDP &sdp,
                const Block_File_Format output_format, const fs::path &temp_dir,
                const size_t num_control_bytes,
                const size_t num_objectives_bytes,
                const std::optional<size_t> num_normalization_bytes,
+               const std::optional<size_t> num_shards_bytes,
                const std::vector<size_t> &block_info_sizes,
                const std::vector<size_t> &block_data_sizes, Timers &timers)
   {
@@ -125,6 +234,16 @@ namespace
       archive_gzipped_file(control_path, num_control_bytes, writer);
       fs::remove(control_path);
     }
+    // shards.json
+    // NB: SDPB stops looking for the manifest
+    // when it finds the first block_XXX file, so it should go first.
+    if(num_shards_bytes.has_value())
+      {
+        Scoped_Timer shards_timer(timers, "shards");
+        auto shards_path = get_shards_path(temp_dir);
+        archive_gzipped_file(shards_path, num_shards_bytes.value(), writer);
+        fs::remove(shards_path);
+      }
     // objectives.json
     {
       Scoped_Timer objectives_timer(timers, "objectives");
@@ -159,18 +278,59 @@ namespace
         }
     }
     // block_data_XXX.bin (or .json)
-    {
-      Scoped_Timer block_data_timer(timers, "block_data");
-      for(size_t block_index = 0; block_index != sdp.num_blocks; ++block_index)
-        {
-          Scoped_Timer index_timer(timers, std::to_string(block_index));
-          const auto block_data_path
-            = get_block_data_path(temp_dir, block_index, output_format);
-          archive_gzipped_file(block_data_path,
-                               block_data_sizes.at(block_index), writer);
-          fs::remove(block_data_path);
-        }
-    }
+    // If sdp.zip is sharded, block_data files are already
+    // written to sdp.shard_K.zip
+    if(!num_shards_bytes.has_value())
+      {
+        std::vector<size_t> block_indices(sdp.num_blocks);
+        std::iota(block_indices.begin(), block_indices.end(), 0);
+        archive_block_data(temp_dir, output_format, block_indices,
+                           block_data_sizes, writer, timers);
+      }
+  }
+
+  // Write block files to the cache.
+  // Several ranks may write the same block (if the PMP contains identical
+  // matrices), so we write to a temporary file and then rename it.
+  void write_block_to_cache(const Block_Cache &block_cache,
+                            const Block_Cache::Hash hash,
+                            const Dual_Constraint_Group &group)
+  {
+    const auto suffix = ".tmp." + std::to_string(El::mpi::Rank());
+
+    auto block_info_path = block_cache.block_info_path(hash);
+    auto temp_block_info_path = block_info_path;
+    temp_block_info_path += suffix;
+    write_data_and_count_bytes(
+      temp_block_info_path,
+      [&](std::ostream &os) { write_block_info_json(os, group); }, false);
+    fs::rename(temp_block_info_path, block_info_path);
+
+    auto block_data_path = block_cache.block_data_path(hash);
+    auto temp_block_data_path = block_data_path;
+    temp_block_data_path += suffix;
+    write_data_and_count_bytes(
+      temp_block_data_path,
+      [&](std::ostream &os) {
+        write_block_data(os, group, block_cache.format);
+      },
+      false, block_cache.format != json);
+    fs::rename(temp_block_data_path, block_data_path);
+  }
+
+  void copy_block_from_cache(const Block_Cache &block_cache,
+                             const Block_Cache::Hash hash,
+                             const size_t block_index, const fs::path &temp_dir,
+                             const bool zip,
+                             std::vector<size_t> &block_info_sizes,
+                             std::vector<size_t> &block_data_sizes)
+  {
+    block_info_sizes.at(block_index) = link_or_copy_file_and_count_bytes(
+      block_cache.block_info_path(hash),
+      get_block_info_path(temp_dir, block_index), zip);
+    block_data_sizes.at(block_index) = link_or_copy_file_and_count_bytes(
+      block_cache.block_data_path(hash),
+      get_block_data_path(temp_dir, block_index, block_cache.format), zip);
   }
 
   void check_file_size(const fs::path &file_path, const size_t expected_size)
@@ -230,70 +390,185 @@ namespace
 
 void write_sdp(const fs::path &output_path, const Output_SDP &sdp,
                Block_File_Format block_file_format, bool zip, Timers &timers,
-               const Verbosity verbosity)
+               const Verbosity verbosity, const size_t zip_shards,
+               const Block_Cache *block_cache)
 {
   Scoped_Timer write_timer(timers, "write_sdp");
 
-  const int rank = El::mpi::Rank();
-
-  fs::path temp_dir(output_path);
-  temp_dir += "_temp";
+  Output_SDP_Writer writer(output_path, sdp, block_file_format, zip, timers,
+                           verbosity, zip_shards, block_cache);
   {
-    Scoped_Timer clear_timer(timers, "clear_output_paths");
-    if(rank == 0)
+    Scoped_Timer block_files_timer(timers, "block_files");
+    for(size_t group_index = 0;
+        group_index < sdp.dual_constraint_groups.size(); ++group_index)
       {
-        if(fs::remove_all(temp_dir) != 0)
-          PRINT_WARNING("Temporary directory ", temp_dir,
-                        " exists and will be overwritten.");
-        if(fs::remove_all(output_path) != 0)
-          PRINT_WARNING("Output path ", output_path,
-                        " exists and will be overwritten.");
-
-        fs::create_directories(temp_dir);
+        std::optional<Block_Cache::Hash> hash;
+        if(block_cache != nullptr)
+          hash = sdp.dual_constraint_group_hashes.at(group_index);
+        writer.write_block(sdp.dual_constraint_groups.at(group_index), hash);
       }
-
-    // All ranks should wait until root clears the directories before writing.
-    Scoped_Timer mpi_barrier_timer(timers, "mpi_barrier");
-    El::mpi::Barrier();
+    for(const auto &cached_block : sdp.cached_blocks)
+      writer.copy_cached_block(cached_block);
   }
+  writer.finish(sdp);
+}
 
-  // We use size_t rather than std::streamsize because MPI treats
-  // std::streamsize as an MPI_LONG_INT and then can not MPI_Reduce
-  // over it.
-  std::vector<size_t> block_info_sizes(sdp.num_blocks, 0);
-  std::vector<size_t> block_data_sizes(sdp.num_blocks, 0);
+Output_SDP_Writer::Output_SDP_Writer(
+  const fs::path &output_path, const Output_SDP &sdp,
+  const Block_File_Format block_file_format, const bool zip, Timers &timers,
+  const Verbosity verbosity, const size_t zip_shards,
+  const Block_Cache *block_cache)
+    : output_path(output_path),
+      num_blocks(sdp.num_blocks),
+      dual_objective_size(sdp.dual_objective_b.size()),
+      block_file_format(block_file_format),
+      zip(zip),
+      timers(timers),
+      verbosity(verbosity),
+      zip_shards(zip_shards),
+      block_cache(block_cache),
+      block_info_sizes(num_blocks, 0),
+      block_data_sizes(num_blocks, 0)
+{
+  if(block_cache != nullptr)
+    {
+      ASSERT_EQUAL(block_cache->format, block_file_format);
+      block_hashes.resize(num_blocks, 0);
+    }
+  ASSERT(block_cache != nullptr || sdp.cached_blocks.empty(),
+         "Block cache is required to write cached blocks");
 
-  {
-    Scoped_Timer block_files_timer(timers, "block_files");
-    for(auto &group : sdp.dual_constraint_groups)
-      {
-        size_t width = group.constraint_matrix.Width();
-        size_t dual_objective_size = sdp.dual_objective_b.size();
-        ASSERT_EQUAL(width, dual_objective_size);
-        {
-          Scoped_Timer block_info_timer(
-            timers, "block_info_" + std::to_string(group.block_index));
-          const auto block_info_path
-            = get_block_info_path(temp_dir, group.block_index);
-          block_info_sizes.at(group.block_index) = write_data_and_count_bytes(
-            block_info_path,
-            [&](std::ostream &os) { write_block_info_json(os, group); }, zip);
-        }
+  temp_dir = output_path;
+  temp_dir += "_temp";
 
+  Scoped_Timer clear_timer(timers, "clear_output_paths");
+  if(El::mpi::Rank() == 0)
+    {
+      if(fs::remove_all(temp_dir) != 0)
+        PRINT_WARNING("Temporary directory ", temp_dir,
+                      " exists and will be overwritten.");
+      if(fs::remove_all(output_path) != 0)
+        PRINT_WARNING("Output path ", output_path,
+                      " exists and will be overwritten.");
+      if(zip)
         {
-          Scoped_Timer block_data_timer(
-            timers, "block_data_" + std::to_string(group.block_index));
-          const auto block_data_path = get_block_data_path(
-            temp_dir, group.block_index, block_file_format);
-          block_data_sizes.at(group.block_index) = write_data_and_count_bytes(
-            block_data_path,
-            [&](std::ostream &os) {
-              write_block_data(os, group, block_file_format);
-            },
-            zip, block_file_format == bin);
+          for(size_t shard = 0; shard < zip_shards; ++shard)
+            {
+              const auto shard_path = get_zip_shard_path(output_path, shard);
+              if(fs::remove(shard_path))
+                PRINT_WARNING("Output path ", shard_path,
+                              " exists and will be overwritten.");
+            }
         }
-      }
+
+      fs::create_directories(temp_dir);
+      if(block_cache != nullptr)
+        fs::create_directories(block_cache->dir);
+    }
+
+  // All ranks should wait until root clears the directories before writing.
+  Scoped_Timer mpi_barrier_timer(timers, "mpi_barrier");
+  El::mpi::Barrier();
+}
+
+void Output_SDP_Writer::write_block(const Dual_Constraint_Group &group,
+                                    const std::optional<Block_Cache::Hash> hash)
+{
+  ASSERT(group.block_index < num_blocks, DEBUG_STRING(group.block_index),
+         DEBUG_STRING(num_blocks));
+  ASSERT_EQUAL(static_cast<size_t>(group.constraint_matrix.Width()),
+               dual_objective_size);
+  ASSERT_EQUAL(hash.has_value(), block_cache != nullptr);
+  matrix_sizes.add(group);
+
+  if(block_cache != nullptr)
+    {
+      // Write new block to the cache, then link (or copy) it to temp_dir
+      Scoped_Timer block_cache_timer(
+        timers, "block_cache_" + std::to_string(group.block_index));
+      write_block_to_cache(*block_cache, hash.value(), group);
+      copy_block_from_cache(*block_cache, hash.value(), group.block_index,
+                            temp_dir, zip, block_info_sizes,
+                            block_data_sizes);
+      block_hashes.at(group.block_index) = hash.value();
+      return;
+    }
+  {
+    Scoped_Timer block_info_timer(
+      timers, "block_info_" + std::to_string(group.block_index));
+    const auto block_info_path
+      = get_block_info_path(temp_dir, group.block_index);
+    block_info_sizes.at(group.block_index) = write_data_and_count_bytes(
+      block_info_path,
+      [&](std::ostream &os) { write_block_info_json(os, group); }, zip);
   }
+
+  {
+    Scoped_Timer block_data_timer(
+      timers, "block_data_" + std::to_string(group.block_index));
+    const auto block_data_path
+      = get_block_data_path(temp_dir, group.block_index, block_file_format);
+    block_data_sizes.at(group.block_index) = write_data_and_count_bytes(
+      block_data_path,
+      [&](std::ostream &os) {
+        write_block_data(os, group, block_file_format);
+      },
+      zip, block_file_format != json);
+  }
+}
+
+void Output_SDP_Writer::copy_cached_block(
+  const Output_SDP::Cached_Block &cached_block)
+{
+  ASSERT(block_cache != nullptr,
+         "Block cache is required to write cached blocks");
+  ASSERT(cached_block.block_index < num_blocks,
+         DEBUG_STRING(cached_block.block_index), DEBUG_STRING(num_blocks));
+  Scoped_Timer cached_block_timer(
+    timers, "cached_block_" + std::to_string(cached_block.block_index));
+  copy_block_from_cache(*block_cache, cached_block.hash,
+                        cached_block.block_index, temp_dir, zip,
+                        block_info_sizes, block_data_sizes);
+  block_hashes.at(cached_block.block_index) = cached_block.hash;
+}
+
+void Output_SDP_Writer::write_new_blocks(Output_SDP &sdp)
+{
+  for(size_t group_index = 0; group_index < sdp.dual_constraint_groups.size();
+      ++group_index)
+    {
+      std::optional<Block_Cache::Hash> hash;
+      if(block_cache != nullptr)
+        hash = sdp.dual_constraint_group_hashes.at(group_index);
+      write_block(sdp.dual_constraint_groups.at(group_index), hash);
+    }
+  sdp.dual_constraint_groups.clear();
+  sdp.dual_constraint_groups.shrink_to_fit();
+  sdp.dual_constraint_group_hashes.clear();
+
+  for(; num_copied_cached_blocks < sdp.cached_blocks.size();
+      ++num_copied_cached_blocks)
+    copy_cached_block(sdp.cached_blocks.at(num_copied_cached_blocks));
+}
+
+void Output_SDP_Writer::finish(const Output_SDP &sdp)
+{
+  ASSERT_EQUAL(sdp.num_blocks, num_blocks);
+  ASSERT_EQUAL(sdp.dual_objective_b.size(), dual_objective_size);
+
+  const int rank = El::mpi::Rank();
+
+  // Remove blocks that are not used anymore, so that the cache
+  // always corresponds to the latest pmp2sdp run.
+  if(block_cache != nullptr)
+    {
+      Scoped_Timer prune_timer(timers, "prune_block_cache");
+      // Each block is owned by exactly one rank
+      El::mpi::Reduce(block_hashes.data(), block_hashes.size(), El::mpi::SUM,
+                      0, El::mpi::COMM_WORLD);
+      if(rank == 0)
+        block_cache->prune(block_hashes);
+    }
   {
     Scoped_Timer reduce_timer(timers, "mpi_reduce_block_sizes");
 
@@ -330,9 +605,34 @@ void write_sdp(const fs::path &output_path, const Output_SDP &sdp,
   }
   if(verbosity >= Verbosity::debug)
     {
-      print_matrix_sizes(rank, sdp.dual_objective_b,
-                         sdp.dual_constraint_groups);
+      print_matrix_sizes();
+    }
+
+  // Write block_data files to sdp.shard_K.zip.
+  // Shards are distributed among all ranks in a round-robin way.
+  std::vector<fs::path> shard_paths;
+  std::vector<std::vector<size_t>> shard_block_indices;
+  if(zip && zip_shards > 1)
+    {
+      Scoped_Timer zip_shards_timer(timers, "zip_shards");
+      El::mpi::Broadcast(block_data_sizes.data(), block_data_sizes.size(), 0,
+                         El::mpi::COMM_WORLD);
+      shard_block_indices
+        = split_blocks_into_shards(block_data_sizes, zip_shards);
+      for(size_t shard = 0; shard < shard_block_indices.size(); ++shard)
+        {
+          shard_paths.push_back(get_zip_shard_path(output_path, shard));
+          if(shard % El::mpi::Size() == static_cast<size_t>(rank))
+            {
+              write_zip_shard(shard_paths.at(shard), block_file_format,
+                              temp_dir, shard_block_indices.at(shard),
+                              block_data_sizes, timers);
+            }
+        }
+      Scoped_Timer mpi_barrier_timer(timers, "mpi_barrier");
+      El::mpi::Barrier();
     }
+
   if(rank == 0)
     {
       // write control.json and objectives.json
@@ -359,12 +659,23 @@ void write_sdp(const fs::path &output_path, const Output_SDP &sdp,
             zip);
         }
 
+      std::optional<size_t> num_shards_bytes;
+      if(!shard_paths.empty())
+        {
+          num_shards_bytes = write_data_and_count_bytes(
+            get_shards_path(temp_dir),
+            [&](std::ostream &os) {
+              write_shards_json(os, shard_paths, shard_block_indices);
+            },
+            zip);
+        }
+
       if(zip)
         {
           write_to_zip(output_path, sdp, block_file_format, temp_dir,
                        num_control_bytes, num_objectives_bytes,
-                       num_normalization_bytes, block_info_sizes,
-                       block_data_sizes, timers);
+                       num_normalization_bytes, num_shards_bytes,
+                       block_info_sizes, block_data_sizes, timers);
           // Do not call remove_all() to ensure that we
           // don't remove anything useful.
           // This function will fail if temp_dir is not empty.
@@ -381,10 +692,40 @@ void write_sdp(const fs::path &output_path, const Output_SDP &sdp,
     }
 }
 
-void print_matrix_sizes(
-  const int &rank, const std::vector<El::BigFloat> &dual_objective_b,
-  const std::vector<Dual_Constraint_Group> &dual_constraint_groups)
+// Hereafter XXX_elements means number of nonzero elements in XXX
+void Output_SDP_Writer::Matrix_Sizes::add(const Dual_Constraint_Group &group)
 {
+  P += group.constraint_constants.size();
+
+  constraint_matrix_elements += group.constraint_matrix.MemorySize();
+  bilinear_bases_elements += group.bilinear_bases[0].MemorySize()
+                             + group.bilinear_bases[1].MemorySize();
+
+  // variables stored in Block_Info
+  size_t dimensions = group.dim;
+  size_t num_points = group.num_points; // see write_blocks()
+
+  // See Block_Info::schur_block_sizes()
+  size_t schur_width = num_points * dimensions * (dimensions + 1) / 2;
+  schur_elements += schur_width * schur_width;
+
+  // See Block_Info::bilinear_pairing_block_sizes()
+  // two blocks, each one has same size
+  size_t bilinear_pairing_block_width = num_points * dimensions;
+  bilinear_pairing_block_elements
+    += 2 * bilinear_pairing_block_width * bilinear_pairing_block_width;
+
+  // See Block_Info::psd_matrix_block_sizes()
+  // for each group we have two psd square matrix blocks, with width
+  // psd_even and psd_odd
+  auto psd_even = dimensions * ((num_points + 1) / 2);
+  auto psd_odd = dimensions * num_points - psd_even;
+  psd_elements += psd_even * psd_even + psd_odd * psd_odd;
+}
+
+void Output_SDP_Writer::print_matrix_sizes() const
+{
+  const int rank = El::mpi::Rank();
   if(rank == 0)
     {
       El::Output("---------------------");
@@ -392,60 +733,27 @@ void print_matrix_sizes(
       El::Output("---------------------");
     }
 
-  size_t N = dual_objective_b.size();
-  size_t my_P = 0; // P' for a given group
-
-  // Hereafter XXX_elements means number of nonzero elements in XXX
-  size_t my_constraint_matrix_elements = 0;
-  size_t my_bilinear_bases_elements = 0;
-  size_t my_bilinear_pairing_block_elements = 0;
-  size_t my_psd_elements = 0;
-  size_t my_schur_elements = 0;
-  for(auto &group : dual_constraint_groups)
-    {
-      my_P += group.constraint_constants.size();
-
-      my_constraint_matrix_elements += group.constraint_matrix.MemorySize();
-      my_bilinear_bases_elements += group.bilinear_bases[0].MemorySize()
-                                    + group.bilinear_bases[1].MemorySize();
-
-      // variables stored in Block_Info
-      size_t dimensions = group.dim;
-      size_t num_points = group.num_points; // see write_blocks()
-
-      // See Block_Info::schur_block_sizes()
-      size_t schur_width = num_points * dimensions * (dimensions + 1) / 2;
-      my_schur_elements += schur_width * schur_width;
-
-      // See Block_Info::bilinear_pairing_block_sizes()
-      // two blocks, each one has same size
-      size_t bilinear_pairing_block_width = num_points * dimensions;
-      my_bilinear_pairing_block_elements
-        += 2 * bilinear_pairing_block_width * bilinear_pairing_block_width;
-
-      // See Block_Info::psd_matrix_block_sizes()
-      // for each group we have two psd square matrix blocks, with width
-      // psd_even and psd_odd
-      auto psd_even = dimensions * ((num_points + 1) / 2);
-      auto psd_odd = dimensions * num_points - psd_even;
-      my_psd_elements += psd_even * psd_even + psd_odd * psd_odd;
-    }
-  ASSERT(my_P * N == my_constraint_matrix_elements,
+  size_t N = dual_objective_size;
+  // P' for blocks written by the current rank
+  size_t my_P = matrix_sizes.P;
+  ASSERT(my_P * N == matrix_sizes.constraint_matrix_elements,
          "sum(P'*N) != #(B bands): P'=", my_P, ", N=", N,
-         "#(B bands)=", my_constraint_matrix_elements);
+         "#(B bands)=", matrix_sizes.constraint_matrix_elements);
 
   // NB: Reduce should be called on all ranks, its result used only on rank 0!
   auto reduce_sum = [](size_t item) {
     return El::mpi::Reduce(item, El::mpi::SUM, 0, El::mpi::COMM_WORLD);
   };
 
-  size_t B_matrix_elements = reduce_sum(my_constraint_matrix_elements);
+  size_t B_matrix_elements
+    = reduce_sum(matrix_sizes.constraint_matrix_elements);
   size_t bilinear_pairing_block_elements
-    = reduce_sum(my_bilinear_pairing_block_elements);
-  size_t psd_blocks_elements = reduce_sum(my_psd_elements);
-  size_t schur_elements = reduce_sum(my_schur_elements);
+    = reduce_sum(matrix_sizes.bilinear_pairing_block_elements);
+  size_t psd_blocks_elements = reduce_sum(matrix_sizes.psd_elements);
+  size_t schur_elements = reduce_sum(matrix_sizes.schur_elements);
   size_t P = reduce_sum(my_P);
-  size_t bilinear_bases_elements = reduce_sum(my_bilinear_bases_elements);
+  size_t bilinear_bases_elements
+    = reduce_sum(matrix_sizes.bilinear_bases_elements);
 
   if(rank == 0)
     {
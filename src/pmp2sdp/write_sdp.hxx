@@ -1,11 +1,83 @@
 #pragma once
 
+#include "Block_Cache.hxx"
 #include "Block_File_Format.hxx"
 #include "Output_SDP/Output_SDP.hxx"
 #include "sdpb_util/Timers/Timers.hxx"
 
 #include <filesystem>
+#include <optional>
+
+#include <boost/noncopyable.hpp>
 
 void write_sdp(const std::filesystem::path &output_path, const Output_SDP &sdp,
                Block_File_Format block_file_format, bool zip, Timers &timers,
-               Verbosity verbosity);
+               Verbosity verbosity, size_t zip_shards = 1,
+               const Block_Cache *block_cache = nullptr);
+
+// Write SDP to output_path block by block:
+// 1. Constructor clears output paths.
+// 2. Blocks owned by the current rank are written to a temporary directory
+//    via write_block(), copy_cached_block() or write_new_blocks().
+// 3. finish() writes control.json, objectives.json etc.
+//    and moves everything to output_path (or to sdp.zip).
+//
+// This allows to write each block as soon as it is created
+// and then release it, see pmp2sdp.
+// Constructor and finish() are collective operations.
+class Output_SDP_Writer : boost::noncopyable
+{
+public:
+  Output_SDP_Writer(const std::filesystem::path &output_path,
+                    const Output_SDP &sdp, Block_File_Format block_file_format,
+                    bool zip, Timers &timers, Verbosity verbosity,
+                    size_t zip_shards = 1,
+                    const Block_Cache *block_cache = nullptr);
+
+  // hash is required if and only if block_cache is set
+  void write_block(const Dual_Constraint_Group &group,
+                   std::optional<Block_Cache::Hash> hash);
+  void copy_cached_block(const Output_SDP::Cached_Block &cached_block);
+  // Write blocks added to sdp since the previous call,
+  // then release sdp.dual_constraint_groups.
+  void write_new_blocks(Output_SDP &sdp);
+
+  void finish(const Output_SDP &sdp);
+
+private:
+  const std::filesystem::path output_path;
+  std::filesystem::path temp_dir;
+  const size_t num_blocks;
+  const size_t dual_objective_size;
+  const Block_File_Format block_file_format;
+  const bool zip;
+  Timers &timers;
+  const Verbosity verbosity;
+  const size_t zip_shards;
+  const Block_Cache *block_cache;
+
+  // We use size_t rather than std::streamsize because MPI treats
+  // std::streamsize as an MPI_LONG_INT and then can not MPI_Reduce
+  // over it.
+  std::vector<size_t> block_info_sizes;
+  std::vector<size_t> block_data_sizes;
+  // Hashes of blocks written by the current rank (only if block_cache is set)
+  std::vector<Block_Cache::Hash> block_hashes;
+  size_t num_copied_cached_blocks = 0;
+
+  // Number of elements in the blocks written by the current rank,
+  // see print_matrix_sizes()
+  struct Matrix_Sizes
+  {
+    size_t P = 0;
+    size_t constraint_matrix_elements = 0;
+    size_t bilinear_bases_elements = 0;
+    size_t bilinear_pairing_block_elements = 0;
+    size_t psd_elements = 0;
+    size_t schur_elements = 0;
+
+    void add(const Dual_Constraint_Group &group);
+  } matrix_sizes;
+
+  void print_matrix_sizes() const;
+};
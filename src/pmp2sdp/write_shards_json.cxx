@@ -0,0 +1,29 @@
+#include "write_vector.hxx"
+
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+// Manifest for sharded sdp.zip:
+// for each shard, its file name (relative to sdp.zip directory)
+// and indices of block_data files stored in it.
+void write_shards_json(
+  std::ostream &output_stream,
+  const std::vector<std::filesystem::path> &shard_paths,
+  const std::vector<std::vector<size_t>> &shard_block_indices)
+{
+  output_stream << "{\n  \"num_shards\": " << shard_paths.size()
+                << ",\n  \"shards\": [";
+  for(size_t shard = 0; shard < shard_paths.size(); ++shard)
+    {
+      if(shard != 0)
+        output_stream << ",";
+      output_stream << "\n    {\n      \"path\": \""
+                    << shard_paths.at(shard).filename().string()
+                    << "\",\n      ";
+      write_vector(output_stream, shard_block_indices.at(shard),
+                   "block_indices");
+      output_stream << "\n    }";
+    }
+  output_stream << "\n  ]\n}\n";
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "PMP_File_Index.hxx"
+#include "pmp/Polynomial_Vector_Matrix.hxx"
+
+#include <El.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary PMP format (.pmpb files), written by pmp2binary.
+//
+// Numbers are stored as raw GMP limbs, so reading them requires no decimal
+// conversion. Matrices are stored with their sample points, sample scalings
+// and bilinear basis, so that these are not recomputed either.
+// Numbers are truncated to the current precision when reading,
+// so the file should be written with at least the precision used by pmp2sdp.
+//
+// Layout:
+// - Header (see below).
+// - Objective and normalization vectors (normalization is optional).
+// - Matrix records, in the order of global matrix indices.
+// - Index: (offset, size) in bytes for each matrix record.
+//
+// Vector: uint64 length, followed by numbers.
+// Number: int64 size, int64 exponent, followed by |size| limbs,
+//   where size and exponent are the mpf_t fields _mp_size and _mp_exp.
+//   Zero has size=0 and no limbs.
+// Polynomial: vector of coefficients.
+// Polynomial_Vector: uint64 length, followed by polynomials.
+// Matrix record:
+//   uint64 flags (see Matrix_Flags), uint64 rows, uint64 columns,
+//   rows * columns Polynomial_Vectors in column-major order,
+//   followed by the optional fields present in flags:
+//   sample points vector, sample scalings vector,
+//   bilinear basis Polynomial_Vector.
+//   Missing fields are computed from the default prefactor, as for other
+//   input formats.
+//
+// All integers are written in native byte order.
+namespace Binary_PMP_Format
+{
+  constexpr std::array<char, 8> magic
+    = {'S', 'D', 'P', 'B', 'P', 'M', 'P', 'B'};
+  constexpr uint64_t version = 1;
+  constexpr const char *extension = ".pmpb";
+
+  struct Header
+  {
+    std::array<char, 8> magic = Binary_PMP_Format::magic;
+    uint64_t version = Binary_PMP_Format::version;
+    // GMP_NUMB_BITS of the writer
+    uint64_t limb_bits = 0;
+    // El::gmp::Precision() of the writer
+    uint64_t precision = 0;
+    uint64_t num_matrices = 0;
+    uint64_t objective_offset = 0;
+    // 0 if there is no normalization
+    uint64_t normalization_offset = 0;
+    uint64_t index_offset = 0;
+  };
+
+  struct Index_Entry
+  {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  enum Matrix_Flags : uint64_t
+  {
+    has_sample_points = 1 << 0,
+    has_sample_scalings = 1 << 1,
+    has_bilinear_basis = 1 << 2
+  };
+
+  // Append objects to a byte buffer
+  struct Writer
+  {
+    std::string buffer;
+
+    void write(uint64_t value);
+    void write(const El::BigFloat &value);
+    void write(const std::vector<El::BigFloat> &vector);
+    void write(const Polynomial_Vector &polynomials);
+    void write(const Polynomial_Vector_Matrix &matrix);
+  };
+
+  // Read objects from a byte range
+  struct Reader
+  {
+    const char *begin;
+    const char *current;
+    const char *end;
+
+    Reader(const char *begin, const char *end);
+
+    uint64_t read_uint64();
+    void read(El::BigFloat &value);
+    std::vector<El::BigFloat> read_vector();
+    Polynomial_Vector read_polynomial_vector();
+    Polynomial_Vector_Matrix read_matrix();
+
+  private:
+    void read_bytes(void *output, size_t num_bytes);
+  };
+
+  // Check header and read index.
+  // Byte ranges of matrices are the index entries.
+  PMP_File_Index read_index(const char *begin, const char *end);
+}
@@ -0,0 +1,220 @@
+#include "pmp_read/Binary_PMP_Format.hxx"
+
+#include "sdpb_util/assert.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Binary_PMP_Format
+{
+  // Writer
+
+  void Writer::write(const uint64_t value)
+  {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  void Writer::write(const El::BigFloat &value)
+  {
+    const auto mpf = value.gmp_float.get_mpf_t();
+    const int64_t size = mpf->_mp_size;
+    const int64_t exponent = mpf->_mp_exp;
+    buffer.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    buffer.append(reinterpret_cast<const char *>(&exponent),
+                  sizeof(exponent));
+    buffer.append(reinterpret_cast<const char *>(mpf->_mp_d),
+                  std::abs(size) * sizeof(mp_limb_t));
+  }
+
+  void Writer::write(const std::vector<El::BigFloat> &vector)
+  {
+    write(static_cast<uint64_t>(vector.size()));
+    for(const auto &value : vector)
+      write(value);
+  }
+
+  void Writer::write(const Polynomial_Vector &polynomials)
+  {
+    write(static_cast<uint64_t>(polynomials.size()));
+    for(const auto &polynomial : polynomials)
+      write(polynomial.coefficients);
+  }
+
+  void Writer::write(const Polynomial_Vector_Matrix &matrix)
+  {
+    write(static_cast<uint64_t>(has_sample_points | has_sample_scalings
+                                | has_bilinear_basis));
+    write(static_cast<uint64_t>(matrix.polynomials.Height()));
+    write(static_cast<uint64_t>(matrix.polynomials.Width()));
+    for(int j = 0; j < matrix.polynomials.Width(); ++j)
+      for(int i = 0; i < matrix.polynomials.Height(); ++i)
+        write(matrix.polynomials(i, j));
+    write(matrix.sample_points);
+    write(matrix.sample_scalings);
+    write(matrix.bilinear_basis);
+  }
+
+  // Reader
+
+  Reader::Reader(const char *begin, const char *end)
+      : begin(begin), current(begin), end(end)
+  {}
+
+  void Reader::read_bytes(void *output, const size_t num_bytes)
+  {
+    ASSERT(num_bytes <= static_cast<size_t>(end - current),
+           "Unexpected end of data at offset ", current - begin,
+           ": expected ", num_bytes, " bytes, remaining ", end - current);
+    std::memcpy(output, current, num_bytes);
+    current += num_bytes;
+  }
+
+  uint64_t Reader::read_uint64()
+  {
+    uint64_t value;
+    read_bytes(&value, sizeof(value));
+    return value;
+  }
+
+  void Reader::read(El::BigFloat &value)
+  {
+    int64_t size;
+    int64_t exponent;
+    read_bytes(&size, sizeof(size));
+    read_bytes(&exponent, sizeof(exponent));
+    const size_t num_limbs = std::abs(size);
+    ASSERT(num_limbs * sizeof(mp_limb_t)
+             <= static_cast<size_t>(end - current),
+           "Unexpected end of data at offset ", current - begin,
+           ": number has ", num_limbs, " limbs");
+
+    // Keep only the most significant limbs that fit into current precision.
+    // mpf_t always has _mp_prec + 1 limbs allocated.
+    value = 0;
+    const auto mpf = value.gmp_float.get_mpf_t();
+    const size_t num_kept
+      = std::min(num_limbs, static_cast<size_t>(mpf->_mp_prec) + 1);
+    std::memcpy(mpf->_mp_d,
+                current + (num_limbs - num_kept) * sizeof(mp_limb_t),
+                num_kept * sizeof(mp_limb_t));
+    current += num_limbs * sizeof(mp_limb_t);
+    mpf->_mp_size = size < 0 ? -static_cast<int>(num_kept)
+                             : static_cast<int>(num_kept);
+    mpf->_mp_exp = num_kept == 0 ? 0 : exponent;
+  }
+
+  std::vector<El::BigFloat> Reader::read_vector()
+  {
+    std::vector<El::BigFloat> result(read_uint64());
+    for(auto &value : result)
+      read(value);
+    return result;
+  }
+
+  Polynomial_Vector Reader::read_polynomial_vector()
+  {
+    Polynomial_Vector result(read_uint64());
+    for(auto &polynomial : result)
+      polynomial.coefficients = read_vector();
+    return result;
+  }
+
+  Polynomial_Vector_Matrix Reader::read_matrix()
+  {
+    const auto flags = read_uint64();
+    ASSERT((flags
+            & ~static_cast<uint64_t>(has_sample_points | has_sample_scalings
+                                     | has_bilinear_basis))
+             == 0,
+           "Unknown matrix flags: ", flags);
+    const auto height = read_uint64();
+    const auto width = read_uint64();
+    El::Matrix<Polynomial_Vector> polynomials(height, width);
+    for(size_t j = 0; j < width; ++j)
+      for(size_t i = 0; i < height; ++i)
+        polynomials(i, j) = read_polynomial_vector();
+
+    std::optional<std::vector<El::BigFloat>> sample_points;
+    std::optional<std::vector<El::BigFloat>> sample_scalings;
+    std::optional<Polynomial_Vector> bilinear_basis;
+    if(flags & has_sample_points)
+      sample_points = read_vector();
+    if(flags & has_sample_scalings)
+      sample_scalings = read_vector();
+    if(flags & has_bilinear_basis)
+      bilinear_basis = read_polynomial_vector();
+    ASSERT(current == end, "Unexpected ", end - current,
+           " bytes after the end of matrix");
+
+    return Polynomial_Vector_Matrix(polynomials, std::nullopt, sample_points,
+                                    sample_scalings, bilinear_basis);
+  }
+
+  // Index
+
+  PMP_File_Index read_index(const char *begin, const char *end)
+  {
+    const size_t file_size = end - begin;
+    Header header;
+    ASSERT(file_size >= sizeof(Header),
+           "File is too small: ", file_size, " bytes");
+    std::memcpy(&header, begin, sizeof(Header));
+    ASSERT(header.magic == magic, "Not a binary PMP file");
+    ASSERT_EQUAL(header.version, version, "Unsupported format version");
+    ASSERT_EQUAL(header.limb_bits, GMP_NUMB_BITS,
+                 "File was written on a platform with different GMP limbs");
+    if(header.precision < El::gmp::Precision())
+      {
+        PRINT_WARNING("Binary PMP file was written with precision=",
+                      header.precision,
+                      ", which is lower than current precision=",
+                      El::gmp::Precision());
+      }
+
+    ASSERT(header.index_offset <= file_size
+             && header.num_matrices * sizeof(Index_Entry)
+                  <= file_size - header.index_offset,
+           "Index does not fit into file: ", DEBUG_STRING(file_size),
+           DEBUG_STRING(header.index_offset),
+           DEBUG_STRING(header.num_matrices));
+
+    PMP_File_Index result;
+    result.matrices.reserve(header.num_matrices);
+    for(size_t i = 0; i < header.num_matrices; ++i)
+      {
+        Index_Entry entry;
+        std::memcpy(&entry,
+                    begin + header.index_offset + i * sizeof(Index_Entry),
+                    sizeof(Index_Entry));
+        ASSERT(entry.offset <= header.index_offset
+                 && entry.size <= header.index_offset - entry.offset,
+               "Matrix ", i, " does not fit into file: ",
+               DEBUG_STRING(entry.offset), DEBUG_STRING(entry.size));
+        result.matrices.push_back({entry.offset, entry.offset + entry.size});
+      }
+
+    // Objective and normalization are followed by matrices (or index)
+    const size_t vectors_end = result.matrices.empty()
+                                 ? header.index_offset
+                                 : result.matrices.front().begin;
+    ASSERT(header.objective_offset >= sizeof(Header)
+             && header.objective_offset <= vectors_end,
+           DEBUG_STRING(header.objective_offset), DEBUG_STRING(vectors_end));
+    if(header.normalization_offset == 0)
+      {
+        result.objective = Byte_Range{header.objective_offset, vectors_end};
+      }
+    else
+      {
+        ASSERT(header.normalization_offset >= header.objective_offset
+                 && header.normalization_offset <= vectors_end,
+               DEBUG_STRING(header.normalization_offset),
+               DEBUG_STRING(vectors_end));
+        result.objective
+          = Byte_Range{header.objective_offset, header.normalization_offset};
+        result.normalization
+          = Byte_Range{header.normalization_offset, vectors_end};
+      }
+    return result;
+  }
+}
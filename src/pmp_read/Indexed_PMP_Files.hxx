@@ -0,0 +1,78 @@
+#pragma once
+
+#include "PMP_File_Index.hxx"
+#include "PMP_File_Parse_Result.hxx"
+#include "sdpb_util/Environment.hxx"
+#include "sdpb_util/Timers/Timers.hxx"
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+// PMP files that can be indexed (.json, .m, .xml and .pmpb),
+// see PMP_File_Index.
+//
+// 1. Each file is indexed by a single rank (files are distributed by size).
+// 2. Indices are synchronized among all ranks.
+// 3. Matrices from all files are distributed among all ranks
+//    according to their size in bytes.
+//    Each rank parses only its own byte ranges,
+//    so that a single large file is parsed by all nodes.
+//    Objective and normalization are parsed by the rank that indexed the file.
+// 4. If several ranks on a node need the same file, the first rank on the node
+//    reads it once to Shared_File_Buffer, and all of them parse from there.
+//    Otherwise, the file is mapped to memory by the single rank that needs it.
+//
+// Steps 1-3 are done in the constructor.
+// Objective/normalization and matrices are parsed separately,
+// so that matrices can be processed one by one, without keeping
+// all of them in memory, see Streaming_PMP_Reader.
+//
+// Constructor, parse_vectors() and parse_matrices() are collective
+// operations and should be called by all ranks.
+class Indexed_PMP_Files : boost::noncopyable
+{
+public:
+  // Index all_files[i] for i in file_indices
+  Indexed_PMP_Files(const Environment &env,
+                    const std::vector<std::filesystem::path> &all_files,
+                    const std::vector<size_t> &file_indices, Timers &timers);
+
+  // Number of matrices in each file, in the order of file_indices
+  [[nodiscard]] std::vector<size_t> num_matrices() const;
+
+  // Parse objective and normalization from the files indexed
+  // by the current rank. Matrices are not parsed.
+  // Returns parse results for these files, with file indices as keys.
+  [[nodiscard]] std::map<size_t, PMP_File_Parse_Result>
+  parse_vectors(Timers &timers) const;
+
+  // Parse matrices assigned to the current rank, one at a time,
+  // and pass them to process_matrix(file_index, index_in_file, matrix).
+  void parse_matrices(
+    const std::function<void(size_t file_index, size_t index_in_file,
+                             Polynomial_Vector_Matrix &&matrix)>
+      &process_matrix,
+    Timers &timers) const;
+
+private:
+  const Environment &env;
+  const std::vector<std::filesystem::path> all_files;
+  const std::vector<size_t> file_indices;
+  // Index and owner rank for each file from file_indices
+  std::vector<PMP_File_Index> indices;
+  std::vector<int> file_owners;
+  // For each file from file_indices,
+  // indices of matrices assigned to the current rank
+  std::vector<std::vector<size_t>> my_matrices;
+
+  // Call process_file(i, data) for each i such that should_read[i] is true,
+  // where data points to the content of all_files[file_indices[i]].
+  void for_each_file(
+    const std::vector<bool> &should_read,
+    const std::function<void(size_t i, const char *data)> &process_file,
+    Timers &timers) const;
+};
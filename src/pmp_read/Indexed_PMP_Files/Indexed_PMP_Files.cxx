@@ -0,0 +1,351 @@
+#include "../Binary_PMP_Format.hxx"
+#include "../Indexed_PMP_Files.hxx"
+#include "../read_mathematica/parse_SDP/parse_vector.hxx"
+#include "sdpb_util/Memory_Mapped_File.hxx"
+#include "sdpb_util/Shared_File_Buffer.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <numeric>
+#include <optional>
+#include <queue>
+
+namespace fs = std::filesystem;
+
+Polynomial_Vector_Matrix parse_json_matrix(const char *begin, const char *end);
+std::vector<El::BigFloat> parse_json_vector(const char *begin, const char *end);
+Polynomial_Vector_Matrix parse_xml_matrix(const char *begin, const char *end);
+std::vector<El::BigFloat> parse_xml_vector(const char *begin, const char *end);
+
+const char *parse_matrix(const char *begin, const char *end,
+                         std::unique_ptr<Polynomial_Vector_Matrix> &matrix);
+
+namespace
+{
+  // Assign jobs to ranks: largest jobs first, each to the least loaded rank.
+  // The result is deterministic, i.e. the same on all ranks.
+  std::vector<int>
+  assign_to_ranks(const std::vector<size_t> &costs, const int num_ranks)
+  {
+    std::vector<size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&costs](const size_t a, const size_t b) {
+                       return costs.at(a) > costs.at(b);
+                     });
+
+    using Load = std::pair<size_t, int>;
+    std::priority_queue<Load, std::vector<Load>, std::greater<>> loads;
+    for(int rank = 0; rank < num_ranks; ++rank)
+      loads.emplace(0, rank);
+
+    std::vector<int> result(costs.size());
+    for(const auto index : order)
+      {
+        const auto [load, rank] = loads.top();
+        loads.pop();
+        result.at(index) = rank;
+        loads.emplace(load + costs.at(index), rank);
+      }
+    return result;
+  }
+
+  std::vector<El::BigFloat>
+  parse_vector_range(const fs::path &path, const char *data,
+                     const Byte_Range &range)
+  {
+    const auto begin = data + range.begin;
+    const auto end = data + range.end;
+    if(path.extension() == ".json")
+      return parse_json_vector(begin, end);
+    if(path.extension() == ".xml")
+      return parse_xml_vector(begin, end);
+    if(path.extension() == Binary_PMP_Format::extension)
+      return Binary_PMP_Format::Reader(begin, end).read_vector();
+    std::vector<El::BigFloat> result;
+    parse_vector(begin, end, result);
+    return result;
+  }
+
+  Polynomial_Vector_Matrix parse_matrix_range(const fs::path &path,
+                                              const char *data,
+                                              const Byte_Range &range)
+  {
+    const auto begin = data + range.begin;
+    const auto end = data + range.end;
+    if(path.extension() == ".json")
+      return parse_json_matrix(begin, end);
+    if(path.extension() == ".xml")
+      return parse_xml_matrix(begin, end);
+    if(path.extension() == Binary_PMP_Format::extension)
+      return Binary_PMP_Format::Reader(begin, end).read_matrix();
+    std::unique_ptr<Polynomial_Vector_Matrix> matrix;
+    parse_matrix(begin, end, matrix);
+    return std::move(*matrix);
+  }
+
+  // Index layout for synchronization:
+  // num_matrices, has_objective, objective.begin, objective.end,
+  // has_normalization, normalization.begin, normalization.end
+  constexpr size_t header_size = 7;
+
+  void write_header(const PMP_File_Index &index, size_t *header)
+  {
+    header[0] = index.matrices.size();
+    header[1] = index.objective.has_value();
+    header[2] = index.objective.value_or(Byte_Range{}).begin;
+    header[3] = index.objective.value_or(Byte_Range{}).end;
+    header[4] = index.normalization.has_value();
+    header[5] = index.normalization.value_or(Byte_Range{}).begin;
+    header[6] = index.normalization.value_or(Byte_Range{}).end;
+  }
+
+  PMP_File_Index read_header(const size_t *header)
+  {
+    PMP_File_Index index;
+    index.matrices.resize(header[0]);
+    if(header[1] != 0)
+      index.objective = Byte_Range{header[2], header[3]};
+    if(header[4] != 0)
+      index.normalization = Byte_Range{header[5], header[6]};
+    return index;
+  }
+}
+
+Indexed_PMP_Files::Indexed_PMP_Files(const Environment &env,
+                                     const std::vector<fs::path> &all_files,
+                                     const std::vector<size_t> &file_indices,
+                                     Timers &timers)
+    : env(env), all_files(all_files), file_indices(file_indices)
+{
+  const auto &comm = El::mpi::COMM_WORLD;
+  const size_t num_files = file_indices.size();
+
+  std::vector<size_t> file_sizes;
+  file_sizes.reserve(num_files);
+  for(const auto file_index : file_indices)
+    {
+      const auto &path = all_files.at(file_index);
+      if(!PMP_File_Index::is_supported(path))
+        RUNTIME_ERROR("Unsupported PMP file format: ", path,
+                      ". Expected .json, .m, .xml or .pmpb extension.");
+      file_sizes.push_back(fs::file_size(path));
+    }
+  file_owners = assign_to_ranks(file_sizes, comm.Size());
+
+  // Index files
+
+  indices.resize(num_files);
+  {
+    Scoped_Timer index_timer(timers, "index");
+    std::vector<size_t> headers(num_files * header_size, 0);
+    for(size_t i = 0; i < num_files; ++i)
+      {
+        if(file_owners.at(i) != comm.Rank())
+          continue;
+        const auto &path = all_files.at(file_indices.at(i));
+        const Memory_Mapped_File file(path);
+        indices.at(i)
+          = PMP_File_Index::create(path, file.data(), file.data() + file.size());
+        write_header(indices.at(i), headers.data() + i * header_size);
+      }
+    El::mpi::AllReduce(headers.data(), headers.size(), El::mpi::SUM, comm);
+
+    // Offsets of matrix ranges for each file
+    std::vector<size_t> offsets(num_files + 1, 0);
+    for(size_t i = 0; i < num_files; ++i)
+      offsets.at(i + 1) = offsets.at(i) + headers.at(i * header_size);
+
+    std::vector<size_t> ranges(2 * offsets.back(), 0);
+    for(size_t i = 0; i < num_files; ++i)
+      {
+        if(file_owners.at(i) != comm.Rank())
+          continue;
+        for(size_t k = 0; k < indices.at(i).matrices.size(); ++k)
+          {
+            const auto &range = indices.at(i).matrices.at(k);
+            ranges.at(2 * (offsets.at(i) + k)) = range.begin;
+            ranges.at(2 * (offsets.at(i) + k) + 1) = range.end;
+          }
+      }
+    El::mpi::AllReduce(ranges.data(), ranges.size(), El::mpi::SUM, comm);
+
+    for(size_t i = 0; i < num_files; ++i)
+      {
+        indices.at(i) = read_header(headers.data() + i * header_size);
+        for(size_t k = 0; k < indices.at(i).matrices.size(); ++k)
+          {
+            indices.at(i).matrices.at(k)
+              = Byte_Range{ranges.at(2 * (offsets.at(i) + k)),
+                           ranges.at(2 * (offsets.at(i) + k) + 1)};
+          }
+      }
+  }
+
+  // Distribute matrices among ranks
+
+  std::vector<std::pair<size_t, size_t>> all_matrices;
+  std::vector<size_t> matrix_costs;
+  for(size_t i = 0; i < num_files; ++i)
+    for(size_t k = 0; k < indices.at(i).matrices.size(); ++k)
+      {
+        all_matrices.emplace_back(i, k);
+        matrix_costs.push_back(indices.at(i).matrices.at(k).size());
+      }
+  const auto matrix_owners = assign_to_ranks(matrix_costs, comm.Size());
+
+  my_matrices.resize(num_files);
+  for(size_t m = 0; m < all_matrices.size(); ++m)
+    {
+      if(matrix_owners.at(m) == comm.Rank())
+        {
+          const auto &[i, k] = all_matrices.at(m);
+          my_matrices.at(i).push_back(k);
+        }
+    }
+}
+
+std::vector<size_t> Indexed_PMP_Files::num_matrices() const
+{
+  std::vector<size_t> result;
+  result.reserve(indices.size());
+  for(const auto &index : indices)
+    result.push_back(index.matrices.size());
+  return result;
+}
+
+std::map<size_t, PMP_File_Parse_Result>
+Indexed_PMP_Files::parse_vectors(Timers &timers) const
+{
+  Scoped_Timer parse_timer(timers, "parse_vectors");
+
+  const size_t num_files = file_indices.size();
+  std::map<size_t, PMP_File_Parse_Result> parse_results;
+  std::vector<bool> should_read(num_files, false);
+  for(size_t i = 0; i < num_files; ++i)
+    {
+      if(file_owners.at(i) != El::mpi::Rank())
+        continue;
+      const auto &index = indices.at(i);
+      auto &result = parse_results[file_indices.at(i)];
+      result.num_matrices = index.matrices.size();
+      should_read.at(i)
+        = index.objective.has_value() || index.normalization.has_value();
+    }
+
+  for_each_file(
+    should_read,
+    [&](const size_t i, const char *data) {
+      const auto &path = all_files.at(file_indices.at(i));
+      const auto &index = indices.at(i);
+      auto &result = parse_results.at(file_indices.at(i));
+      try
+        {
+          if(index.objective.has_value())
+            result.objective
+              = parse_vector_range(path, data, index.objective.value());
+          if(index.normalization.has_value())
+            result.normalization
+              = parse_vector_range(path, data, index.normalization.value());
+        }
+      catch(std::exception &e)
+        {
+          RUNTIME_ERROR("Error when parsing ", path, ": ", e.what());
+        }
+    },
+    timers);
+
+  for(const auto &[file_index, result] : parse_results)
+    {
+      try
+        {
+          PMP_File_Parse_Result::validate(result);
+        }
+      catch(std::exception &e)
+        {
+          RUNTIME_ERROR("Error when parsing ", all_files.at(file_index), ": ",
+                        e.what());
+        }
+    }
+  return parse_results;
+}
+
+void Indexed_PMP_Files::parse_matrices(
+  const std::function<void(size_t file_index, size_t index_in_file,
+                           Polynomial_Vector_Matrix &&matrix)> &process_matrix,
+  Timers &timers) const
+{
+  Scoped_Timer parse_timer(timers, "parse_matrices");
+
+  std::vector<bool> should_read(file_indices.size());
+  for(size_t i = 0; i < file_indices.size(); ++i)
+    should_read.at(i) = !my_matrices.at(i).empty();
+
+  for_each_file(
+    should_read,
+    [&](const size_t i, const char *data) {
+      const auto &path = all_files.at(file_indices.at(i));
+      for(const auto k : my_matrices.at(i))
+        {
+          std::optional<Polynomial_Vector_Matrix> matrix;
+          try
+            {
+              matrix.emplace(
+                parse_matrix_range(path, data, indices.at(i).matrices.at(k)));
+            }
+          catch(std::exception &e)
+            {
+              RUNTIME_ERROR("Error when parsing ", path, ": ", e.what());
+            }
+          // NB: process_matrix() can release the matrix
+          process_matrix(file_indices.at(i), k, std::move(matrix.value()));
+        }
+    },
+    timers);
+}
+
+void Indexed_PMP_Files::for_each_file(
+  const std::vector<bool> &should_read,
+  const std::function<void(size_t i, const char *data)> &process_file,
+  Timers &timers) const
+{
+  const size_t num_files = file_indices.size();
+  ASSERT_EQUAL(should_read.size(), num_files);
+
+  // Number of ranks on the current node that need each file
+  std::vector<size_t> num_node_readers(num_files, 0);
+  for(size_t i = 0; i < num_files; ++i)
+    {
+      if(should_read.at(i))
+        num_node_readers.at(i) = 1;
+    }
+  El::mpi::AllReduce(num_node_readers.data(), num_node_readers.size(),
+                     El::mpi::SUM, env.comm_shared_mem);
+
+  for(size_t i = 0; i < num_files; ++i)
+    {
+      if(num_node_readers.at(i) == 0)
+        continue;
+
+      const auto &path = all_files.at(file_indices.at(i));
+      // NB: Shared_File_Buffer is created by all ranks on the node,
+      // including those that do not parse anything from the file.
+      std::optional<Shared_File_Buffer> shared_buffer;
+      std::optional<Memory_Mapped_File> mapped_file;
+      const char *data = nullptr;
+      if(num_node_readers.at(i) > 1)
+        {
+          Scoped_Timer read_timer(timers, "read_shared");
+          shared_buffer.emplace(env.comm_shared_mem, path);
+          data = shared_buffer->data();
+        }
+      else if(should_read.at(i))
+        {
+          mapped_file.emplace(path);
+          data = mapped_file->data();
+        }
+      if(!should_read.at(i))
+        continue;
+
+      process_file(i, data);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+// Byte offsets [begin, end) of an element inside a PMP file
+struct Byte_Range
+{
+  size_t begin = 0;
+  size_t end = 0;
+
+  [[nodiscard]] size_t size() const { return end - begin; }
+};
+
+// Positions of objective, normalization and PositiveMatrixWithPrefactor
+// elements inside a PMP file.
+// Created by a fast structural scan (no numbers are parsed)
+// or read from the block index of a binary PMP file,
+// it allows different processes to parse different matrices
+// without reading through the whole file.
+struct PMP_File_Index
+{
+  std::optional<Byte_Range> objective;
+  std::optional<Byte_Range> normalization;
+  std::vector<Byte_Range> matrices;
+
+  // .json, .m, .xml and .pmpb files can be indexed
+  static bool is_supported(const std::filesystem::path &input_path);
+  static PMP_File_Index create(const std::filesystem::path &input_path,
+                               const char *begin, const char *end);
+};
@@ -0,0 +1,38 @@
+#include "pmp_read/PMP_File_Index.hxx"
+
+#include "pmp_read/Binary_PMP_Format.hxx"
+#include "sdpb_util/assert.hxx"
+
+PMP_File_Index index_json(const char *begin, const char *end);
+PMP_File_Index index_mathematica(const char *begin, const char *end);
+PMP_File_Index index_xml(const char *begin, const char *end);
+
+bool PMP_File_Index::is_supported(const std::filesystem::path &input_path)
+{
+  const auto extension = input_path.extension();
+  return extension == ".json" || extension == ".m" || extension == ".xml"
+         || extension == Binary_PMP_Format::extension;
+}
+
+PMP_File_Index
+PMP_File_Index::create(const std::filesystem::path &input_path,
+                       const char *begin, const char *end)
+{
+  try
+    {
+      if(input_path.extension() == ".json")
+        return index_json(begin, end);
+      if(input_path.extension() == ".m")
+        return index_mathematica(begin, end);
+      if(input_path.extension() == ".xml")
+        return index_xml(begin, end);
+      if(input_path.extension() == Binary_PMP_Format::extension)
+        return Binary_PMP_Format::read_index(begin, end);
+      RUNTIME_ERROR(
+        "Cannot index file, expected .json, .m, .xml or .pmpb extension.");
+    }
+  catch(std::exception &e)
+    {
+      RUNTIME_ERROR("Error when indexing ", input_path, ": ", e.what());
+    }
+}
@@ -4,7 +4,7 @@
 
 #include <El.hpp>
 
-#include <filesystem>
+#include <map>
 #include <vector>
 
 struct PMP_File_Parse_Result
@@ -18,7 +18,7 @@ struct PMP_File_Parse_Result
   // Total number of PMWP matrices in file
   size_t num_matrices = 0;
   // If file is read by several processes,
-  // each process saves only some matrices, according to should_parse_matrix()
+  // each process saves only the matrices assigned to it
   // parsed_matrices is a map: index -> matrix,
   // where 0 <= index < num_matrices
   std::map<size_t, Polynomial_Vector_Matrix> parsed_matrices;
@@ -27,11 +27,6 @@ struct PMP_File_Parse_Result
 
   static void validate(const PMP_File_Parse_Result &result);
 
-  static PMP_File_Parse_Result
-  read(const std::filesystem::path &input_path, bool should_parse_objective,
-       bool should_parse_normalization,
-       const std::function<bool(size_t matrix_index)> &should_parse_matrix);
-
   // Allow moving and prevent accidential copying
 
   PMP_File_Parse_Result(const PMP_File_Parse_Result &other) = delete;
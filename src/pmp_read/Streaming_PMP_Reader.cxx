@@ -0,0 +1,77 @@
+#include "Streaming_PMP_Reader.hxx"
+
+#include "pmp_read.hxx"
+#include "pmp/convert/Prefactor_Cache.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <numeric>
+
+namespace fs = std::filesystem;
+
+Polynomial_Matrix_Program create_polynomial_matrix_program(
+  const std::vector<fs::path> &all_files,
+  const std::vector<size_t> &num_matrices_per_file,
+  std::map<size_t, PMP_File_Parse_Result> &parse_results, Timers &timers);
+
+namespace
+{
+  std::vector<size_t> all_indices(const std::vector<fs::path> &files)
+  {
+    std::vector<size_t> result(files.size());
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+}
+
+Streaming_PMP_Reader::Streaming_PMP_Reader(const Environment &env,
+                                           const fs::path &input_file,
+                                           Timers &timers)
+    : all_files(collect_files_expanding_nsv(input_file)),
+      indexed_files(env, all_files, all_indices(all_files), timers)
+{
+  Scoped_Timer timer(timers, "read_pmp_header");
+
+  // Files are indexed in the same order as all_files
+  const auto num_matrices_per_file = indexed_files.num_matrices();
+  matrix_index_offset_per_file.resize(num_matrices_per_file.size());
+  std::exclusive_scan(num_matrices_per_file.begin(),
+                      num_matrices_per_file.end(),
+                      matrix_index_offset_per_file.begin(), size_t(0));
+
+  auto parse_results = indexed_files.parse_vectors(timers);
+  pmp_without_matrices = create_polynomial_matrix_program(
+    all_files, num_matrices_per_file, parse_results, timers);
+  ASSERT(pmp_without_matrices->matrices.empty());
+}
+
+const Polynomial_Matrix_Program &Streaming_PMP_Reader::pmp() const
+{
+  return pmp_without_matrices.value();
+}
+
+void Streaming_PMP_Reader::for_each_matrix(
+  const std::function<void(size_t global_index,
+                           Polynomial_Vector_Matrix &&matrix)> &process_matrix,
+  Timers &timers) const
+{
+  Scoped_Timer timer(timers, "for_each_matrix");
+  const auto cache_stats_before = Prefactor_Cache::stats();
+
+  indexed_files.parse_matrices(
+    [&](const size_t file_index, const size_t index_in_file,
+        Polynomial_Vector_Matrix &&matrix) {
+      const size_t global_index
+        = matrix_index_offset_per_file.at(file_index) + index_in_file;
+      ASSERT(global_index < pmp().num_matrices, DEBUG_STRING(global_index),
+             DEBUG_STRING(pmp().num_matrices));
+      process_matrix(global_index, std::move(matrix));
+    },
+    timers);
+
+  // Default bilinear bases etc. computed or reused during parsing
+  const auto cache_stats = Prefactor_Cache::stats();
+  timers.add_counter("prefactor_cache.hits",
+                     cache_stats.hits - cache_stats_before.hits);
+  timers.add_counter("prefactor_cache.misses",
+                     cache_stats.misses - cache_stats_before.misses);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Indexed_PMP_Files.hxx"
+#include "pmp/Polynomial_Matrix_Program.hxx"
+#include "sdpb_util/Timers/Timers.hxx"
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+// Read Polynomial Matrix Program matrix by matrix.
+//
+// The constructor indexes input files and reads objective and normalization.
+// for_each_matrix() parses matrices owned by the current rank one at a time,
+// so that only a single matrix has to be kept in memory,
+// in contrast to read_polynomial_matrix_program().
+//
+// All input files should be supported by PMP_File_Index.
+// Both constructor and for_each_matrix() are collective operations.
+class Streaming_PMP_Reader : boost::noncopyable
+{
+public:
+  Streaming_PMP_Reader(const Environment &env,
+                       const std::filesystem::path &input_file,
+                       Timers &timers);
+
+  // Objective, normalization and the total number of matrices.
+  // NB: pmp().matrices is empty, use for_each_matrix() instead.
+  [[nodiscard]] const Polynomial_Matrix_Program &pmp() const;
+
+  // Call process_matrix(global_index, matrix) for each matrix
+  // owned by the current rank.
+  // The matrix can be moved or released after processing.
+  void for_each_matrix(
+    const std::function<void(size_t global_index,
+                             Polynomial_Vector_Matrix &&matrix)>
+      &process_matrix,
+    Timers &timers) const;
+
+private:
+  std::vector<std::filesystem::path> all_files;
+  Indexed_PMP_Files indexed_files;
+  // Total number of matrices in previous files
+  std::vector<size_t> matrix_index_offset_per_file;
+  std::optional<Polynomial_Matrix_Program> pmp_without_matrices;
+};
@@ -0,0 +1,32 @@
+#include "Indexed_PMP_Files.hxx"
+#include "PMP_File_Parse_Result.hxx"
+
+namespace fs = std::filesystem;
+
+// Parse .json, .m, .xml and .pmpb files using PMP_File_Index,
+// see Indexed_PMP_Files.
+//
+// Returns parse results for the files touched by the current rank,
+// with file indices as keys.
+std::map<size_t, PMP_File_Parse_Result>
+parse_indexed_files(const Environment &env,
+                    const std::vector<fs::path> &all_files,
+                    const std::vector<size_t> &file_indices, Timers &timers)
+{
+  const Indexed_PMP_Files indexed_files(env, all_files, file_indices, timers);
+  const auto num_matrices = indexed_files.num_matrices();
+  std::map<size_t, size_t> num_matrices_per_file;
+  for(size_t i = 0; i < file_indices.size(); ++i)
+    num_matrices_per_file.emplace(file_indices.at(i), num_matrices.at(i));
+
+  auto parse_results = indexed_files.parse_vectors(timers);
+  indexed_files.parse_matrices(
+    [&](const size_t file_index, const size_t index_in_file,
+        Polynomial_Vector_Matrix &&matrix) {
+      auto &result = parse_results[file_index];
+      result.num_matrices = num_matrices_per_file.at(file_index);
+      result.parsed_matrices.emplace(index_in_file, std::move(matrix));
+    },
+    timers);
+  return parse_results;
+}
@@ -0,0 +1,168 @@
+#include "pmp_read/PMP_File_Index.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <string_view>
+
+// Find boundaries of the top-level elements in a JSON PMP file:
+//
+// {
+//   "objective": [...],
+//   "normalization": [...],
+//   "PositiveMatrixWithPrefactorArray": [{...}, {...}, ...]
+// }
+//
+// We only track strings and brackets, numbers are not parsed.
+// Syntax errors inside elements are reported later by the JSON parser.
+
+namespace
+{
+  bool is_whitespace(const char c)
+  {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+  }
+
+  const char *skip_whitespace(const char *p, const char *end)
+  {
+    while(p != end && is_whitespace(*p))
+      ++p;
+    return p;
+  }
+
+  void expect(const char *p, const char *begin, const char *end,
+              const char expected)
+  {
+    if(p == end)
+      RUNTIME_ERROR("Expected '", expected, "', found end of file");
+    if(*p != expected)
+      RUNTIME_ERROR("Expected '", expected, "', found '", *p,
+                    "' at offset=", p - begin);
+  }
+
+  // p points to the opening quote, returns position after the closing quote
+  const char *skip_string(const char *p, const char *end)
+  {
+    for(++p; p != end; ++p)
+      {
+        if(*p == '\\')
+          {
+            ++p;
+            if(p == end)
+              break;
+          }
+        else if(*p == '"')
+          return p + 1;
+      }
+    RUNTIME_ERROR("Unterminated string");
+  }
+
+  // Returns position after JSON value starting at p
+  const char *skip_value(const char *p, const char *end)
+  {
+    if(p == end)
+      RUNTIME_ERROR("Expected value, found end of file");
+    if(*p == '"')
+      return skip_string(p, end);
+    if(*p == '{' || *p == '[')
+      {
+        size_t depth = 0;
+        while(p != end)
+          {
+            if(*p == '"')
+              {
+                p = skip_string(p, end);
+                continue;
+              }
+            if(*p == '{' || *p == '[')
+              {
+                ++depth;
+              }
+            else if(*p == '}' || *p == ']')
+              {
+                --depth;
+                if(depth == 0)
+                  return p + 1;
+              }
+            ++p;
+          }
+        RUNTIME_ERROR("Unterminated object or array");
+      }
+    // number, true, false or null
+    while(p != end && *p != ',' && *p != '}' && *p != ']'
+          && !is_whitespace(*p))
+      ++p;
+    return p;
+  }
+}
+
+PMP_File_Index index_json(const char *begin, const char *end)
+{
+  PMP_File_Index result;
+  auto range = [begin](const char *first, const char *last) {
+    return Byte_Range{static_cast<size_t>(first - begin),
+                      static_cast<size_t>(last - begin)};
+  };
+
+  auto p = skip_whitespace(begin, end);
+  expect(p, begin, end, '{');
+  p = skip_whitespace(p + 1, end);
+  if(p != end && *p == '}')
+    return result;
+
+  while(true)
+    {
+      expect(p, begin, end, '"');
+      const auto key_end = skip_string(p, end);
+      const std::string_view key(p + 1, key_end - p - 2);
+      p = skip_whitespace(key_end, end);
+      expect(p, begin, end, ':');
+      p = skip_whitespace(p + 1, end);
+
+      if(key == "PositiveMatrixWithPrefactorArray")
+        {
+          expect(p, begin, end, '[');
+          p = skip_whitespace(p + 1, end);
+          if(p != end && *p == ']')
+            {
+              ++p;
+            }
+          else
+            {
+              while(true)
+                {
+                  const auto matrix_end = skip_value(p, end);
+                  result.matrices.push_back(range(p, matrix_end));
+                  p = skip_whitespace(matrix_end, end);
+                  if(p != end && *p == ',')
+                    {
+                      p = skip_whitespace(p + 1, end);
+                      continue;
+                    }
+                  expect(p, begin, end, ']');
+                  ++p;
+                  break;
+                }
+            }
+        }
+      else
+        {
+          const auto value_end = skip_value(p, end);
+          if(key == "objective")
+            result.objective = range(p, value_end);
+          else if(key == "normalization")
+            result.normalization = range(p, value_end);
+          else
+            RUNTIME_ERROR("Unexpected key=", key);
+          p = value_end;
+        }
+
+      p = skip_whitespace(p, end);
+      if(p != end && *p == ',')
+        {
+          p = skip_whitespace(p + 1, end);
+          continue;
+        }
+      expect(p, begin, end, '}');
+      break;
+    }
+  return result;
+}
@@ -0,0 +1,47 @@
+#include "Json_Positive_Matrix_With_Prefactor_Parser.hxx"
+#include "sdpb_util/json/Json_Float_Parser.hxx"
+
+#include <rapidjson/memorystream.h>
+#include <rapidjson/error/en.h>
+
+#include <optional>
+
+// Parse a single JSON element from [begin, end),
+// e.g. a matrix found by PMP_File_Index.
+
+namespace
+{
+  template <class TParser>
+  typename TParser::value_type
+  parse_json_element(const char *begin, const char *end)
+  {
+    using value_type = typename TParser::value_type;
+    std::optional<value_type> result;
+    TParser parser(
+      false, [&result](value_type &&value) { result = std::move(value); },
+      [] {});
+
+    rapidjson::MemoryStream stream(begin, end - begin);
+    rapidjson::Reader reader;
+    const auto res = reader.Parse(stream, parser);
+    if(res.IsError())
+      {
+        RUNTIME_ERROR("offset=", res.Offset(), ": error: ",
+                      rapidjson::GetParseError_En(res.Code()));
+      }
+    ASSERT(result.has_value(), "Nothing was parsed");
+    return std::move(result).value();
+  }
+}
+
+Polynomial_Vector_Matrix parse_json_matrix(const char *begin, const char *end)
+{
+  return parse_json_element<Json_Positive_Matrix_With_Prefactor_Parser>(begin,
+                                                                        end);
+}
+
+std::vector<El::BigFloat> parse_json_vector(const char *begin, const char *end)
+{
+  return parse_json_element<Json_Float_Vector_Parser<El::BigFloat>>(begin,
+                                                                    end);
+}
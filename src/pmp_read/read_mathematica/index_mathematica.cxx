@@ -0,0 +1,94 @@
+#include "pmp_read/PMP_File_Index.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+// Find boundaries of the top-level elements in a Mathematica PMP file:
+//
+// SDP[{objective...}, {normalization...},
+//     {PositiveMatrixWithPrefactor[...], PositiveMatrixWithPrefactor[...]}]
+//
+// We split the arguments by commas outside of any brackets,
+// numbers are not parsed.
+
+namespace
+{
+  bool is_open(const char c) { return c == '[' || c == '{' || c == '('; }
+  bool is_close(const char c) { return c == ']' || c == '}' || c == ')'; }
+
+  bool is_blank(const char *begin, const char *end)
+  {
+    return std::all_of(begin, end, [](const char c) {
+      return std::isspace(c) || c == '\\';
+    });
+  }
+
+  // Split [begin, end) by top-level commas,
+  // until the closing bracket at depth 0.
+  // Returns position of the closing bracket.
+  const char *split_arguments(const char *begin, const char *end,
+                              std::vector<std::pair<const char *, const char *>>
+                                &arguments)
+  {
+    size_t depth = 0;
+    auto argument_begin = begin;
+    for(auto p = begin; p != end; ++p)
+      {
+        if(is_open(*p))
+          {
+            ++depth;
+          }
+        else if(is_close(*p))
+          {
+            if(depth == 0)
+              {
+                if(!arguments.empty() || !is_blank(argument_begin, p))
+                  arguments.emplace_back(argument_begin, p);
+                return p;
+              }
+            --depth;
+          }
+        else if(*p == ',' && depth == 0)
+          {
+            arguments.emplace_back(argument_begin, p);
+            argument_begin = p + 1;
+          }
+      }
+    RUNTIME_ERROR("Missing closing bracket");
+  }
+}
+
+PMP_File_Index index_mathematica(const char *begin, const char *end)
+{
+  PMP_File_Index result;
+  auto range = [begin](const std::pair<const char *, const char *> &element) {
+    return Byte_Range{static_cast<size_t>(element.first - begin),
+                      static_cast<size_t>(element.second - begin)};
+  };
+
+  const std::string SDP_literal("SDP[");
+  const auto SDP_start
+    = std::search(begin, end, SDP_literal.begin(), SDP_literal.end());
+  if(SDP_start == end)
+    RUNTIME_ERROR("Could not find 'SDP['");
+
+  std::vector<std::pair<const char *, const char *>> arguments;
+  split_arguments(SDP_start + SDP_literal.size(), end, arguments);
+  ASSERT_EQUAL(arguments.size(), 3,
+               "Expected SDP[objective, normalization, matrices]");
+
+  result.objective = range(arguments.at(0));
+  result.normalization = range(arguments.at(1));
+
+  const auto &[matrices_begin, matrices_end] = arguments.at(2);
+  const auto open_brace = std::find(matrices_begin, matrices_end, '{');
+  if(open_brace == matrices_end)
+    RUNTIME_ERROR("Could not find '{' to start array of matrices");
+  std::vector<std::pair<const char *, const char *>> matrices;
+  split_arguments(open_brace + 1, matrices_end, matrices);
+  for(const auto &matrix : matrices)
+    result.matrices.push_back(range(matrix));
+  return result;
+}
@@ -1,32 +1,56 @@
 #include "is_valid_char.hxx"
+#include "sdpb_util/parse_BigFloat.hxx"
+
+#include <El.hpp>
 
 #include <algorithm>
 #include <vector>
 #include <string>
 
+namespace
+{
+  // Convert Mathematica number to decimal format,
+  // e.g. "1.5`30.*^-10" -> "1.5e-10"
+  void clean_number(const char *begin, const char *end,
+                    std::string &cleaned_string)
+  {
+    cleaned_string.clear();
+    auto c(begin);
+    for(; c != end && *c != '`'; ++c)
+      {
+        if(is_valid_char(*c))
+          {
+            cleaned_string.push_back(*c);
+          }
+      }
+    auto carat(std::find(c, end, '^'));
+    if(carat != end)
+      {
+        cleaned_string.push_back('e');
+        for(auto c(std::next(carat)); c != end; ++c)
+          {
+            if(is_valid_char(*c))
+              {
+                cleaned_string.push_back(*c);
+              }
+          }
+      }
+  }
+}
+
 std::string parse_number(const char *begin, const char *end)
 {
   std::string cleaned_string;
   cleaned_string.reserve(end - begin);
-  auto c(begin);
-  for(; c != end && *c != '`'; ++c)
-    {
-      if(is_valid_char(*c))
-        {
-          cleaned_string.push_back(*c);
-        }
-    }
-  auto carat(std::find(c, end, '^'));
-  if(carat != end)
-    {
-      cleaned_string.push_back('e');
-      for(auto c(std::next(carat)); c != end; ++c)
-        {
-          if(is_valid_char(*c))
-            {
-              cleaned_string.push_back(*c);
-            }
-        }
-    }
+  clean_number(begin, end, cleaned_string);
   return cleaned_string;
 }
+
+void parse_number(const char *begin, const char *end, El::BigFloat &result)
+{
+  // Reuse buffer to avoid allocation for each number
+  thread_local std::string cleaned_string;
+  clean_number(begin, end, cleaned_string);
+  parse_BigFloat(cleaned_string.data(),
+                 cleaned_string.data() + cleaned_string.size(), result);
+}
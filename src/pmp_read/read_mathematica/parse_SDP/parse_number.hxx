@@ -1,6 +1,9 @@
 #pragma once
 
+#include <El.hpp>
+
 #include <string>
 #include <vector>
 
 std::string parse_number(const char *begin, const char *end);
+void parse_number(const char *begin, const char *end, El::BigFloat &result);
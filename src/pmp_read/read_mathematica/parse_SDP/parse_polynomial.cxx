@@ -1,6 +1,7 @@
 #include "is_valid_char.hxx"
 #include "pmp/Polynomial.hxx"
 #include "sdpb_util/assert.hxx"
+#include "sdpb_util/parse_BigFloat.hxx"
 
 #include <algorithm>
 #include <iterator>
@@ -8,6 +9,14 @@
 
 using namespace std::literals;
 
+namespace
+{
+  void parse_coefficient(const std::string &number, El::BigFloat &result)
+  {
+    parse_BigFloat(number.data(), number.data() + number.size(), result);
+  }
+}
+
 inline void check_iterator(const char character, const char *begin,
                            const char *iterator, const char *end)
 {
@@ -114,8 +123,8 @@ parse_polynomial(const char *begin, const char *end, Polynomial &polynomial)
             {
               polynomial.coefficients.resize(degree + 1);
             }
-          polynomial.coefficients.at(degree)
-            = El::BigFloat(mantissa + exponent);
+          mantissa += exponent;
+          parse_coefficient(mantissa, polynomial.coefficients.at(degree));
           mantissa.clear();
         }
       else if(!mantissa.empty() && (*c == '-' || *c == '+' || c == delimiter))
@@ -124,7 +133,7 @@ parse_polynomial(const char *begin, const char *end, Polynomial &polynomial)
             {
               polynomial.coefficients.resize(1);
             }
-          polynomial.coefficients.at(0) = El::BigFloat(mantissa);
+          parse_coefficient(mantissa, polynomial.coefficients.at(0));
           mantissa.clear();
         }
       if(c != delimiter && is_valid_char(*c) && *c != '+')
@@ -138,7 +147,7 @@ parse_polynomial(const char *begin, const char *end, Polynomial &polynomial)
         {
           polynomial.coefficients.resize(1);
         }
-      polynomial.coefficients.at(0) = El::BigFloat(mantissa);
+      parse_coefficient(mantissa, polynomial.coefficients.at(0));
     }
   return delimiter;
 }
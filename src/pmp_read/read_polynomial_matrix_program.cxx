@@ -1,54 +1,24 @@
 #include "PMP_File_Parse_Result.hxx"
 #include "pmp_read.hxx"
-#include "sdp_solve/Block_Info.hxx"
+#include "pmp/convert/Prefactor_Cache.hxx"
 #include "sdpb_util/assert.hxx"
-#include "sdpb_util/block_mapping/compute_block_grid_mapping.hxx"
-#include "sdpb_util/block_mapping/create_mpi_block_mapping_groups.hxx"
 
-namespace fs = std::filesystem;
+#include <numeric>
 
-namespace
-{
-  struct Mapping
-  {
-    MPI_Comm_Wrapper mpi_comm;
-    MPI_Group_Wrapper mpi_group;
-    std::vector<size_t> file_indices;
-
-    Mapping(const Environment &env, const std::vector<fs::path> &input_files)
-    {
-      const size_t num_files = input_files.size();
+namespace fs = std::filesystem;
 
-      // Distribute files among processes according to file size.
-      std::vector<Block_Cost> file_costs;
-      file_costs.reserve(num_files);
-      for(size_t i = 0; i < num_files; ++i)
-        {
-          file_costs.emplace_back(fs::file_size(input_files.at(i)), i);
-        }
+std::map<size_t, PMP_File_Parse_Result>
+parse_indexed_files(const Environment &env,
+                    const std::vector<fs::path> &all_files,
+                    const std::vector<size_t> &file_indices, Timers &timers);
 
-      const auto node_comm = env.comm_shared_mem;
-      ASSERT_EQUAL(node_comm.Size() * env.num_nodes(), El::mpi::Size(),
-                   DEBUG_STRING(node_comm.Size()),
-                   DEBUG_STRING(env.num_nodes()),
-                   "Each node should have the same number of processes.");
-      // Reading file from different nodes may be slower,
-      // so we distribute files across nodes and processes
-      // in such a way that each file is assigned to a single node.
-      // NB: in case of a single input file, only first node will process it.
-      // It can be slower than reading it from all ranks.
-      // However, reading the same file from too many ranks looks non-optimal too.
-      // In that case user should split input to several files.
-      const auto mapping = compute_block_grid_mapping(
-        node_comm.Size(), env.num_nodes(), file_costs);
-      ASSERT_EQUAL(mapping.size(), env.num_nodes());
-
-      create_mpi_block_mapping_groups(mapping, node_comm, env.node_index(),
-                                      mpi_group.value, mpi_comm.value,
-                                      file_indices);
-    }
-  };
+Polynomial_Matrix_Program create_polynomial_matrix_program(
+  const std::vector<fs::path> &all_files,
+  const std::vector<size_t> &num_matrices_per_file,
+  std::map<size_t, PMP_File_Parse_Result> &parse_results, Timers &timers);
 
+namespace
+{
   // Broadcast vector from the first rank for which vector is not empty.
   template <class T>
   void synchronize_vector(std::vector<T> &vec,
@@ -79,15 +49,9 @@ read_polynomial_matrix_program(const Environment &env,
 
 // Read Polynomal Matrix Program in one of the supported formats.
 //
-// File reading is parallelized as follows:
-// 1. Input files are distributed among (groups of) processes
-//    via compute_block_grid_mapping().
-// 2. Within each group, matrices from input files are distributed
-//    among processes in a round-robin way.
-//    Each process reads its matrices and skips the rest.
-// TODO: since IO is often a bottleneck, we can reduce it:
-//   root of each group copies file content to a shared memory window,
-//   and other processes read it.
+// All input files (.json, .m, .xml and .pmpb) are indexed,
+// i.e. scanned for matrix boundaries, and matrices from all files
+// are distributed among all processes, see parse_indexed_files().
 Polynomial_Matrix_Program
 read_polynomial_matrix_program(const Environment &env,
                                const std::vector<fs::path> &input_files,
@@ -95,18 +59,6 @@ read_polynomial_matrix_program(const Environment &env,
 {
   Scoped_Timer timer(timers, "read_pmp");
 
-  std::vector<El::BigFloat> objective;
-  std::vector<El::BigFloat> normalization;
-  // Total number of PVM matrices
-  size_t num_matrices = 0;
-  // In case of several processes,
-  // each process owns only some matrices.
-  std::vector<Polynomial_Vector_Matrix> matrices;
-  // global index of matrices[i], lies in [0..num_matrices)
-  std::vector<size_t> matrix_index_local_to_global;
-  // input path for each of the matrices
-  std::vector<std::filesystem::path> block_paths;
-
   const auto all_files = collect_files_expanding_nsv(input_files);
   const size_t num_files = all_files.size();
 
@@ -115,73 +67,67 @@ read_polynomial_matrix_program(const Environment &env,
   std::map<size_t, PMP_File_Parse_Result> parse_results;
   {
     Scoped_Timer parse_timer(timers, "parse");
-    // Determine which processes will parse which files
-    const Mapping mapping(env, all_files);
-    // Cumulative number of matrices in all files parsed
-    // by the current group of processes
-    size_t num_matrices_in_group = 0;
-    for(const auto file_index : mapping.file_indices)
-      {
-        const auto &file = all_files.at(file_index);
-        Scoped_Timer parse_file_timer(timers,
-                                      "file_" + std::to_string(file_index)
-                                        + "=" + file.filename().string());
-        // Simple round-robin for matrices across files in a given group
-        auto should_parse_matrix
-          = [&mapping, &num_matrices_in_group](size_t matrix_index_in_file) {
-              return (num_matrices_in_group + matrix_index_in_file)
-                       % mapping.mpi_comm.value.Size()
-                     == mapping.mpi_comm.value.Rank();
-            };
-        // TODO set also bool should_parse_objective and should_parse_normalization
-        // to (mapping.mpi_comm.value.Rank() == 0)
-
-        bool should_parse_objective = mapping.mpi_comm.value.Rank() == 0;
-        bool should_parse_normalization = mapping.mpi_comm.value.Rank() == 0;
-
-        auto file_parse_result = PMP_File_Parse_Result::read(
-          file, should_parse_objective, should_parse_normalization,
-          should_parse_matrix);
-
-        num_matrices_in_group += file_parse_result.num_matrices;
-
-        {
-          auto [it, inserted]
-            = parse_results.insert({file_index, std::move(file_parse_result)});
-          ASSERT(inserted, "Duplicate parsing result for ",
-                 all_files.at(file_index));
-        }
-      }
+    const auto cache_stats_before = Prefactor_Cache::stats();
+
+    std::vector<size_t> file_indices(num_files);
+    std::iota(file_indices.begin(), file_indices.end(), 0);
+    parse_results = parse_indexed_files(env, all_files, file_indices, timers);
+
+    // Default bilinear bases etc. computed or reused during parsing
+    const auto cache_stats = Prefactor_Cache::stats();
+    timers.add_counter("prefactor_cache.hits",
+                       cache_stats.hits - cache_stats_before.hits);
+    timers.add_counter("prefactor_cache.misses",
+                       cache_stats.misses - cache_stats_before.misses);
   }
 
-  // Total number of matrices in previous files.
-  // Used to calculate matrix_index_local_to_global (= index_local + offset)
-  std::vector<size_t> matrix_index_offset_per_file(num_files, 0);
-
   // Synhronize number of matrices in each file
+  std::vector<size_t> num_matrices_per_file(num_files, 0);
   {
     Scoped_Timer sync_num_matrices_timer(timers, "sync_num_matrices");
-
-    std::vector<size_t> num_matrices_per_file(num_files, 0);
     for(auto &[file_index, parse_result] : parse_results)
       {
         num_matrices_per_file.at(file_index) = parse_result.num_matrices;
       }
     El::mpi::AllReduce(num_matrices_per_file.data(), num_files, El::mpi::MAX,
                        El::mpi::COMM_WORLD);
+  }
 
-    matrix_index_offset_per_file.at(0) = 0;
-    for(size_t file_index = 1; file_index < num_files; ++file_index)
-      {
-        matrix_index_offset_per_file.at(file_index)
-          = matrix_index_offset_per_file.at(file_index - 1)
-            + num_matrices_per_file.at(file_index - 1);
-      }
+  return create_polynomial_matrix_program(all_files, num_matrices_per_file,
+                                          parse_results, timers);
+}
 
-    num_matrices
-      = std::accumulate(num_matrices_per_file.begin(),
-                        num_matrices_per_file.end(), static_cast<size_t>(0));
-  }
+// Create Polynomial_Matrix_Program from parse results of the current rank.
+// Objective and normalization are synchronized among all ranks.
+// NB: data is moved from parse_results, don't use it afterwards!
+Polynomial_Matrix_Program create_polynomial_matrix_program(
+  const std::vector<fs::path> &all_files,
+  const std::vector<size_t> &num_matrices_per_file,
+  std::map<size_t, PMP_File_Parse_Result> &parse_results, Timers &timers)
+{
+  const size_t num_files = all_files.size();
+  ASSERT_EQUAL(num_matrices_per_file.size(), num_files);
+
+  std::vector<El::BigFloat> objective;
+  std::vector<El::BigFloat> normalization;
+  // In case of several processes,
+  // each process owns only some matrices.
+  std::vector<Polynomial_Vector_Matrix> matrices;
+  // global index of matrices[i], lies in [0..num_matrices)
+  std::vector<size_t> matrix_index_local_to_global;
+  // input path for each of the matrices
+  std::vector<std::filesystem::path> block_paths;
+
+  // Total number of matrices in previous files.
+  // Used to calculate matrix_index_local_to_global (= index_local + offset)
+  std::vector<size_t> matrix_index_offset_per_file(num_files, 0);
+  std::exclusive_scan(num_matrices_per_file.begin(),
+                      num_matrices_per_file.end(),
+                      matrix_index_offset_per_file.begin(), size_t(0));
+  // Total number of PVM matrices
+  const size_t num_matrices
+    = std::accumulate(num_matrices_per_file.begin(),
+                      num_matrices_per_file.end(), static_cast<size_t>(0));
 
   // Get objective, normalization and polynomial vector matrices
   // + calculate block indices
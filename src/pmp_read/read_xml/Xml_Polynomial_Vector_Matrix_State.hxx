@@ -102,6 +102,30 @@ public:
     return result;
   }
 
+  // Move parsed elements to Polynomial_Vector_Matrix.
+  // Should be called after the end of the matrix element.
+  Polynomial_Vector_Matrix release_matrix()
+  {
+    El::Matrix<Polynomial_Vector> poly_vectors(rows, cols);
+
+    auto elt = elements_state.value.begin();
+    for(int i = 0; i < poly_vectors.Height(); ++i)
+      for(int j = 0; j < poly_vectors.Width(); ++j)
+        {
+          swap(poly_vectors(i, j), *elt++);
+        }
+
+    std::optional<Damped_Rational> prefactor = std::nullopt;
+    auto &sample_points = sample_points_state.value;
+    auto &sample_scalings = sample_scalings_state.value;
+    Polynomial_Vector bilinear_basis;
+    swap(bilinear_basis, bilinear_basis_state.value);
+
+    return Polynomial_Vector_Matrix(
+      std::move(poly_vectors), prefactor, std::move(sample_points),
+      std::move(sample_scalings), std::move(bilinear_basis));
+  }
+
   bool xml_on_characters(const xmlChar *characters, int length)
   {
     if(inside)
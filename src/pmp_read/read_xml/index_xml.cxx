@@ -0,0 +1,196 @@
+#include "pmp_read/PMP_File_Index.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+// Find boundaries of the top-level elements in an XML PMP file:
+//
+// <sdp>
+//   <objective>...</objective>
+//   <polynomialVectorMatrices>
+//     <polynomialVectorMatrix>...</polynomialVectorMatrix>
+//     ...
+//   </polynomialVectorMatrices>
+// </sdp>
+//
+// We only track tags, comments, CDATA sections and processing instructions.
+// Tag names are checked only up to the matrix level,
+// syntax errors inside elements are reported later by the XML parser.
+
+namespace
+{
+  bool is_name_end(const char c)
+  {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '/'
+           || c == '>';
+  }
+
+  // Returns position after the first occurrence of token in [p, end)
+  const char *
+  skip_past(const char *p, const char *end, const std::string_view token)
+  {
+    const std::string_view rest(p, end - p);
+    const auto pos = rest.find(token);
+    if(pos == std::string_view::npos)
+      RUNTIME_ERROR("Expected '", token, "', found end of file");
+    return p + pos + token.size();
+  }
+
+  bool starts_with(const char *p, const char *end,
+                   const std::string_view prefix)
+  {
+    return static_cast<size_t>(end - p) >= prefix.size()
+           && std::string_view(p, prefix.size()) == prefix;
+  }
+
+  // p points after '<' or '</'
+  std::string_view read_name(const char *p, const char *end)
+  {
+    const char *name_end = p;
+    while(name_end != end && !is_name_end(*name_end))
+      ++name_end;
+    if(name_end == p)
+      RUNTIME_ERROR("Empty tag name");
+    return {p, static_cast<size_t>(name_end - p)};
+  }
+
+  // p points after tag name, returns position after '>'.
+  // Attribute values may contain '>', so we skip quoted strings.
+  const char *
+  skip_tag(const char *p, const char *end, bool &is_self_closing)
+  {
+    for(; p != end; ++p)
+      {
+        if(*p == '"' || *p == '\'')
+          {
+            const char *close
+              = static_cast<const char *>(std::memchr(p + 1, *p, end - p - 1));
+            if(close == nullptr)
+              break;
+            p = close;
+          }
+        else if(*p == '>')
+          {
+            is_self_closing = *(p - 1) == '/';
+            return p + 1;
+          }
+      }
+    RUNTIME_ERROR("Unterminated tag");
+  }
+}
+
+PMP_File_Index index_xml(const char *begin, const char *end)
+{
+  PMP_File_Index result;
+
+  // Names of currently open elements
+  std::vector<std::string_view> path;
+  // Start of the current objective or matrix element
+  const char *element_begin = nullptr;
+  // Is the current element (at depth 2) an objective or a matrix
+  bool is_objective = false;
+
+  const char *p = begin;
+  while(true)
+    {
+      p = static_cast<const char *>(std::memchr(p, '<', end - p));
+      if(p == nullptr)
+        break;
+      const char *tag_begin = p;
+
+      if(starts_with(p, end, "<?"))
+        {
+          p = skip_past(p, end, "?>");
+          continue;
+        }
+      if(starts_with(p, end, "<!--"))
+        {
+          p = skip_past(p, end, "-->");
+          continue;
+        }
+      if(starts_with(p, end, "<![CDATA["))
+        {
+          p = skip_past(p, end, "]]>");
+          continue;
+        }
+      if(starts_with(p, end, "<!"))
+        {
+          // DOCTYPE without internal subset
+          const char *tag_end = skip_past(p, end, ">");
+          ASSERT(std::string_view(p, tag_end - p).find('[')
+                   == std::string_view::npos,
+                 "DOCTYPE with internal subset is not supported, offset=",
+                 p - begin);
+          p = tag_end;
+          continue;
+        }
+
+      const bool is_end_tag = starts_with(p, end, "</");
+      p += is_end_tag ? 2 : 1;
+      const auto name = read_name(p, end);
+      p += name.size();
+      bool is_self_closing = false;
+      p = skip_tag(p, end, is_self_closing);
+
+      if(!is_end_tag)
+        {
+          const size_t depth = path.size();
+          if(depth == 0)
+            {
+              ASSERT(name == "sdp", "Expected 'sdp' but found '", name,
+                     "' at offset=", tag_begin - begin);
+            }
+          else if(depth == 1)
+            {
+              ASSERT(name == "objective" || name == "polynomialVectorMatrices",
+                     "Expected 'objective' or 'polynomialVectorMatrices' "
+                     "inside 'sdp', but found '",
+                     name, "' at offset=", tag_begin - begin);
+              if(name == "objective")
+                {
+                  element_begin = tag_begin;
+                  is_objective = true;
+                }
+            }
+          else if(depth == 2 && path.at(1) == "polynomialVectorMatrices")
+            {
+              ASSERT(name == "polynomialVectorMatrix",
+                     "Expected 'polynomialVectorMatrix' inside "
+                     "'polynomialVectorMatrices', but found '",
+                     name, "' at offset=", tag_begin - begin);
+              element_begin = tag_begin;
+              is_objective = false;
+            }
+          if(!is_self_closing)
+            {
+              path.push_back(name);
+              continue;
+            }
+        }
+      else
+        {
+          ASSERT(!path.empty() && path.back() == name,
+                 "Unexpected closing tag '", name,
+                 "' at offset=", tag_begin - begin);
+          path.pop_back();
+        }
+
+      // Element closed (or self-closing)
+      const size_t depth = path.size();
+      const Byte_Range range{static_cast<size_t>(element_begin - begin),
+                             static_cast<size_t>(p - begin)};
+      if(depth == 1 && is_objective && name == "objective")
+        {
+          // The last objective in the file wins
+          result.objective = range;
+        }
+      else if(depth == 2 && !is_objective && name == "polynomialVectorMatrix")
+        {
+          result.matrices.push_back(range);
+        }
+    }
+  ASSERT(path.empty(), "Unexpected end of file inside '", path.back(), "'");
+  return result;
+}
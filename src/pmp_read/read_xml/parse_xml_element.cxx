@@ -0,0 +1,72 @@
+#include "Xml_Polynomial_Vector_Matrix_State.hxx"
+
+#include <optional>
+
+// Parse a single XML element from [begin, end),
+// e.g. a matrix found by PMP_File_Index.
+
+void xml_parse_memory(xmlSAXHandler &xml_handlers, void *user_data,
+                      const std::string &name, const char *data, size_t size);
+
+namespace
+{
+  template <class TState> void start_element_callback(void *user_data,
+                                                      const xmlChar *name,
+                                                      const xmlChar **)
+  {
+    auto &state = *static_cast<TState *>(user_data);
+    const std::string element_name = reinterpret_cast<const char *>(name);
+    if(!state.xml_on_start_element(element_name))
+      {
+        RUNTIME_ERROR("Invalid input. Expected '", state.name,
+                      "' but found '", element_name, "'");
+      }
+  }
+
+  template <class TState>
+  void end_element_callback(void *user_data, const xmlChar *name)
+  {
+    static_cast<TState *>(user_data)->xml_on_end_element(
+      reinterpret_cast<const char *>(name));
+  }
+
+  template <class TState>
+  void
+  characters_callback(void *user_data, const xmlChar *characters, int length)
+  {
+    static_cast<TState *>(user_data)->xml_on_characters(characters, length);
+  }
+
+  template <class TState>
+  void parse_xml_element(TState &state, const char *begin, const char *end)
+  {
+    xmlSAXHandler xml_handlers;
+    memset(&xml_handlers, 0, sizeof(xml_handlers));
+    xml_handlers.startElement = start_element_callback<TState>;
+    xml_handlers.endElement = end_element_callback<TState>;
+    xml_handlers.characters = characters_callback<TState>;
+    xml_parse_memory(xml_handlers, &state, state.name, begin, end - begin);
+    ASSERT(!state.inside, "Unexpected end of '", state.name, "'");
+  }
+}
+
+Polynomial_Vector_Matrix parse_xml_matrix(const char *begin, const char *end)
+{
+  std::optional<Polynomial_Vector_Matrix> result;
+  const std::function<void(Xml_Polynomial_Vector_Matrix_State &)>
+    process_matrix = [&result](Xml_Polynomial_Vector_Matrix_State &state) {
+      result.emplace(state.release_matrix());
+    };
+  Xml_Polynomial_Vector_Matrix_State state({"polynomialVectorMatrix"s}, 0,
+                                           process_matrix);
+  parse_xml_element(state, begin, end);
+  ASSERT(result.has_value(), "Nothing was parsed");
+  return std::move(result).value();
+}
+
+std::vector<El::BigFloat> parse_xml_vector(const char *begin, const char *end)
+{
+  Vector_State<Number_State<El::BigFloat>> state({"objective"s, "elt"s});
+  parse_xml_element(state, begin, end);
+  return std::move(state.value);
+}
@@ -1,34 +1,17 @@
 // See the manual for a description of the correct XML input format.
 
-#include "Xml_Parser.hxx"
-#include "pmp_read/PMP_File_Parse_Result.hxx"
+#include "sdpb_util/assert.hxx"
 
-#include <filesystem>
+#include <libxml/parser.h>
 
-namespace fs = std::filesystem;
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <string>
 
 namespace
 {
-  void start_element_callback(void *user_data, const xmlChar *name,
-                              const xmlChar **)
-  {
-    Xml_Parser *input_parser = static_cast<Xml_Parser *>(user_data);
-    input_parser->on_start_element(reinterpret_cast<const char *>(name));
-  }
-
-  void end_element_callback(void *user_data, const xmlChar *name)
-  {
-    Xml_Parser *input_parser = static_cast<Xml_Parser *>(user_data);
-    input_parser->on_end_element(reinterpret_cast<const char *>(name));
-  }
-
-  void
-  characters_callback(void *user_data, const xmlChar *characters, int length)
-  {
-    Xml_Parser *input_parser = static_cast<Xml_Parser *>(user_data);
-    input_parser->on_characters(characters, length);
-  }
-
   void warning_callback(void *, const char *msg, ...)
   {
     va_list args;
@@ -47,75 +30,34 @@ namespace
   }
 }
 
-PMP_File_Parse_Result
-read_xml(const std::filesystem::path &input_file,
-         const std::function<bool(size_t matrix_index)> &should_parse_matrix)
+// Parse XML from memory with the push parser,
+// used for matrix byte ranges in parse_xml_element.cxx.
+// We use push parser instead of xmlSAXUserParseMemory(),
+// because the latter accepts only int size, i.e. < 2GB.
+// Warning and error callbacks are set here.
+void xml_parse_memory(xmlSAXHandler &xml_handlers, void *user_data,
+                      const std::string &name, const char *data,
+                      const size_t size)
 {
   LIBXML_TEST_VERSION;
 
-  PMP_File_Parse_Result result;
-
-  result.num_matrices = 0;
-  // TODO this is ugly, we should keep track of matrix index inside parser
-  // and skip matrices that we don't need.
-  // NB: should be called only once for each matrix index,
-  // otherwise num_matrices will be incorrect!
-  // Currently it is called in Xml_Polynomial_Vector_Matrix_State.xml_on_end_element()
-  auto process_matrix
-    = [&should_parse_matrix, &result](
-        Xml_Polynomial_Vector_Matrix_State &matrix_state) {
-        // num_matrices equals to current matrix index
-        auto index = result.num_matrices;
-        if(should_parse_matrix(index))
-          {
-            El::Matrix<Polynomial_Vector> poly_vectors(matrix_state.rows, matrix_state.cols);
-
-            auto elt = matrix_state.elements_state.value.begin();
-            for(int i = 0; i < poly_vectors.Height(); ++i)
-              for(int j = 0; j < poly_vectors.Width(); ++j)
-                {
-                  swap(poly_vectors(i, j), *elt++);
-                }
-
-            std::optional<Damped_Rational> prefactor = std::nullopt;
-            auto &sample_points = matrix_state.sample_points_state.value;
-            auto &sample_scalings = matrix_state.sample_scalings_state.value;
-            Polynomial_Vector bilinear_basis;
-            swap(bilinear_basis, matrix_state.bilinear_basis_state.value);
-
-            result.parsed_matrices.emplace(
-              index,
-              Polynomial_Vector_Matrix(
-                std::move(poly_vectors), prefactor, std::move(sample_points),
-                std::move(sample_scalings), std::move(bilinear_basis)));
-          }
-        ++result.num_matrices;
-      };
-  Xml_Parser input_parser(process_matrix);
-
-  xmlSAXHandler xml_handlers;
-  // This feels unclean.
-  memset(&xml_handlers, 0, sizeof(xml_handlers));
-  xml_handlers.startElement = start_element_callback;
-  xml_handlers.endElement = end_element_callback;
-  xml_handlers.characters = characters_callback;
   xml_handlers.warning = warning_callback;
   xml_handlers.error = error_callback;
 
-  if(xmlSAXUserParseFile(&xml_handlers, &input_parser, input_file.c_str()) < 0)
-    {
-      RUNTIME_ERROR("Unable to parse input file: ", input_file);
-    }
+  const std::unique_ptr<xmlParserCtxt, decltype(&xmlFreeParserCtxt)> context(
+    xmlCreatePushParserCtxt(&xml_handlers, user_data, nullptr, 0,
+                            name.c_str()),
+    &xmlFreeParserCtxt);
+  ASSERT(context != nullptr, "Failed to create XML parser for ", name);
 
-  // Overwrite the objective with whatever is in the last file
-  // that has an objective, but polynomial_vector_matrices get
-  // appended.
-  auto iterator(input_parser.objective_state.value.begin()),
-    end(input_parser.objective_state.value.end());
-  if(iterator != end)
+  constexpr size_t chunk_size = 1 << 26;
+  for(size_t offset = 0;; offset += chunk_size)
     {
-      result.objective.clear();
-      result.objective.insert(result.objective.end(), iterator, end);
+      const size_t length = std::min(chunk_size, size - offset);
+      const bool is_last = offset + length == size;
+      if(xmlParseChunk(context.get(), data + offset, length, is_last) != 0)
+        RUNTIME_ERROR("Unable to parse input: ", name);
+      if(is_last)
+        break;
     }
-  return result;
 }
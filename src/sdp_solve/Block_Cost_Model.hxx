@@ -0,0 +1,48 @@
+#pragma once
+
+#include "sdpb_util/Verbosity.hxx"
+
+#include <filesystem>
+
+// Analytic estimate of the time spent on each SDP block
+// during one solver iteration.
+//
+// The estimate is a sum of operation counts for the main steps
+// (Cholesky decompositions, bilinear pairings, Schur complement,
+// L^{-1}B, residues and BLAS syrk in bigint_syrk)
+// multiplied by unit timings of the corresponding operations.
+// Unit timings depend on the machine and precision, they are measured
+// by calibrate() and stored in a JSON file, see load_or_calibrate().
+//
+// This allows to create a good block mapping without a timing run.
+struct Block_Cost_Model
+{
+  // Actual GMP precision, in bits
+  size_t precision = 0;
+  // Time of El::BigFloat multiply-add, ns
+  double bigfloat_fma_ns = 0;
+  // Time to compute a residue of a BigInt modulo one prime, ns
+  double residue_ns = 0;
+  // Time of double multiply-add in BLAS gemm, ns
+  double blas_fma_ns = 0;
+
+  // Estimated time for one iteration, in milliseconds.
+  // num_points and dim define block size,
+  // N is the dual objective size (width of B),
+  // num_primes is the number of primes used in bigint_syrk.
+  [[nodiscard]] double
+  block_time_ms(size_t num_points, size_t dim, size_t N,
+                size_t num_primes) const;
+
+  // Run micro-benchmarks for the current precision.
+  // Collective operation on COMM_WORLD: timings are averaged over all ranks,
+  // so that the model is the same everywhere.
+  static Block_Cost_Model calibrate(Verbosity verbosity);
+
+  // Read the model for the current precision from JSON file.
+  // If the file does not exist or has no entry for the current precision,
+  // calibrate the model and write it to the file.
+  // Collective operation on COMM_WORLD.
+  static Block_Cost_Model
+  load_or_calibrate(const std::filesystem::path &path, Verbosity verbosity);
+};
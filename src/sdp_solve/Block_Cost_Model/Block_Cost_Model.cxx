@@ -0,0 +1,142 @@
+#include "../Block_Cost_Model.hxx"
+#include "sdpb_util/assert.hxx"
+
+#include <El.hpp>
+
+#include <array>
+#include <string>
+
+#include <boost/property_tree/json_parser.hpp>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  // The cost model file is read and written on rank 0 only.
+  // If it fails, we throw on all ranks,
+  // otherwise the other ranks would hang in the next collective call.
+  void throw_on_all_ranks_if_error(std::string error)
+  {
+    size_t error_size = error.size();
+    El::mpi::Broadcast(error_size, 0, El::mpi::COMM_WORLD);
+    if(error_size == 0)
+      return;
+    error.resize(error_size);
+    El::mpi::Broadcast(reinterpret_cast<El::byte *>(error.data()),
+                       error_size, 0, El::mpi::COMM_WORLD);
+    RUNTIME_ERROR(error);
+  }
+}
+
+double Block_Cost_Model::block_time_ms(const size_t num_points,
+                                       const size_t dim, const size_t N,
+                                       const size_t num_primes) const
+{
+  // Block sizes, see Block_Info
+  const double schur = num_points * dim * (dim + 1) / 2;
+  const double psd_even = dim * ((num_points + 1) / 2);
+  const double psd_odd = dim * num_points - psd_even;
+  const double bilinear = num_points * dim;
+  const double psd_squares = psd_even * psd_even + psd_odd * psd_odd;
+  const double psd_cubes
+    = psd_even * psd_even * psd_even + psd_odd * psd_odd * psd_odd;
+
+  // Number of BigFloat multiply-adds
+  double bigfloat_ops = 0;
+  // Cholesky decompositions of X and Y
+  bigfloat_ops += 2 * psd_cubes / 3;
+  // Bilinear pairings A_X_inv and A_Y
+  bigfloat_ops += 2 * psd_squares * bilinear;
+  // Schur complement block and its Cholesky decomposition
+  bigfloat_ops += 4 * schur * schur + schur * schur * schur / 3;
+  // L^{-1} B
+  bigfloat_ops += schur * schur * N;
+  // Predictor and corrector search directions
+  bigfloat_ops += 4 * (schur * schur + schur * N);
+
+  // bigint_syrk: residues of L^{-1} B and BLAS syrk for each prime
+  const double residues = schur * N * num_primes;
+  const double blas_ops = schur * N * (N + 1) / 2 * num_primes;
+
+  const double time_ns = bigfloat_ops * bigfloat_fma_ns
+                         + residues * residue_ns + blas_ops * blas_fma_ns;
+  return time_ns / 1e6;
+}
+
+Block_Cost_Model
+Block_Cost_Model::load_or_calibrate(const fs::path &path,
+                                    const Verbosity verbosity)
+{
+  const size_t precision = mpf_get_default_prec();
+  const std::string key = std::to_string(precision);
+
+  // found, bigfloat_fma_ns, residue_ns, blas_fma_ns
+  std::array<double, 4> values{0, 0, 0, 0};
+  std::string error;
+  if(El::mpi::Rank() == 0 && fs::exists(path))
+    {
+      try
+        {
+          boost::property_tree::ptree tree;
+          boost::property_tree::read_json(path.string(), tree);
+          if(const auto model = tree.get_child_optional(key))
+            {
+              values.at(0) = 1;
+              values.at(1) = model->get<double>("bigfloat_fma_ns");
+              values.at(2) = model->get<double>("residue_ns");
+              values.at(3) = model->get<double>("blas_fma_ns");
+            }
+        }
+      catch(std::exception &e)
+        {
+          error = "Error when reading cost model from " + path.string()
+                  + ": " + e.what();
+        }
+    }
+  throw_on_all_ranks_if_error(error);
+  El::mpi::Broadcast(values.data(), values.size(), 0, El::mpi::COMM_WORLD);
+
+  if(values.at(0) != 0)
+    {
+      Block_Cost_Model model;
+      model.precision = precision;
+      model.bigfloat_fma_ns = values.at(1);
+      model.residue_ns = values.at(2);
+      model.blas_fma_ns = values.at(3);
+      if(verbosity >= Verbosity::debug && El::mpi::Rank() == 0)
+        {
+          El::Output("Read block cost model for precision=", precision,
+                     " from ", path);
+        }
+      return model;
+    }
+
+  auto model = calibrate(verbosity);
+  if(El::mpi::Rank() == 0)
+    {
+      try
+        {
+          // Keep models for other precisions
+          boost::property_tree::ptree tree;
+          if(fs::exists(path))
+            boost::property_tree::read_json(path.string(), tree);
+          boost::property_tree::ptree child;
+          child.put("bigfloat_fma_ns", model.bigfloat_fma_ns);
+          child.put("residue_ns", model.residue_ns);
+          child.put("blas_fma_ns", model.blas_fma_ns);
+          tree.put_child(key, child);
+          if(path.has_parent_path())
+            fs::create_directories(path.parent_path());
+          boost::property_tree::write_json(path.string(), tree);
+        }
+      catch(std::exception &e)
+        {
+          error = "Error when writing cost model to " + path.string() + ": "
+                  + e.what();
+        }
+    }
+  throw_on_all_ranks_if_error(error);
+  if(verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
+    El::Output("Saved block cost model to ", path);
+  return model;
+}
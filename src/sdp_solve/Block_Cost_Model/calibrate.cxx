@@ -0,0 +1,119 @@
+#include "../Block_Cost_Model.hxx"
+#include "sdp_solve/SDP_Solver/run/bigint_syrk/fmpz/Fmpz_BigInt.hxx"
+#include "sdp_solve/SDP_Solver/run/bigint_syrk/fmpz/Fmpz_Comb.hxx"
+#include "sdp_solve/SDP_Solver/run/bigint_syrk/fmpz/fmpz_mul_blas_util.hxx"
+
+#include <El.hpp>
+
+#include <array>
+#include <chrono>
+
+namespace
+{
+  // Call f() repeatedly for at least 0.2 seconds,
+  // return average time per call in nanoseconds.
+  template <class F> double time_per_call_ns(const F &f)
+  {
+    using Clock = std::chrono::high_resolution_clock;
+    constexpr double min_total_ns = 2e8;
+    size_t num_calls = 0;
+    double total_ns = 0;
+    const auto start = Clock::now();
+    do
+      {
+        f();
+        ++num_calls;
+        total_ns
+          = std::chrono::duration<double, std::nano>(Clock::now() - start)
+              .count();
+    } while(total_ns < min_total_ns);
+    return total_ns / num_calls;
+  }
+
+  // Fill matrix with numbers having all mantissa bits nonzero,
+  // so that arithmetic is not faster than in the real computations.
+  template <class T> void fill(El::Matrix<T> &matrix)
+  {
+    for(El::Int i = 0; i < matrix.Height(); ++i)
+      for(El::Int j = 0; j < matrix.Width(); ++j)
+        matrix(i, j) = T(i + 1) / T(j + 3) - T(1) / T(7);
+  }
+
+  double bigfloat_fma_ns()
+  {
+    const El::Int n = 32;
+    El::Matrix<El::BigFloat> A(n, n), B(n, n), C(n, n);
+    fill(A);
+    fill(B);
+    const double gemm_ns = time_per_call_ns([&] {
+      El::Gemm(El::NORMAL, El::NORMAL, El::BigFloat(1), A, B, El::BigFloat(0),
+               C);
+    });
+    return gemm_ns / (n * n * n);
+  }
+
+  double blas_fma_ns()
+  {
+    const El::Int n = 256;
+    El::Matrix<double> A(n, n), B(n, n), C(n, n);
+    fill(A);
+    fill(B);
+    const double gemm_ns = time_per_call_ns([&] {
+      El::Gemm(El::NORMAL, El::NORMAL, 1.0, A, B, 0.0, C);
+    });
+    return gemm_ns / (n * n * n);
+  }
+
+  double residue_ns()
+  {
+    const mp_bitcnt_t precision = El::gmp::Precision();
+    // Number of additions in syrk, affects only the number of primes.
+    const slong k = 1 << 14;
+    Fmpz_Comb comb(precision, precision, 1, k);
+
+    // Integers of the same size as in bigint_syrk,
+    // see Matrix_Normalizer::normalize_and_shift_P()
+    const size_t num_values = 64;
+    std::vector<Fmpz_BigInt> values(num_values);
+    for(size_t i = 0; i < num_values; ++i)
+      {
+        const El::BigFloat normalized = El::BigFloat(i + 1) / (num_values + 7);
+        values.at(i).from_BigFloat(normalized << precision);
+      }
+    std::vector<double> residues(comb.num_primes);
+    const double total_ns = time_per_call_ns([&] {
+      for(const auto &value : values)
+        fmpz_multi_mod_uint32_stride(residues.data(), 1, value.value, comb);
+    });
+    return total_ns / (num_values * comb.num_primes);
+  }
+}
+
+Block_Cost_Model Block_Cost_Model::calibrate(const Verbosity verbosity)
+{
+  if(verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
+    El::Output("Calibrating block cost model...");
+
+  // All ranks run benchmarks simultaneously, as in real computations.
+  std::array<double, 3> timings{bigfloat_fma_ns(), residue_ns(),
+                                blas_fma_ns()};
+  El::mpi::AllReduce(timings.data(), timings.size(), El::mpi::SUM,
+                     El::mpi::COMM_WORLD);
+  for(auto &timing : timings)
+    timing /= El::mpi::Size();
+
+  Block_Cost_Model model;
+  model.precision = mpf_get_default_prec();
+  model.bigfloat_fma_ns = timings.at(0);
+  model.residue_ns = timings.at(1);
+  model.blas_fma_ns = timings.at(2);
+
+  if(verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
+    {
+      El::Output("Block cost model for precision=", model.precision,
+                 ":\n\tBigFloat multiply-add: ", model.bigfloat_fma_ns,
+                 " ns\n\tresidue per prime: ", model.residue_ns,
+                 " ns\n\tBLAS multiply-add: ", model.blas_fma_ns, " ns");
+    }
+  return model;
+}
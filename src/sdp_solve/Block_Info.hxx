@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Block_Cost_Model.hxx"
 #include "sdpb_util/Environment.hxx"
 #include "sdpb_util/Verbosity.hxx"
 #include "sdpb_util/assert.hxx"
@@ -10,6 +11,7 @@
 #include <El.hpp>
 #include <algorithm>
 #include <filesystem>
+#include <optional>
 
 class Block_Info
 {
@@ -22,17 +24,31 @@ public:
   std::vector<size_t> block_indices;
   MPI_Group_Wrapper mpi_group;
   MPI_Comm_Wrapper mpi_comm;
+  size_t proc_granularity = 1;
+  // Memory estimate for each block and the memory limit per node,
+  // in units of BigFloat size. Set by allocate_blocks()
+  // if the mapping is memory-aware, otherwise empty and 0.
+  std::vector<size_t> block_memory;
+  size_t max_node_memory = 0;
 
   // TODO add Block_Info::total_size() == block_info.dimensions.size()
   // Rename block_info.block_indices to local_block_indices to make it clearer
 
   Block_Info() = delete;
+  // If no block_timings are found, block costs are estimated
+  // from cost_model (if set) or from memory usage.
+  // If memory_aware_mapping is set, the mapping also keeps
+  // the estimated memory of blocks on each node below the limit,
+  // see allocate_blocks().
   Block_Info(const Environment &env, const std::filesystem::path &sdp_path,
              const std::filesystem::path &checkpoint_in,
-             const size_t &proc_granularity, const Verbosity &verbosity);
+             const size_t &proc_granularity, const Verbosity &verbosity,
+             const std::optional<Block_Cost_Model> &cost_model = std::nullopt,
+             bool memory_aware_mapping = false);
   Block_Info(const Environment &env, const std::filesystem::path &sdp_path,
              const El::Matrix<int32_t> &block_timings,
-             const size_t &proc_granularity, const Verbosity &verbosity);
+             const size_t &proc_granularity, const Verbosity &verbosity,
+             bool memory_aware_mapping = false);
   Block_Info(const Environment &env,
              const std::vector<size_t> &matrix_dimensions,
              const size_t &proc_granularity, const Verbosity &verbosity);
@@ -45,11 +61,34 @@ public:
   std::vector<Block_Cost>
   read_block_costs(const std::filesystem::path &sdp_path,
                    const std::filesystem::path &checkpoint_in,
-                   const Environment &env);
+                   const Environment &env,
+                   const std::optional<Block_Cost_Model> &cost_model);
+  // Estimated memory for each block, in units of BigFloat size:
+  // B band and its residues, Schur complement, PSD matrices
+  // and bilinear pairings.
+  // Also sets dual_objective_size (N) and the number of primes
+  // used in bigint_syrk.
+  [[nodiscard]] std::vector<size_t>
+  block_memory_estimates(const std::filesystem::path &sdp_path,
+                         const Environment &env, size_t &dual_objective_size,
+                         size_t &num_primes) const;
+  // If block_memory is not empty, blocks are moved between nodes
+  // to fit into the memory limit derived from /proc/meminfo,
+  // see limit_block_grid_mapping_memory().
   void
   allocate_blocks(const Environment &env,
                   const std::vector<Block_Cost> &block_costs,
-                  const size_t &proc_granularity, const Verbosity &verbosity);
+                  const size_t &proc_granularity, const Verbosity &verbosity,
+                  const std::vector<size_t> &block_memory = {});
+  // Ratio of the maximal per-process load for the current block mapping
+  // to the maximal per-process load for the mapping that
+  // allocate_blocks() would create from the same block_timings
+  // (including the memory limit, if the mapping is memory-aware).
+  // Returns 1 if such mapping does not exist.
+  // Collective operation on COMM_WORLD.
+  [[nodiscard]] double
+  load_imbalance(const Environment &env,
+                 const El::Matrix<int32_t> &block_timings) const;
 
   [[nodiscard]] size_t get_schur_block_size(const size_t index) const
   {
@@ -129,5 +168,8 @@ namespace std
     swap(a.block_indices, b.block_indices);
     swap(a.mpi_group, b.mpi_group);
     swap(a.mpi_comm, b.mpi_comm);
+    swap(a.proc_granularity, b.proc_granularity);
+    swap(a.block_memory, b.block_memory);
+    swap(a.max_node_memory, b.max_node_memory);
   }
 }
@@ -5,18 +5,29 @@ namespace fs = std::filesystem;
 Block_Info::Block_Info(const Environment &env, const fs::path &sdp_path,
                        const fs::path &checkpoint_in,
                        const size_t &proc_granularity,
-                       const Verbosity &verbosity)
+                       const Verbosity &verbosity,
+                       const std::optional<Block_Cost_Model> &cost_model,
+                       const bool memory_aware_mapping)
 {
   read_block_info(sdp_path);
   std::vector<Block_Cost> block_costs(
-    read_block_costs(sdp_path, checkpoint_in, env));
-  allocate_blocks(env, block_costs, proc_granularity, verbosity);
+    read_block_costs(sdp_path, checkpoint_in, env, cost_model));
+  std::vector<size_t> block_memory;
+  if(memory_aware_mapping)
+    {
+      size_t dual_objective_size, num_primes;
+      block_memory = block_memory_estimates(sdp_path, env,
+                                            dual_objective_size, num_primes);
+    }
+  allocate_blocks(env, block_costs, proc_granularity, verbosity,
+                  block_memory);
 }
 
 Block_Info::Block_Info(const Environment &env, const fs::path &sdp_path,
                        const El::Matrix<int32_t> &block_timings,
                        const size_t &proc_granularity,
-                       const Verbosity &verbosity)
+                       const Verbosity &verbosity,
+                       const bool memory_aware_mapping)
 {
   read_block_info(sdp_path);
   std::vector<Block_Cost> block_costs;
@@ -26,7 +37,15 @@ Block_Info::Block_Info(const Environment &env, const fs::path &sdp_path,
     {
       block_costs.emplace_back(block_timings(block, 0), block);
     }
-  allocate_blocks(env, block_costs, proc_granularity, verbosity);
+  std::vector<size_t> block_memory;
+  if(memory_aware_mapping)
+    {
+      size_t dual_objective_size, num_primes;
+      block_memory = block_memory_estimates(sdp_path, env,
+                                            dual_objective_size, num_primes);
+    }
+  allocate_blocks(env, block_costs, proc_granularity, verbosity,
+                  block_memory);
 }
 
 Block_Info::Block_Info(const Environment &env,
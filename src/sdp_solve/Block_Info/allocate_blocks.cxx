@@ -2,30 +2,117 @@
 #include "sdpb_util/assert.hxx"
 #include "sdpb_util/block_mapping/compute_block_grid_mapping.hxx"
 #include "sdpb_util/block_mapping/create_mpi_block_mapping_groups.hxx"
+#include "sdpb_util/block_mapping/limit_block_grid_mapping_memory.hxx"
+#include "sdpb_util/memory_estimates.hxx"
+#include "sdpb_util/Proc_Meminfo.hxx"
+#include "sdpb_util/ostream/pretty_print_bytes.hxx"
+
+namespace
+{
+  // Memory limit for the blocks on each node, in bytes.
+  // We take the smallest MemTotal among all nodes,
+  // so that the limit is the same on all ranks.
+  // Returns 0 if /proc/meminfo cannot be read on some node.
+  size_t
+  get_max_block_memory_per_node_bytes(const Environment &env,
+                                      const Verbosity verbosity)
+  {
+    size_t mem_total_bytes = std::numeric_limits<size_t>::max();
+    if(env.comm_shared_mem.Rank() == 0)
+      {
+        bool res;
+        const auto meminfo
+          = Proc_Meminfo::try_read(res, verbosity >= Verbosity::debug);
+        mem_total_bytes = res ? meminfo.mem_total : 0;
+      }
+    mem_total_bytes = El::mpi::AllReduce(mem_total_bytes, El::mpi::MIN,
+                                         El::mpi::COMM_WORLD);
+    const size_t mem_used_bytes
+      = El::mpi::AllReduce(env.initial_node_mem_used(), El::mpi::MAX,
+                           El::mpi::COMM_WORLD);
+    if(mem_total_bytes <= mem_used_bytes)
+      return 0;
+    // ad-hoc coefficient 0.8 to leave some RAM for the block-independent
+    // part (Q matrix, MPI buffers etc.)
+    return 0.8 * (mem_total_bytes - mem_used_bytes);
+  }
+}
 
 void Block_Info::allocate_blocks(const Environment &env,
                                  const std::vector<Block_Cost> &block_costs,
                                  const size_t &proc_granularity,
-                                 const Verbosity &verbosity)
+                                 const Verbosity &verbosity,
+                                 const std::vector<size_t> &block_memory)
 {
   const size_t num_procs = El::mpi::Size(El::mpi::COMM_WORLD);
-  const size_t num_nodes = env.num_nodes();
-  const size_t procs_per_node = env.comm_shared_mem.Size();
-  ASSERT(procs_per_node * num_nodes == num_procs,
-         "Incompatible number of MPI processes and processes per node "
-         "for node=",
-         env.node_index(),
-         ". Each node should have the same number of processes."
-         "\n\tMPI processes: ",
-         num_procs, "\n\tprocsPerNode: ", procs_per_node,
-         "\n\tnum_nodes: ", num_nodes);
-  ASSERT(procs_per_node % proc_granularity == 0,
-         "Incompatible number of processes per node and process granularity.  "
-         "procGranularity mush evenly divide procsPerNode:\n\tprocsPerNode: ",
-         procs_per_node, "\n\tprocGranularity: ", proc_granularity);
+  const auto &procs_per_node = env.procs_per_node();
+  ASSERT_EQUAL(std::accumulate(procs_per_node.begin(), procs_per_node.end(),
+                               size_t(0)),
+               num_procs, "Incompatible number of MPI processes and "
+                          "total number of processes on all nodes.");
+  std::vector<size_t> granules_per_node;
+  for(size_t node = 0; node < procs_per_node.size(); ++node)
+    {
+      ASSERT(procs_per_node[node] % proc_granularity == 0,
+             "Incompatible number of processes per node and process "
+             "granularity.  "
+             "procGranularity mush evenly divide procsPerNode:\n\tnode: ",
+             node, "\n\tprocsPerNode: ", procs_per_node[node],
+             "\n\tprocGranularity: ", proc_granularity);
+      granules_per_node.push_back(procs_per_node[node] / proc_granularity);
+    }
+  this->proc_granularity = proc_granularity;
+
+  std::vector<std::vector<Block_Map>> mapping(
+    compute_block_grid_mapping(granules_per_node, block_costs));
 
-  std::vector<std::vector<Block_Map>> mapping(compute_block_grid_mapping(
-    procs_per_node / proc_granularity, num_nodes, block_costs));
+  if(!block_memory.empty())
+    {
+      ASSERT_EQUAL(block_memory.size(), block_costs.size());
+      const size_t max_memory_bytes
+        = get_max_block_memory_per_node_bytes(env, verbosity);
+      if(max_memory_bytes == 0)
+        {
+          if(El::mpi::Rank() == 0)
+            PRINT_WARNING("Cannot determine memory limit from /proc/meminfo, "
+                          "block mapping will ignore memory estimates.");
+        }
+      else
+        {
+          // Work in units of BigFloat size, as block_memory
+          const size_t max_memory = max_memory_bytes / bigfloat_bytes();
+          this->block_memory = block_memory;
+          this->max_node_memory = max_memory;
+          if(!limit_block_grid_mapping_memory(mapping, block_costs,
+                                              block_memory, max_memory))
+            {
+              const auto node_memory
+                = block_grid_mapping_node_memory(mapping, block_memory);
+              const size_t max_node_memory
+                = *std::max_element(node_memory.begin(), node_memory.end());
+              RUNTIME_ERROR(
+                "Cannot assign blocks to nodes within the memory limit."
+                "\n\tMemory limit per node: ",
+                pretty_print_bytes(max_memory_bytes, true),
+                "\n\tLargest block memory estimate on a node: ",
+                pretty_print_bytes(max_node_memory * bigfloat_bytes(), true),
+                "\n\tConsider increasing number of nodes or RAM per node.");
+            }
+          if(verbosity >= Verbosity::debug && El::mpi::Rank() == 0)
+            {
+              const auto node_memory
+                = block_grid_mapping_node_memory(mapping, block_memory);
+              std::stringstream ss;
+              ss << "Block memory estimates, limit per node: "
+                 << pretty_print_bytes(max_memory_bytes, true);
+              for(size_t node = 0; node < node_memory.size(); ++node)
+                ss << "\n\tnode=" << node << ": "
+                   << pretty_print_bytes(
+                        node_memory[node] * bigfloat_bytes(), true);
+              El::Output(ss.str());
+            }
+        }
+    }
 
   for(auto &block_vector : mapping)
     for(auto &block_map : block_vector)
@@ -61,6 +148,12 @@ void Block_Info::allocate_blocks(const Environment &env,
         }
       El::Output(ss.str());
     }
+  if(verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
+    {
+      El::Output("Block grid mapping: predicted load imbalance "
+                 "(max/average cost per process) = ",
+                 block_grid_mapping_imbalance(mapping));
+    }
 
   const auto &node_comm = env.comm_shared_mem;
   const int node_index = env.node_index();
@@ -0,0 +1,84 @@
+#include "../Block_Info.hxx"
+#include "sdp_solve/SDP_Solver/run/bigint_syrk/fmpz/Fmpz_Comb.hxx"
+#include "sdpb_util/assert.hxx"
+#include "sdpb_util/Timers/Timers.hxx"
+
+namespace fs = std::filesystem;
+
+void read_objectives(const fs::path &sdp_path, const El::Grid &grid,
+                     El::BigFloat &objective_const,
+                     El::DistMatrix<El::BigFloat> &dual_objective_b,
+                     Timers &timers);
+
+std::vector<size_t>
+Block_Info::block_memory_estimates(const fs::path &sdp_path,
+                                   const Environment &env,
+                                   size_t &dual_objective_size,
+                                   size_t &num_primes) const
+{
+  El::Grid grid(this->mpi_comm.value);
+  El::BigFloat objective_const;
+  El::DistMatrix<El::BigFloat> dual_objective_b;
+  // TODO pass timers as argument
+  Timers timers(env, Verbosity::regular);
+  // TODO objectives are already read in SDP::SDP(),
+  // we should reuse them instead of reading again
+  read_objectives(sdp_path, grid, objective_const, dual_objective_b, timers);
+
+  dual_objective_size = dual_objective_b.Height(); // N
+  auto schur_sizes = schur_block_sizes();
+  auto psd_sizes = psd_matrix_block_sizes();
+  auto bilinear_sizes = bilinear_pairing_block_sizes();
+
+  auto elements_count = [](const std::vector<size_t> &sizes,
+                           const size_t index) {
+    return sizes[index] * sizes[index];
+  };
+
+  // We store residues of L^{-1}B band modulo a bunch of primes
+  // in a shared memory window of doubles,
+  // see BigInt_Shared_Memory_Syrk_Context.input_block_residues_window.
+  // residue_size is total size of residues for one BigFloat divided by size of BigFloat.
+  double residue_size;
+  {
+    auto total_schur_block_height
+      = std::accumulate(schur_sizes.begin(), schur_sizes.end(), 0);
+
+    // Same Fmpz_Comb initialization,
+    // as in initialize_bigint_syrk_context()
+    auto schur_block_height_per_node
+      = total_schur_block_height / env.num_nodes();
+    Fmpz_Comb comb(El::gmp::Precision(), El::gmp::Precision(), 1,
+                   schur_block_height_per_node);
+
+    num_primes = comb.num_primes;
+    residue_size = (double)comb.num_primes * sizeof(double)
+                   / El::BigFloat(1.1).SerializedSize();
+    // Sanity check: residues always take more RAM
+    // than the original BigFloat number,
+    // otherwise the number cannot be restored.
+    ASSERT(residue_size >= 1.0, residue_size);
+  }
+
+  std::vector<size_t> result;
+  for(size_t block = 0; block < schur_sizes.size(); ++block)
+    {
+      auto schur = elements_count(schur_sizes, block);
+      auto psd = elements_count(psd_sizes, 2 * block)
+                 + elements_count(psd_sizes, 2 * block + 1);
+      auto bilinear = elements_count(bilinear_sizes, 2 * block)
+                      + elements_count(bilinear_sizes, 2 * block + 1);
+      // P'xN, a band of B(=free_var_matrix)
+      auto B_band = schur_sizes[block] * dual_objective_size;
+
+      //  L^{-1}B residues, see BigInt_Shared_Memory_Syrk_Context.input_block_residues_window
+      size_t B_band_residues = std::round(B_band * residue_size);
+      // Estimate total RAM associated with the block.
+      // (There is also a RAM contribution from #(Q)=NxN, but it's
+      // block-independent)
+      auto total_size = 2 * B_band + 5 * psd + 2 * schur + 2 * bilinear
+                        + B_band_residues;
+      result.push_back(total_size);
+    }
+  return result;
+}
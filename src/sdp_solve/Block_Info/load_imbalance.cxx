@@ -0,0 +1,47 @@
+#include "../Block_Info.hxx"
+#include "sdpb_util/block_mapping/compute_block_grid_mapping.hxx"
+#include "sdpb_util/block_mapping/limit_block_grid_mapping_memory.hxx"
+
+double Block_Info::load_imbalance(const Environment &env,
+                                  const El::Matrix<int32_t> &block_timings) const
+{
+  ASSERT_EQUAL(block_timings.Height(), num_points.size());
+  ASSERT_EQUAL(block_timings.Width(), 1);
+
+  // Block timings are summed over all ranks owning a block,
+  // so the load of a process is the total time of its group
+  // divided by the group size.
+  double group_cost = 0;
+  for(const auto block_index : block_indices)
+    group_cost += block_timings(block_index, 0);
+  const double current_max_load = El::mpi::AllReduce(
+    group_cost / mpi_comm.value.Size(), El::mpi::MAX, El::mpi::COMM_WORLD);
+
+  // block_timings are the same on all ranks,
+  // so the new mapping is the same too.
+  std::vector<Block_Cost> block_costs;
+  for(int64_t block = 0; block < block_timings.Height(); ++block)
+    block_costs.emplace_back(std::max(block_timings(block, 0), 0), block);
+  std::vector<size_t> granules_per_node;
+  for(const auto procs : env.procs_per_node())
+    granules_per_node.push_back(procs / proc_granularity);
+  auto mapping = compute_block_grid_mapping(granules_per_node, block_costs);
+  // The same memory limit as in allocate_blocks()
+  if(!block_memory.empty()
+     && !limit_block_grid_mapping_memory(mapping, block_costs, block_memory,
+                                         max_node_memory))
+    return 1;
+
+  double new_max_load = 0;
+  for(const auto &node_mapping : mapping)
+    for(const auto &block_map : node_mapping)
+      {
+        const double load
+          = block_map.cost
+            / static_cast<double>(block_map.num_procs * proc_granularity);
+        new_max_load = std::max(new_max_load, load);
+      }
+  if(new_max_load == 0)
+    return 1;
+  return current_max_load / new_max_load;
+}
@@ -89,6 +89,12 @@ struct SDP
   // free_var_matrix = B, a PxN matrix
   Block_Matrix free_var_matrix;
 
+  // For each block of free_var_matrix, ranges of columns
+  // that contain nonzero elements. Other columns are identically zero,
+  // e.g. if a block involves only some of the dual variables y.
+  // Used to skip zero columns when computing L^{-1} B.
+  std::vector<std::vector<El::Range<El::Int>>> free_var_nonzero_columns;
+
   // c, a vector of length P used with primal_objective
   Block_Vector primal_objective_c;
 
@@ -118,5 +124,6 @@ struct SDP
       const El::Grid &grid);
 
 private:
+  void find_free_var_nonzero_columns(const Block_Info &block_info);
   void validate(const Block_Info &block_info) const noexcept(false);
 };
@@ -30,6 +30,10 @@ SDP::SDP(const fs::path &sdp_path, const Block_Info &block_info,
   if(El::mpi::Rank() == 0)
     normalization = read_normalization(sdp_path, timers);
   read_block_data(sdp_path, grid, block_info, *this, timers);
+  {
+    Scoped_Timer nonzero_columns_timer(timers, "find_nonzero_columns");
+    find_free_var_nonzero_columns(block_info);
+  }
 
   Scoped_Timer validate_timer(timers, "validate");
   validate(block_info);
@@ -149,9 +153,57 @@ SDP::SDP(
   // Copy over dual_objective_b
   copy_matrix(dual_objective_b_star, dual_objective_b);
 
+  find_free_var_nonzero_columns(block_info);
   validate(block_info);
 }
 
+// All blocks of free_var_matrix are distributed over block_info.mpi_comm,
+// so we synchronize nonzero flags for all blocks at once.
+void SDP::find_free_var_nonzero_columns(const Block_Info &block_info)
+{
+  const auto &blocks = free_var_matrix.blocks;
+  std::vector<size_t> offsets(blocks.size() + 1, 0);
+  for(size_t index = 0; index < blocks.size(); ++index)
+    offsets.at(index + 1) = offsets.at(index) + blocks.at(index).Width();
+
+  std::vector<int> is_nonzero(offsets.back(), 0);
+  for(size_t index = 0; index < blocks.size(); ++index)
+    {
+      const auto &block = blocks.at(index);
+      for(int jLoc = 0; jLoc < block.LocalWidth(); ++jLoc)
+        {
+          auto &flag
+            = is_nonzero.at(offsets.at(index) + block.GlobalCol(jLoc));
+          for(int iLoc = 0; iLoc < block.LocalHeight() && flag == 0; ++iLoc)
+            {
+              if(mpf_sgn(block.GetLocalCRef(iLoc, jLoc).gmp_float.get_mpf_t())
+                 != 0)
+                flag = 1;
+            }
+        }
+    }
+  if(!is_nonzero.empty())
+    El::mpi::AllReduce(is_nonzero.data(), is_nonzero.size(), El::mpi::MAX,
+                       block_info.mpi_comm.value);
+
+  free_var_nonzero_columns.clear();
+  free_var_nonzero_columns.resize(blocks.size());
+  for(size_t index = 0; index < blocks.size(); ++index)
+    {
+      auto &ranges = free_var_nonzero_columns.at(index);
+      const El::Int width = blocks.at(index).Width();
+      for(El::Int column = 0; column < width; ++column)
+        {
+          if(is_nonzero.at(offsets.at(index) + column) == 0)
+            continue;
+          if(!ranges.empty() && ranges.back().end == column)
+            ++ranges.back().end;
+          else
+            ranges.emplace_back(column, column + 1);
+        }
+    }
+}
+
 void SDP::validate(const Block_Info &block_info) const noexcept(false)
 {
   const size_t num_blocks = block_info.block_indices.size();
@@ -162,6 +214,7 @@ void SDP::validate(const Block_Info &block_info) const noexcept(false)
     // Check array sizes
     ASSERT_EQUAL(primal_objective_c.blocks.size(), num_blocks, error_prefix);
     ASSERT_EQUAL(free_var_matrix.blocks.size(), num_blocks, error_prefix);
+    ASSERT_EQUAL(free_var_nonzero_columns.size(), num_blocks, error_prefix);
     ASSERT_EQUAL(bilinear_bases.size(), 2 * num_blocks, error_prefix);
     ASSERT_EQUAL(bases_blocks.size(), 2 * num_blocks);
   }
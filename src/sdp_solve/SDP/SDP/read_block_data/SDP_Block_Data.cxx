@@ -1,6 +1,7 @@
 #include "SDP_Block_Data.hxx"
 
 #include "Json_Block_Data_Parser.hxx"
+#include "pmp2sdp/Mmap_Block_Format.hxx"
 #include "sdp_solve/SDP/SDP/set_bases_blocks.hxx"
 #include "sdpb_util/Vector_State.hxx"
 #include "sdpb_util/assert.hxx"
@@ -10,6 +11,8 @@
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/reader.h>
 
+#include <iterator>
+
 namespace
 {
   // Convert vec[N] to Matrix(N,1)
@@ -27,6 +30,24 @@ namespace
   }
 }
 
+// NB: this should match pmp2sdp/write_block_data.cxx
+Block_Data_Parse_Result parse_mmap_block_data(const char *data, size_t size)
+{
+  namespace Format = Mmap_Block_Format;
+  const Format::View view(data, size);
+
+  Block_Data_Parse_Result result;
+  result.B = view.read_matrix(Format::B);
+  const auto &c_header = view.matrix(Format::c);
+  ASSERT_EQUAL(c_header.width, 1);
+  result.c.resize(c_header.height);
+  for(size_t i = 0; i < c_header.height; ++i)
+    view.get(Format::c, i, 0, result.c[i]);
+  result.bilinear_bases_even = view.read_matrix(Format::bilinear_bases_even);
+  result.bilinear_bases_odd = view.read_matrix(Format::bilinear_bases_odd);
+  return result;
+}
+
 // TODO move this code closer to Dual_Constraint_Group definition?
 Block_Data_Parse_Result
 parse_block_data(std::istream &block_stream, Block_File_Format format)
@@ -56,6 +77,14 @@ parse_block_data(std::istream &block_stream, Block_File_Format format)
       rapidjson::Reader reader;
       reader.Parse(wrapper, parser);
     }
+  else if(format == mmap_bin)
+    {
+      // Stream cannot be mapped to memory (e.g. compressed archive entry),
+      // so we have to read it to a buffer.
+      const std::istreambuf_iterator<char> begin(block_stream), end;
+      const std::vector<char> buffer(begin, end);
+      result = parse_mmap_block_data(buffer.data(), buffer.size());
+    }
   else
     {
       RUNTIME_ERROR("Unknown Block_File_Format: ", format);
@@ -67,9 +96,22 @@ SDP_Block_Data::SDP_Block_Data(std::istream &block_stream,
                                const Block_File_Format format,
                                const size_t block_index_local,
                                const Block_Info &block_info)
+    : SDP_Block_Data(parse_block_data(block_stream, format),
+                     block_index_local, block_info)
+{}
+
+SDP_Block_Data::SDP_Block_Data(const char *mmap_block_data, const size_t size,
+                               const size_t block_index_local,
+                               const Block_Info &block_info)
+    : SDP_Block_Data(parse_mmap_block_data(mmap_block_data, size),
+                     block_index_local, block_info)
+{}
+
+SDP_Block_Data::SDP_Block_Data(Block_Data_Parse_Result &&parse_result,
+                               const size_t block_index_local,
+                               const Block_Info &block_info)
     : block_index_local(block_index_local)
 {
-  auto parse_result = parse_block_data(block_stream, format);
   constraint_matrix = std::move(parse_result.B);
   primal_objective_c = to_matrix(parse_result.c);
   bilinear_bases[0] = std::move(parse_result.bilinear_bases_even);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Block_Data_Parse_Result.hxx"
 #include "pmp2sdp/Block_File_Format.hxx"
 #include "sdp_solve/Block_Info.hxx"
 
@@ -17,6 +18,12 @@ struct SDP_Block_Data
   SDP_Block_Data() = default;
   SDP_Block_Data(std::istream &block_stream, Block_File_Format format,
                  size_t block_index_local, const Block_Info &block_info);
+  // Read from memory-mapped block_data_XXX.mmap file,
+  // see Block_File_Format::mmap_bin
+  SDP_Block_Data(const char *mmap_block_data, size_t size,
+                 size_t block_index_local, const Block_Info &block_info);
+  SDP_Block_Data(Block_Data_Parse_Result &&parse_result,
+                 size_t block_index_local, const Block_Info &block_info);
 
   // Allow move and prohibit copy
 
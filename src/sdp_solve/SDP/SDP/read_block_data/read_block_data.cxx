@@ -1,10 +1,19 @@
 #include "SDP_Block_Data.hxx"
+#include "pmp2sdp/Mmap_Block_Format.hxx"
 #include "pmp2sdp/write_sdp.hxx"
 #include "sdp_solve/Archive_Reader.hxx"
 #include "sdp_solve/SDP.hxx"
+#include "sdp_solve/SDP/SDP/set_bases_blocks.hxx"
+#include "sdp_solve/Zip_Index.hxx"
 #include "sdpb_util/assert.hxx"
 #include "sdpb_util/copy_matrix.hxx"
+#include "sdpb_util/Memory_Mapped_File.hxx"
 
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <set>
 #include <unordered_map>
 
 namespace fs = std::filesystem;
@@ -18,9 +27,158 @@ namespace
       return Block_File_Format::json;
     if(extension == ".bin")
       return Block_File_Format::bin;
+    if(extension == ".mmap")
+      return Block_File_Format::mmap_bin;
     RUNTIME_ERROR("Unknown block file extension: ", block_path);
   }
 
+  // Archives containing block_data for the given blocks,
+  // together with the number of these blocks in each archive.
+  //
+  // If sdp.zip is sharded (i.e. contains shards.json manifest written by
+  // pmp2sdp --zipShards), then we return only the shards sdp.shard_K.zip
+  // that contain some of block_indices.
+  // Otherwise, block_data files are stored in sdp.zip itself.
+  std::vector<std::pair<fs::path, size_t>>
+  get_block_data_archives(const fs::path &sdp_zip_path,
+                          const std::vector<size_t> &block_indices)
+  {
+    std::vector<std::pair<fs::path, size_t>> result;
+
+    Archive_Reader reader(sdp_zip_path);
+    while(reader.next_entry())
+      {
+        const std::string pathname(archive_entry_pathname(reader.entry_ptr));
+        // pmp2sdp writes shards.json before all block files,
+        // so there is no need to look further.
+        if(boost::algorithm::starts_with(pathname, "block_"))
+          break;
+        if(pathname != "shards.json")
+          continue;
+
+        std::istream stream(&reader);
+        rapidjson::IStreamWrapper wrapper(stream);
+        rapidjson::Document document;
+        document.ParseStream(wrapper);
+        if(document.HasParseError())
+          RUNTIME_ERROR("Failed to parse shards.json in ", sdp_zip_path);
+        if(!document.IsObject() || !document.HasMember("shards")
+           || !document["shards"].IsArray())
+          RUNTIME_ERROR("shards.json in ", sdp_zip_path,
+                        " should contain \"shards\" array");
+        const auto shards = document["shards"].GetArray();
+        if(document.HasMember("num_shards")
+           && (!document["num_shards"].IsUint64()
+               || document["num_shards"].GetUint64() != shards.Size()))
+          RUNTIME_ERROR("shards.json in ", sdp_zip_path,
+                        ": \"num_shards\" does not match the number of "
+                        "shards, ",
+                        shards.Size());
+
+        const std::set<size_t> my_blocks(block_indices.begin(),
+                                         block_indices.end());
+        std::set<size_t> found_blocks;
+        for(rapidjson::SizeType shard_index = 0; shard_index < shards.Size();
+            ++shard_index)
+          {
+            const auto &shard = shards[shard_index];
+            if(!shard.IsObject() || !shard.HasMember("path")
+               || !shard["path"].IsString()
+               || !shard.HasMember("block_indices")
+               || !shard["block_indices"].IsArray())
+              RUNTIME_ERROR("shards.json in ", sdp_zip_path, ": shard ",
+                            shard_index,
+                            " should contain \"path\" string and "
+                            "\"block_indices\" array");
+            size_t count = 0;
+            for(const auto &block_index : shard["block_indices"].GetArray())
+              {
+                if(!block_index.IsUint64())
+                  RUNTIME_ERROR("shards.json in ", sdp_zip_path, ": shard ",
+                                shard_index,
+                                " has invalid block index in "
+                                "\"block_indices\"");
+                if(my_blocks.count(block_index.GetUint64()) != 0)
+                  {
+                    found_blocks.insert(block_index.GetUint64());
+                    ++count;
+                  }
+              }
+            if(count != 0)
+              {
+                result.emplace_back(
+                  sdp_zip_path.parent_path() / shard["path"].GetString(),
+                  count);
+              }
+          }
+        for(const auto &block_index : my_blocks)
+          {
+            if(found_blocks.count(block_index) == 0)
+              RUNTIME_ERROR("shards.json in ", sdp_zip_path, ": block ",
+                            block_index, " is not found in any shard");
+          }
+        return result;
+      }
+
+    result.emplace_back(sdp_zip_path, block_indices.size());
+    return result;
+  }
+
+  struct Block_Data_Location
+  {
+    fs::path archive_path;
+    Zip_Index::Entry entry;
+    Block_File_Format format;
+  };
+
+  // Locations of block_data entries for all blocks, found in zip central
+  // directories of the archives. This allows to read each block directly,
+  // without scanning through the archive.
+  // Returns empty vector if some archive is not a zip file,
+  // or if some block is missing or compressed.
+  // In that case, we fall back to sequential reading with Archive_Reader.
+  std::vector<Block_Data_Location> get_block_data_locations(
+    const std::vector<std::pair<fs::path, size_t>> &archives,
+    const std::vector<size_t> &block_indices)
+  {
+    std::vector<std::pair<fs::path, Zip_Index>> zip_indices;
+    for(const auto &[archive_path, num_blocks] : archives)
+      {
+        auto zip_index = Zip_Index::try_read(archive_path);
+        if(!zip_index.has_value())
+          return {};
+        zip_indices.emplace_back(archive_path, std::move(zip_index.value()));
+      }
+
+    std::vector<Block_Data_Location> result;
+    result.reserve(block_indices.size());
+    for(const auto &block_index : block_indices)
+      {
+        const auto name = "block_data_" + std::to_string(block_index);
+        bool found = false;
+        for(const auto &[archive_path, zip_index] : zip_indices)
+          {
+            for(const std::string extension : {".bin", ".mmap", ".json"})
+              {
+                const auto format = get_block_format(name + extension);
+                if(const auto *entry = zip_index.find(name + extension))
+                  {
+                    if(!entry->is_stored())
+                      return {};
+                    result.push_back({archive_path, *entry, format});
+                    found = true;
+                    break;
+                  }
+              }
+            if(found)
+              break;
+          }
+        if(!found)
+          return {};
+      }
+    return result;
+  }
+
   // sdp_block_local in initialized only at comm.Rank() == 0
   // Data from sdp_block_local is sent to DistMatrices in sdp
   void set_sdp_from_root(const El::Grid &grid, const Block_Info &block_info,
@@ -94,6 +252,180 @@ namespace
   }
 }
 
+// Parallel reading of block_data_XXX.mmap files:
+// each rank of the group maps the file and deserializes only
+// the matrix elements that it owns.
+namespace
+{
+  // Region of a file containing block_data_XXX.mmap:
+  // either a plain file or an uncompressed entry of sdp.zip
+  struct Mmap_Block_Region
+  {
+    fs::path path;
+    size_t offset = 0;
+    size_t size = 0;
+  };
+
+  // Returns empty vector unless all blocks are stored in .mmap format
+  std::vector<Mmap_Block_Region>
+  get_mmap_regions(const std::vector<Block_Data_Location> &locations)
+  {
+    std::vector<Mmap_Block_Region> result;
+    for(const auto &location : locations)
+      {
+        if(location.format != Block_File_Format::mmap_bin)
+          return {};
+        result.push_back(
+          {location.archive_path,
+           Zip_Index::get_data_offset(location.archive_path, location.entry),
+           location.entry.uncompressed_size});
+      }
+    return result;
+  }
+
+  // Same for SDP directory.
+  // NB: this should agree with the choice of block_data_XXX file extension
+  // in read_block_data() below.
+  std::vector<Mmap_Block_Region>
+  get_mmap_regions(const fs::path &sdp_dir,
+                   const std::vector<size_t> &block_indices)
+  {
+    std::vector<Mmap_Block_Region> result;
+    for(const auto &block_index : block_indices)
+      {
+        const auto block_path_no_extension
+          = sdp_dir / ("block_data_" + std::to_string(block_index));
+        if(exists(fs::path(block_path_no_extension).replace_extension(".bin")))
+          return {};
+        const auto block_path
+          = fs::path(block_path_no_extension).replace_extension(".mmap");
+        if(!exists(block_path))
+          return {};
+        result.push_back({block_path, 0, fs::file_size(block_path)});
+      }
+    return result;
+  }
+
+  void broadcast_region(Mmap_Block_Region &region, const El::mpi::Comm &comm)
+  {
+    auto path = region.path.string();
+    size_t path_size = path.size();
+    El::mpi::Broadcast(path_size, 0, comm);
+    path.resize(path_size);
+    El::mpi::Broadcast(reinterpret_cast<El::byte *>(path.data()), path_size,
+                       0, comm);
+    region.path = path;
+    El::mpi::Broadcast(region.offset, 0, comm);
+    El::mpi::Broadcast(region.size, 0, comm);
+  }
+
+  void set_local_elements(const Mmap_Block_Format::View &view,
+                          const Mmap_Block_Format::Matrix_Index matrix_index,
+                          El::DistMatrix<El::BigFloat> &matrix)
+  {
+    const auto &header = view.matrix(matrix_index);
+    ASSERT_EQUAL(header.height, matrix.Height(), DEBUG_STRING(matrix_index));
+    ASSERT_EQUAL(header.width, matrix.Width(), DEBUG_STRING(matrix_index));
+    El::BigFloat value;
+    // Elements are stored in column-major order
+    for(int column = 0; column < matrix.LocalWidth(); ++column)
+      for(int row = 0; row < matrix.LocalHeight(); ++row)
+        {
+          view.get(matrix_index, matrix.GlobalRow(row),
+                   matrix.GlobalCol(column), value);
+          matrix.SetLocal(row, column, value);
+        }
+  }
+
+  // Analogous to set_sdp_from_root(), but without communication
+  void set_sdp_from_mmap(const El::Grid &grid, const Block_Info &block_info,
+                         const size_t index,
+                         const Mmap_Block_Format::View &view, SDP &sdp)
+  {
+    namespace Format = Mmap_Block_Format;
+    const size_t block_index = block_info.block_indices.at(index);
+
+    // sdp.primal_objective_c
+    {
+      auto &c(sdp.primal_objective_c.blocks.at(index));
+      c.SetGrid(grid);
+      c.Resize(block_info.get_schur_block_size(block_index), 1);
+      set_local_elements(view, Format::c, c);
+    }
+
+    // sdp.free_var_matrix
+    {
+      auto &B(sdp.free_var_matrix.blocks.at(index));
+      B.SetGrid(grid);
+      // NB: sdp.dual_objective_b must be initialized at this moment!
+      B.Resize(block_info.get_schur_block_size(block_index),
+               sdp.dual_objective_b.Height());
+      set_local_elements(view, Format::B, B);
+    }
+
+    // sdp.bilinear_bases and sdp.bases_blocks
+    // Bilinear bases are small, so each rank reads them completely.
+    for(const size_t parity : {0, 1})
+      {
+        const size_t bilinear_index_local = 2 * index + parity;
+        const auto bilinear_base_local = view.read_matrix(
+          parity == 0 ? Format::bilinear_bases_even
+                      : Format::bilinear_bases_odd);
+        ASSERT_EQUAL(bilinear_base_local.Height(),
+                     block_info.get_bilinear_bases_height(block_index, parity));
+        ASSERT_EQUAL(bilinear_base_local.Width(),
+                     block_info.get_bilinear_bases_width(block_index, parity));
+
+        auto &bilinear_bases = sdp.bilinear_bases.at(bilinear_index_local);
+        bilinear_bases.SetGrid(grid);
+        bilinear_bases.Resize(bilinear_base_local.Height(),
+                              bilinear_base_local.Width());
+        copy_matrix(bilinear_base_local, bilinear_bases);
+
+        auto &bases_block = sdp.bases_blocks.at(bilinear_index_local);
+        bases_block.SetGrid(grid);
+        bases_block.Resize(
+          block_info.get_psd_matrix_block_size(block_index, parity),
+          block_info.get_bilinear_pairing_block_size(block_index, parity));
+        set_bilinear_bases_block(bilinear_base_local, bases_block);
+      }
+  }
+
+  // If all blocks are stored in .mmap format, read them in parallel
+  // on all ranks of the group and return true.
+  // Otherwise, return false.
+  // mmap_regions is initialized only at group root.
+  bool read_mmap_block_data(const El::Grid &grid, const Block_Info &block_info,
+                            std::vector<Mmap_Block_Region> &mmap_regions,
+                            SDP &sdp, Timers &timers)
+  {
+    const auto &comm = grid.Comm();
+    const size_t num_blocks = block_info.block_indices.size();
+
+    int use_mmap = mmap_regions.size() == num_blocks ? 1 : 0;
+    El::mpi::Broadcast(use_mmap, 0, comm);
+    if(use_mmap == 0)
+      return false;
+
+    mmap_regions.resize(num_blocks);
+    for(size_t index = 0; index < num_blocks; ++index)
+      {
+        Scoped_Timer count_timer(timers, std::to_string(index));
+        auto &region = mmap_regions.at(index);
+        {
+          Scoped_Timer sync_timer(timers, "synchronize");
+          broadcast_region(region, comm);
+        }
+        Scoped_Timer parse_timer(timers, "parse_local");
+        const Memory_Mapped_File file(region.path, region.offset,
+                                      region.size);
+        const Mmap_Block_Format::View view(file.data(), file.size());
+        set_sdp_from_mmap(grid, block_info, index, view, sdp);
+      }
+    return true;
+  }
+}
+
 void read_block_data(const fs::path &sdp_path, const El::Grid &grid,
                      const Block_Info &block_info, SDP &sdp, Timers &timers)
 {
@@ -129,9 +461,35 @@ void read_block_data(const fs::path &sdp_path, const El::Grid &grid,
         return index_it->second;
       };
 
-      std::unique_ptr<Archive_Reader> reader;
+      // Initialized on root only
+      std::vector<std::pair<fs::path, size_t>> archives;
+      if(comm.Rank() == 0)
+        {
+          Scoped_Timer archives_timer(timers, "get_block_data_archives");
+          archives
+            = get_block_data_archives(sdp_path, block_info.block_indices);
+        }
+      // Initialized on root only.
+      // Empty if random access is not possible.
+      std::vector<Block_Data_Location> locations;
+      if(comm.Rank() == 0)
+        {
+          Scoped_Timer locations_timer(timers, "get_block_data_locations");
+          locations = get_block_data_locations(archives,
+                                               block_info.block_indices);
+        }
+
+      // Initialized on root only
+      std::vector<Mmap_Block_Region> mmap_regions;
       if(comm.Rank() == 0)
-        reader = std::make_unique<Archive_Reader>(sdp_path);
+        mmap_regions = get_mmap_regions(locations);
+      if(read_mmap_block_data(grid, block_info, mmap_regions, sdp, timers))
+        return;
+
+      auto archive_it = archives.begin();
+      // Number of remaining blocks in the current archive
+      size_t num_blocks_left_in_archive = 0;
+      std::unique_ptr<Archive_Reader> reader;
 
       for(size_t processed_count = 0; processed_count < num_blocks;
           ++processed_count)
@@ -141,11 +499,49 @@ void read_block_data(const fs::path &sdp_path, const El::Grid &grid,
           // Initialized on root only
           SDP_Block_Data sdp_block_local;
 
-          if(comm.Rank() == 0)
+          if(comm.Rank() == 0 && !locations.empty())
+            {
+              Scoped_Timer parse_timer(timers, "parse");
+              const auto &location = locations.at(processed_count);
+              if(location.format == Block_File_Format::mmap_bin)
+                {
+                  const Memory_Mapped_File file(
+                    location.archive_path,
+                    Zip_Index::get_data_offset(location.archive_path,
+                                               location.entry),
+                    location.entry.uncompressed_size);
+                  sdp_block_local = SDP_Block_Data(
+                    file.data(), file.size(), processed_count, block_info);
+                }
+              else
+                {
+                  Zip_Entry_Reader entry_reader(location.archive_path,
+                                                location.entry);
+                  std::istream stream(&entry_reader);
+                  sdp_block_local = SDP_Block_Data(
+                    stream, location.format, processed_count, block_info);
+                }
+            }
+          else if(comm.Rank() == 0)
             {
               // Find and read next entry with one of the block indices required
-              while(reader->next_entry())
+              while(archive_it != archives.end())
                 {
+                  if(reader == nullptr)
+                    {
+                      reader = std::make_unique<Archive_Reader>(
+                        archive_it->first);
+                      num_blocks_left_in_archive = archive_it->second;
+                    }
+                  // Move to the next archive if we have read all our blocks
+                  // from the current one, without scanning the rest of it.
+                  if(num_blocks_left_in_archive == 0 || !reader->next_entry())
+                    {
+                      reader.reset();
+                      ++archive_it;
+                      continue;
+                    }
+
                   const fs::path curr_block_path
                     = archive_entry_pathname(reader->entry_ptr);
                   int index = get_index(curr_block_path);
@@ -157,6 +553,7 @@ void read_block_data(const fs::path &sdp_path, const El::Grid &grid,
                   std::istream stream(reader.get());
                   sdp_block_local
                     = SDP_Block_Data(stream, format, index, block_info);
+                  --num_blocks_left_in_archive;
                   break;
                 }
             }
@@ -167,6 +564,13 @@ void read_block_data(const fs::path &sdp_path, const El::Grid &grid,
     }
   else
     {
+      // Initialized on root only
+      std::vector<Mmap_Block_Region> mmap_regions;
+      if(comm.Rank() == 0)
+        mmap_regions = get_mmap_regions(sdp_path, block_info.block_indices);
+      if(read_mmap_block_data(grid, block_info, mmap_regions, sdp, timers))
+        return;
+
       for(size_t index(0); index != num_blocks; ++index)
         {
           Scoped_Timer count_timer(timers, std::to_string(index));
@@ -182,14 +586,25 @@ void read_block_data(const fs::path &sdp_path, const El::Grid &grid,
                 / ("block_data_"
                    + std::to_string(block_info.block_indices.at(index))
                    + ".bin"));
+              if(!exists(block_path))
+                block_path.replace_extension(".mmap");
               if(!exists(block_path))
                 block_path.replace_extension(".json");
               ASSERT(exists(block_path), "Block not found: ", block_path);
 
               Block_File_Format format = get_block_format(block_path);
-              std::ifstream block_stream(block_path, std::ios::binary);
-              sdp_block_local
-                = SDP_Block_Data(block_stream, format, index, block_info);
+              if(format == Block_File_Format::mmap_bin)
+                {
+                  const Memory_Mapped_File file(block_path);
+                  sdp_block_local = SDP_Block_Data(file.data(), file.size(),
+                                                   index, block_info);
+                }
+              else
+                {
+                  std::ifstream block_stream(block_path, std::ios::binary);
+                  sdp_block_local
+                    = SDP_Block_Data(block_stream, format, index, block_info);
+                }
             }
 
           Scoped_Timer sync_timer(timers, "synchronize");
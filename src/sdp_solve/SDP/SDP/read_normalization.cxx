@@ -1,4 +1,5 @@
 #include "sdp_solve/Archive_Reader.hxx"
+#include "sdp_solve/Zip_Index.hxx"
 #include "sdpb_util/assert.hxx"
 #include "sdpb_util/Timers/Timers.hxx"
 
@@ -38,6 +39,21 @@ read_normalization(const fs::path &sdp_path, Timers &timers)
   const std::string normalization_name("normalization.json");
   if(is_regular_file(sdp_path))
     {
+      // normalization.json may be absent,
+      // and scanning the whole archive to find it out can be slow.
+      if(const auto zip_index = Zip_Index::try_read(sdp_path);
+         zip_index.has_value())
+        {
+          const auto *entry = zip_index->find(normalization_name);
+          if(entry == nullptr)
+            return {};
+          if(entry->is_stored())
+            {
+              Zip_Entry_Reader entry_reader(sdp_path, *entry);
+              std::istream stream(&entry_reader);
+              return read_normalization_stream(stream);
+            }
+        }
       Archive_Reader reader(sdp_path);
       while(reader.next_entry())
         {
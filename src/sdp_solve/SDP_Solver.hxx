@@ -76,11 +76,29 @@ public:
   int64_t current_generation;
   boost::optional<int64_t> backup_generation;
 
+  // Number of completed iterations.
+  // run() continues from here after blocks are redistributed.
+  int64_t num_iterations = 0;
+  // Step lengths from the last completed iteration.
+  // Used for termination checks and feasible jump detection
+  // when run() continues after blocks are redistributed.
+  El::BigFloat primal_step_length = 0, dual_step_length = 0;
+
   SDP_Solver(const Solver_Parameters &parameters, const Verbosity &verbosity,
              const bool &require_initial_checkpoint,
              const Block_Info &block_info, const El::Grid &grid,
              const size_t &dual_objective_b_height);
 
+  // Move solver state to a new block mapping (see rebalanceThreshold).
+  // x, X, y, Y and solver status are copied, residues are recomputed
+  // by run() anyway.
+  // dual_objective_b_height = N is passed explicitly,
+  // since the current rank may own no blocks of y.
+  // Collective operation on COMM_WORLD.
+  SDP_Solver(const SDP_Solver &solver, const Block_Info &old_block_info,
+             const Block_Info &new_block_info, const El::Grid &new_grid,
+             const size_t &dual_objective_b_height);
+
   SDP_Solver_Terminate_Reason
   run(const Environment &env, const Solver_Parameters &parameters,
       const Verbosity &verbosity,
@@ -0,0 +1,185 @@
+#include "../SDP_Solver.hxx"
+#include "sdpb_util/assert.hxx"
+#include "sdpb_util/copy_matrix.hxx"
+
+#include <limits>
+#include <map>
+
+namespace
+{
+  // Global indices of local blocks.
+  // X and Y have two blocks (even and odd parity) for each SDP block.
+  std::vector<size_t> global_indices(const std::vector<size_t> &block_indices,
+                                     const size_t blocks_per_index)
+  {
+    std::vector<size_t> result;
+    for(const auto block_index : block_indices)
+      for(size_t parity = 0; parity < blocks_per_index; ++parity)
+        result.push_back(blocks_per_index * block_index + parity);
+    return result;
+  }
+
+  // For each block, find global rank of the process
+  // holding its element (0,0), i.e. DistRank() = 0.
+  std::vector<int>
+  block_roots(const std::vector<El::DistMatrix<El::BigFloat>> &blocks,
+              const std::vector<size_t> &indices, const size_t num_blocks)
+  {
+    ASSERT_EQUAL(blocks.size(), indices.size());
+    std::vector<int> result(num_blocks, 0);
+    for(size_t local = 0; local < blocks.size(); ++local)
+      {
+        if(blocks.at(local).DistRank() == 0)
+          result.at(indices.at(local)) = El::mpi::Rank();
+      }
+    El::mpi::AllReduce(result.data(), result.size(), El::mpi::SUM,
+                       El::mpi::COMM_WORLD);
+    return result;
+  }
+
+  // Copy blocks from the old mapping to the new one.
+  // For each block:
+  // 1. Old group gathers the block and its root sends it to the new root.
+  // 2. New root distributes the block among the new group.
+  // All ranks loop over blocks in the same order, which prevents deadlocks.
+  void redistribute_blocks(
+    const std::vector<El::DistMatrix<El::BigFloat>> &old_blocks,
+    const std::vector<size_t> &old_block_indices,
+    std::vector<El::DistMatrix<El::BigFloat>> &new_blocks,
+    const std::vector<size_t> &new_block_indices, const size_t num_sdp_blocks,
+    const size_t blocks_per_index)
+  {
+    // NB: a rank may own no blocks, thus we cannot deduce blocks_per_index
+    // from old_blocks.size()
+    ASSERT_EQUAL(old_blocks.size(),
+                 old_block_indices.size() * blocks_per_index);
+    ASSERT_EQUAL(new_blocks.size(),
+                 new_block_indices.size() * blocks_per_index);
+    const size_t num_blocks = num_sdp_blocks * blocks_per_index;
+
+    const auto old_indices
+      = global_indices(old_block_indices, blocks_per_index);
+    const auto new_indices
+      = global_indices(new_block_indices, blocks_per_index);
+    const auto old_roots = block_roots(old_blocks, old_indices, num_blocks);
+    const auto new_roots = block_roots(new_blocks, new_indices, num_blocks);
+
+    std::map<size_t, size_t> old_local, new_local;
+    for(size_t local = 0; local < old_indices.size(); ++local)
+      old_local.emplace(old_indices.at(local), local);
+    for(size_t local = 0; local < new_indices.size(); ++local)
+      new_local.emplace(new_indices.at(local), local);
+
+    const auto &comm = El::mpi::COMM_WORLD;
+    const int rank = comm.Rank();
+    const size_t serialized_size = El::BigFloat(0).SerializedSize();
+    std::vector<El::byte> buffer;
+    for(size_t index = 0; index < num_blocks; ++index)
+      {
+        const int from = old_roots.at(index);
+        const int to = new_roots.at(index);
+
+        El::Matrix<El::BigFloat> matrix;
+        if(auto old_it = old_local.find(index); old_it != old_local.end())
+          {
+            const El::DistMatrix<El::BigFloat, El::STAR, El::STAR> block_star(
+              old_blocks.at(old_it->second));
+            if(rank == from)
+              copy_matrix(block_star, matrix);
+          }
+
+        if(from != to && (rank == from || rank == to))
+          {
+            // NB: old root may not own the block in the new mapping
+            if(rank == to)
+              {
+                const auto &new_block = new_blocks.at(new_local.at(index));
+                matrix.Resize(new_block.Height(), new_block.Width());
+              }
+            const size_t num_bytes
+              = matrix.Height() * matrix.Width() * serialized_size;
+            ASSERT(num_bytes <= std::numeric_limits<int>::max(),
+                   "Block is too large to send: ", DEBUG_STRING(index),
+                   DEBUG_STRING(num_bytes));
+            buffer.resize(num_bytes);
+            if(rank == from)
+              {
+                auto *curr = buffer.data();
+                for(El::Int j = 0; j < matrix.Width(); ++j)
+                  for(El::Int i = 0; i < matrix.Height(); ++i)
+                    {
+                      matrix.Get(i, j).Serialize(curr);
+                      curr += serialized_size;
+                    }
+                El::mpi::Send(buffer.data(), buffer.size(), to, comm);
+              }
+            else
+              {
+                El::mpi::Recv(buffer.data(), buffer.size(), from, comm);
+                const auto *curr = buffer.data();
+                El::BigFloat value;
+                for(El::Int j = 0; j < matrix.Width(); ++j)
+                  for(El::Int i = 0; i < matrix.Height(); ++i)
+                    {
+                      value.Deserialize(curr);
+                      curr += serialized_size;
+                      matrix.Set(i, j, value);
+                    }
+              }
+          }
+
+        if(auto new_it = new_local.find(index); new_it != new_local.end())
+          {
+            auto &new_block = new_blocks.at(new_it->second);
+            copy_matrix_from_root(matrix, new_block, new_block.DistComm());
+          }
+      }
+  }
+}
+
+SDP_Solver::SDP_Solver(const SDP_Solver &solver,
+                       const Block_Info &old_block_info,
+                       const Block_Info &new_block_info,
+                       const El::Grid &new_grid,
+                       const size_t &dual_objective_b_height)
+    : x(new_block_info.schur_block_sizes(), new_block_info.block_indices,
+        new_block_info.num_points.size(), new_grid),
+      X(new_block_info.psd_matrix_block_sizes(), new_block_info.block_indices,
+        new_block_info.num_points.size(), new_grid),
+      y(std::vector<size_t>(new_block_info.num_points.size(),
+                            dual_objective_b_height),
+        new_block_info.block_indices, new_block_info.num_points.size(),
+        new_grid),
+      Y(X),
+      primal_objective(solver.primal_objective),
+      dual_objective(solver.dual_objective),
+      duality_gap(solver.duality_gap),
+      primal_residues(X),
+      primal_error_P(solver.primal_error_P),
+      primal_error_p(solver.primal_error_p),
+      dual_residues(new_block_info.schur_block_sizes(),
+                    new_block_info.block_indices,
+                    new_block_info.num_points.size(), new_grid),
+      dual_error(solver.dual_error),
+      R_error(solver.R_error),
+      current_generation(solver.current_generation),
+      backup_generation(solver.backup_generation),
+      num_iterations(solver.num_iterations),
+      primal_step_length(solver.primal_step_length),
+      dual_step_length(solver.dual_step_length)
+{
+  ASSERT_EQUAL(old_block_info.num_points.size(),
+               new_block_info.num_points.size());
+  const size_t num_sdp_blocks = new_block_info.num_points.size();
+  const auto &old_indices = old_block_info.block_indices;
+  const auto &new_indices = new_block_info.block_indices;
+
+  redistribute_blocks(solver.x.blocks, old_indices, x.blocks, new_indices,
+                      num_sdp_blocks, 1);
+  redistribute_blocks(solver.X.blocks, old_indices, X.blocks, new_indices,
+                      num_sdp_blocks, 2);
+  redistribute_blocks(solver.y.blocks, old_indices, y.blocks, new_indices,
+                      num_sdp_blocks, 1);
+  redistribute_blocks(solver.Y.blocks, old_indices, Y.blocks, new_indices,
+                      num_sdp_blocks, 2);
+}
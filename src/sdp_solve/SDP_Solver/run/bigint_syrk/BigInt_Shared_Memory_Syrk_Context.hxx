@@ -5,8 +5,10 @@
 #include "fmpz/Fmpz_Comb.hxx"
 #include "Block_Residue_Matrices_Window.hxx"
 #include "Residue_Matrices_Window.hxx"
+#include "sdpb_util/Dtlb_Miss_Counter.hxx"
 #include "sdpb_util/Timers/Timers.hxx"
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -14,18 +16,26 @@
 class BigInt_Shared_Memory_Syrk_Context : boost::noncopyable
 {
 public:
+  // node_index and procs_per_node describe the node layout
+  // (i.e. all shared memory communicators),
+  // see Environment::node_index() and Environment::procs_per_node().
   BigInt_Shared_Memory_Syrk_Context(
-    const El::mpi::Comm &shared_memory_comm, size_t group_index,
+    const El::mpi::Comm &shared_memory_comm, int node_index,
+    const std::vector<size_t> &procs_per_node, size_t group_index,
     const std::vector<int> &group_comm_sizes, mp_bitcnt_t precision,
     size_t max_shared_memory_bytes,
     const std::vector<El::Int> &blocks_height_per_group, int block_width,
     const std::vector<size_t> &block_index_local_to_global,
+    const std::vector<std::vector<El::Range<El::Int>>> &block_nonzero_columns,
     Verbosity verbosity,
     const std::function<Blas_Job_Schedule(
       Blas_Job::Kind kind, El::UpperOrLower uplo, size_t num_ranks,
       size_t num_primes, int output_height, int output_width,
       Verbosity _verbosity)> &create_job_schedule
-    = create_blas_job_schedule);
+    = create_blas_job_schedule,
+    bool dynamic_blas_jobs = false, bool numa_aware_windows = false,
+    bool huge_pages = false, bool pipeline_windows = false,
+    std::optional<int> numa_node = std::nullopt);
 
   // Calculate Q := P^T P
   //
@@ -45,12 +55,26 @@ public:
   //
   // If you want to square arbitrary BigFloat matrix P,
   // then use Matrix_Normalizer before and after calling this bigint_syrk_blas()
+  //
+  // Columns of P outside of block_nonzero_columns (passed to the constructor)
+  // must be zero in all blocks, otherwise Q will be wrong.
   void bigint_syrk_blas(El::UpperOrLower uplo,
                         const std::vector<El::DistMatrix<El::BigFloat>>
                           &bigint_input_matrix_blocks,
                         El::DistMatrix<El::BigFloat> &bigint_output,
                         Timers &timers, El::Matrix<int32_t> &block_timings_ms);
 
+  // Number of NUMA segments of the residue windows
+  // (1 if numa_aware_windows=false), see Shared_Window_Array.
+  [[nodiscard]] size_t num_numa_segments() const;
+  // True if the windows are split
+  // (i.e. the node's P or Q does not fit into shared memory at once).
+  [[nodiscard]] bool is_split() const;
+  // True if the windows are pipelined, see bigint_syrk_blas_pipelined().
+  // Can be false even if pipeline_windows=true was requested,
+  // e.g. if the windows are not split on any node.
+  [[nodiscard]] bool is_pipelined() const;
+
 private:
   El::mpi::Comm shared_memory_comm;
   // Index of MPI group on a node
@@ -59,6 +83,11 @@ private:
   const std::vector<int> &group_comm_sizes;
   // Number of MPI groups on a node
   size_t num_groups;
+  // COMM_WORLD ranks of each node, ordered by their rank within a node.
+  // Used in restore_and_reduce().
+  std::vector<std::vector<int>> node_ranks;
+  // Index of the current node in node_ranks
+  size_t node_index;
   int total_block_height_per_node;
   Fmpz_Comb comb;
   const Verbosity verbosity;
@@ -68,6 +97,13 @@ private:
     input_grouped_block_residues_window_A;
   std::unique_ptr<Block_Residue_Matrices_Window<double>>
     input_grouped_block_residues_window_B;
+  // Second set of input windows, used if pipeline_windows=true.
+  // Residues for the next step are written there while BLAS jobs
+  // of the current step read from window_A (and window_B).
+  std::unique_ptr<Block_Residue_Matrices_Window<double>>
+    input_grouped_block_residues_window_A_next;
+  std::unique_ptr<Block_Residue_Matrices_Window<double>>
+    input_grouped_block_residues_window_B_next;
   // How many times we should fill input window
   // to process all blocks:
   // (should be same for all ranks)
@@ -83,11 +119,60 @@ private:
   std::map<std::tuple<Blas_Job::Kind, El::UpperOrLower, El::Int, El::Int>,
            std::shared_ptr<Blas_Job_Schedule>>
     blas_job_schedule_cache;
+  // If true, ranks pull BLAS jobs from a shared counter
+  // in Blas_Job_Schedule::jobs_by_priority order
+  // instead of executing static Blas_Job_Schedule::jobs_by_rank.
+  const bool dynamic_blas_jobs;
+  // If true, residue windows are split into per-NUMA-node segments
+  // (see Shared_Window_Array), and each BLAS job is pulled first
+  // by ranks on the NUMA node holding its prime's residues.
+  // Implies dynamic_blas_jobs.
+  // NUMA node of the current rank can be overridden by the numa_node
+  // constructor argument, e.g. to emulate several NUMA nodes in tests.
+  const bool numa_aware_windows;
+  // For each NUMA segment of the output window (single segment if
+  // numa_aware_windows=false): index of the next job in the segment's list.
+  // Used if dynamic_blas_jobs=true or numa_aware_windows=true.
+  std::unique_ptr<Shared_Window_Array<std::atomic<size_t>>>
+    blas_job_counter_window;
+  // Value of each counter in blas_job_counter_window
+  // at the beginning of the next BLAS call (same on all ranks),
+  // so that the counters need not be reset, see do_blas_jobs().
+  std::vector<size_t> blas_job_counter_offsets;
+  // If true, residue windows are backed by transparent huge pages
+  // (if available), see Shared_Window_Array.
+  const bool huge_pages;
+  // Huge page usage is reported once, after the windows are touched
+  bool huge_pages_reported = false;
+  // Data TLB misses during BLAS jobs, to see the effect of huge pages.
+  // Created once, only if huge_pages=true.
+  std::unique_ptr<Dtlb_Miss_Counter> dtlb_miss_counter;
+  // If true, input windows are double-buffered, and residues for the next
+  // (Q_IJ, input split) step are computed without waiting for other ranks
+  // to finish BLAS jobs or restore_and_reduce() for the current step,
+  // see bigint_syrk_blas_pipelined().
+  // Set to false if the windows are not split
+  // or there is not enough memory for the second set of input windows.
+  bool pipeline_windows;
+  // Number of P columns that are nonzero on the node, before a given column:
+  // column j of P has nonzero elements iff
+  // nonzero_columns_prefix_sum[j+1] > nonzero_columns_prefix_sum[j].
+  // Columns that are zero on all node's blocks are skipped
+  // when computing residues and doing BLAS jobs.
+  // The sparsity pattern of P is fixed by the SDP,
+  // so we compute it once in the constructor.
+  std::vector<El::Int> nonzero_columns_prefix_sum;
 
   [[nodiscard]] std::shared_ptr<Blas_Job_Schedule>
   get_blas_job_schedule(Blas_Job::Kind kind, El::UpperOrLower uplo,
                         El::Int output_height, El::Int output_width);
 
+  void find_nonzero_columns(
+    const std::vector<std::vector<El::Range<El::Int>>> &block_nonzero_columns,
+    El::Int width);
+  [[nodiscard]] bool
+  has_nonzero_columns(const El::Range<El::Int> &columns) const;
+
   void clear_residues(const Blas_Job_Schedule &blas_job_schedule);
   void compute_block_residues(
     Block_Residue_Matrices_Window<double> &grouped_block_residues_window,
@@ -95,15 +180,34 @@ private:
     El::Int skip_rows, El::Range<El::Int> col_range, Timers &timers,
     El::Matrix<int32_t> &block_timings_ms);
 
+  void compute_submatrix_residues(
+    const std::vector<El::DistMatrix<El::BigFloat>> &bigint_input_matrix_blocks,
+    size_t input_split_index, const El::Range<El::Int> &output_I,
+    const El::Range<El::Int> &output_J, Timers &timers,
+    El::Matrix<int32_t> &block_timings_ms);
+  void multiply_submatrix_residues(
+    El::UpperOrLower uplo, const Blas_Job_Schedule &blas_job_schedule,
+    const std::vector<El::DistMatrix<El::BigFloat>> &bigint_input_matrix_blocks,
+    const El::Range<El::Int> &output_I, const El::Range<El::Int> &output_J,
+    bool overwrite_output, bool fence_output, Timers &timers,
+    El::Matrix<int32_t> &block_timings_ms);
+
   void bigint_syrk_blas_shmem_submatrix(
     El::UpperOrLower uplo,
     const std::vector<El::DistMatrix<El::BigFloat>> &bigint_input_matrix_blocks,
     const El::Range<El::Int> &output_I, const El::Range<El::Int> &output_J,
     Timers &timers, El::Matrix<int32_t> &block_timings_ms);
+  void bigint_syrk_blas_pipelined(
+    El::UpperOrLower uplo,
+    const std::vector<El::DistMatrix<El::BigFloat>> &bigint_input_matrix_blocks,
+    El::DistMatrix<El::BigFloat> &bigint_output, Timers &timers,
+    El::Matrix<int32_t> &block_timings_ms);
 
   void
   restore_and_reduce(std::optional<El::UpperOrLower> uplo,
                      El::DistMatrix<El::BigFloat> &output, Timers &timers);
 
+  void report_huge_pages(Timers &timers);
+
   [[nodiscard]] El::Int input_group_height_per_prime() const;
 };
@@ -38,20 +38,38 @@ namespace
     return std::ceil(static_cast<double>(x) / static_cast<double>(y));
   }
 
+  // Ranks of each node (in COMM_WORLD), ordered by their rank within a node,
+  // for the node layout given by Environment::node_index()
+  // and Environment::procs_per_node().
+  std::vector<std::vector<int>>
+  get_node_ranks(const El::mpi::Comm &shared_memory_comm, const int node_index,
+                 const std::vector<size_t> &procs_per_node)
+  {
+    const El::mpi::Comm comm = El::mpi::COMM_WORLD;
+    std::vector<int> node_index_by_rank(comm.Size());
+    El::mpi::AllGather(&node_index, 1, node_index_by_rank.data(), 1, comm);
+
+    // Shared memory communicator preserves the order of COMM_WORLD ranks
+    std::vector<std::vector<int>> node_ranks(procs_per_node.size());
+    for(int rank = 0; rank < comm.Size(); ++rank)
+      node_ranks.at(node_index_by_rank.at(rank)).push_back(rank);
+    for(size_t node = 0; node < node_ranks.size(); ++node)
+      ASSERT_EQUAL(node_ranks.at(node).size(), procs_per_node.at(node),
+                   DEBUG_STRING(node));
+    ASSERT_EQUAL(node_ranks.at(node_index).at(shared_memory_comm.Rank()),
+                 comm.Rank());
+    return node_ranks;
+  }
+
   // Estimate total MPI buffer sizes on a node for restore_and_reduce()
   size_t
   get_reduce_scatter_buffer_bytes(const El::mpi::Comm &shared_memory_comm,
+                                  const size_t max_node_size,
                                   const size_t window_width,
                                   const size_t split_factor)
   {
-    ASSERT(El::mpi::Size() % shared_memory_comm.Size() == 0,
-           "All nodes should have the same number of ranks! ",
-           DEBUG_STRING(El::mpi::Size()),
-           DEBUG_STRING(shared_memory_comm.Size()));
-    auto num_nodes = El::mpi::Size() / shared_memory_comm.Size();
-
     // no reduce-scatter => no RAM needed
-    if(num_nodes == 1)
+    if(shared_memory_comm.Size() == El::mpi::Size())
       return 0;
 
     // Total number of elements in Q submatrix
@@ -62,9 +80,12 @@ namespace
                                   : window_width * window_width;
     const size_t bigfloat_bytes = El::BigFloat(1.1).SerializedSize();
 
-    // Each rank needs ~(num_elements/num_ranks) buffer for MPI_Send
-    // and the same for MPI_Recv
-    return 2 * div_ceil(num_elements, num_nodes) * bigfloat_bytes;
+    // Each rank needs ~(num_elements/num_ranks) buffer for MPI_Recv.
+    // For MPI_Send, the node needs buffers for all elements owned by
+    // another node, which can be larger if nodes have different sizes.
+    return div_ceil(num_elements * (shared_memory_comm.Size() + max_node_size),
+                    El::mpi::Size())
+           * bigfloat_bytes;
   }
 
   [[nodiscard]] bool calculate_input_window_split(
@@ -111,27 +132,42 @@ namespace
 }
 
 BigInt_Shared_Memory_Syrk_Context::BigInt_Shared_Memory_Syrk_Context(
-  const El::mpi::Comm &shared_memory_comm, const size_t group_index,
+  const El::mpi::Comm &shared_memory_comm, const int node_index,
+  const std::vector<size_t> &procs_per_node, const size_t group_index,
   const std::vector<int> &group_comm_sizes, const mp_bitcnt_t precision,
   size_t max_shared_memory_bytes,
   const std::vector<El::Int> &blocks_height_per_group, const int block_width,
   const std::vector<size_t> &block_index_local_to_global,
+  const std::vector<std::vector<El::Range<El::Int>>> &block_nonzero_columns,
   const Verbosity verbosity,
   const std::function<Blas_Job_Schedule(
     Blas_Job::Kind kind, El::UpperOrLower uplo, size_t num_ranks,
     size_t num_primes, int output_height, int output_width,
-    Verbosity _verbosity)> &create_job_schedule)
+    Verbosity _verbosity)> &create_job_schedule,
+  const bool dynamic_blas_jobs, const bool numa_aware_windows,
+  const bool huge_pages, const bool pipeline_windows,
+  const std::optional<int> numa_node)
     : shared_memory_comm(shared_memory_comm),
       group_index(group_index),
       group_comm_sizes(group_comm_sizes),
       num_groups(group_comm_sizes.size()),
+      node_ranks(get_node_ranks(shared_memory_comm, node_index,
+                                procs_per_node)),
+      node_index(node_index),
       total_block_height_per_node(sum(blocks_height_per_group)),
       comb(precision, precision, 1, total_block_height_per_node),
       verbosity(verbosity),
       block_index_local_to_global(block_index_local_to_global),
-      create_blas_job_schedule_func(create_job_schedule)
+      create_blas_job_schedule_func(create_job_schedule),
+      dynamic_blas_jobs(dynamic_blas_jobs),
+      numa_aware_windows(numa_aware_windows),
+      huge_pages(huge_pages),
+      pipeline_windows(pipeline_windows)
 {
   ASSERT_EQUAL(blocks_height_per_group.size(), num_groups);
+  ASSERT_EQUAL(block_nonzero_columns.size(),
+               block_index_local_to_global.size());
+  find_nonzero_columns(block_nonzero_columns, block_width);
 
   std::vector<int> input_window_height_per_group_per_prime(num_groups);
   size_t window_width;
@@ -140,6 +176,62 @@ BigInt_Shared_Memory_Syrk_Context::BigInt_Shared_Memory_Syrk_Context(
     max_shared_memory_bytes = std::numeric_limits<size_t>::max();
 
   size_t reduce_scatter_buffer_bytes;
+  // Nodes can have different number of ranks
+  const size_t max_node_size
+    = *std::max_element(procs_per_node.begin(), procs_per_node.end());
+
+  size_t output_window_bytes;
+  size_t max_input_window_bytes = 0;
+  size_t residues_bytes_per_single_block_row = 0;
+
+  // Try to fit all shared windows into memory
+  // for the current output_window_split_factor,
+  // using num_input_buffers sets of input windows
+  // (two sets if the windows are pipelined, see bigint_syrk_blas_pipelined()).
+  // Returns true if there is enough memory on all nodes.
+  const auto try_split_windows = [&](const size_t num_input_buffers) {
+    window_width = block_width / output_window_split_factor
+                   + (block_width % output_window_split_factor == 0 ? 0 : 1);
+
+    output_window_bytes
+      = window_size_bytes(window_width, window_width, comb.num_primes);
+
+    reduce_scatter_buffer_bytes = get_reduce_scatter_buffer_bytes(
+      shared_memory_comm, max_node_size, window_width,
+      output_window_split_factor);
+
+    El::byte is_enough_memory = false;
+    if(output_window_bytes + reduce_scatter_buffer_bytes
+       < max_shared_memory_bytes)
+      {
+        // Try to find minimal input_window_split_factor
+
+        max_input_window_bytes = max_shared_memory_bytes
+                                 - output_window_bytes
+                                 - reduce_scatter_buffer_bytes;
+        max_input_window_bytes /= num_input_buffers;
+        // If output window is split, we need two (same-size) input windows
+        // to calculate off-diagonal Q blocks
+        if(output_window_split_factor > 1)
+          max_input_window_bytes /= 2;
+
+        residues_bytes_per_single_block_row
+          = window_width * comb.num_primes * sizeof(double);
+        const size_t max_input_window_height
+          = max_input_window_bytes / residues_bytes_per_single_block_row;
+
+        is_enough_memory = calculate_input_window_split(
+          blocks_height_per_group, max_input_window_height,
+          input_window_height_per_group_per_prime, input_window_split_factor);
+      }
+
+    // output_window_split_factor should be the same for all nodes,
+    // because we need global reduce-scatter for each output submatrix.
+    // Thus, we require that is_enough_memory=true on all nodes.
+    is_enough_memory = El::mpi::AllReduce(
+      is_enough_memory, El::mpi::LOGICAL_AND, El::mpi::COMM_WORLD);
+    return is_enough_memory != 0;
+  };
 
   // Each extra split for output window leads to more reduce-scatter calls.
   // Thus, we try to find minimal output_window_split_factor
@@ -149,43 +241,7 @@ BigInt_Shared_Memory_Syrk_Context::BigInt_Shared_Memory_Syrk_Context(
   for(output_window_split_factor = 1;
       output_window_split_factor <= block_width; ++output_window_split_factor)
     {
-      window_width = block_width / output_window_split_factor
-                     + (block_width % output_window_split_factor == 0 ? 0 : 1);
-
-      const auto output_window_bytes
-        = window_size_bytes(window_width, window_width, comb.num_primes);
-
-      reduce_scatter_buffer_bytes = get_reduce_scatter_buffer_bytes(
-        shared_memory_comm, window_width, output_window_split_factor);
-      if(output_window_bytes + reduce_scatter_buffer_bytes
-         >= max_shared_memory_bytes)
-        continue;
-
-      // Try to find minimal input_window_split_factor
-
-      auto max_input_window_bytes = max_shared_memory_bytes
-                                    - output_window_bytes
-                                    - reduce_scatter_buffer_bytes;
-      // If output window is split, we need two (same-size) input windows
-      // to calculate off-diagonal Q blocks
-      if(output_window_split_factor > 1)
-        max_input_window_bytes /= 2;
-
-      const size_t residues_bytes_per_single_block_row
-        = window_width * comb.num_primes * sizeof(double);
-      const size_t max_input_window_height
-        = max_input_window_bytes / residues_bytes_per_single_block_row;
-
-      El::byte is_enough_memory = calculate_input_window_split(
-        blocks_height_per_group, max_input_window_height,
-        input_window_height_per_group_per_prime, input_window_split_factor);
-
-      // output_window_split_factor should be the same for all nodes,
-      // because we need global reduce-scatter for each output submatrix.
-      // Thus, we require that is_enough_memory=true on all nodes.
-      is_enough_memory = El::mpi::AllReduce(
-        is_enough_memory, El::mpi::LOGICAL_AND, El::mpi::COMM_WORLD);
-      if(is_enough_memory)
+      if(try_split_windows(1))
         break;
       // We tried maximal split factor, but still failed to fit:
       if(output_window_split_factor == block_width)
@@ -206,6 +262,31 @@ BigInt_Shared_Memory_Syrk_Context::BigInt_Shared_Memory_Syrk_Context(
         }
     }
 
+  // Pipelining makes sense only if the windows are split.
+  // We keep output_window_split_factor and allocate the second set
+  // of input windows at the cost of larger input_window_split_factor.
+  if(this->pipeline_windows)
+    {
+      const El::byte is_split = El::mpi::AllReduce(
+        El::byte(this->is_split()), El::mpi::LOGICAL_OR, El::mpi::COMM_WORLD);
+      if(!is_split)
+        {
+          this->pipeline_windows = false;
+        }
+      else if(!try_split_windows(2))
+        {
+          if(verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
+            {
+              PRINT_WARNING("BigInt_Shared_Memory_Syrk_Context: not enough "
+                            "shared memory for double-buffered input "
+                            "windows, pipelining is disabled.");
+            }
+          this->pipeline_windows = false;
+          const bool is_enough_memory = try_split_windows(1);
+          ASSERT(is_enough_memory);
+        }
+    }
+
   ASSERT(output_window_split_factor > 0);
   ASSERT(input_window_split_factor > 0);
 
@@ -300,7 +381,10 @@ BigInt_Shared_Memory_Syrk_Context::BigInt_Shared_Memory_Syrk_Context(
 
       El::BuildStream(os, "  Input residues window (P):\n");
       El::BuildStream(os, "    Number of windows: ",
-                      output_window_split_factor == 1 ? 1 : 2, "\n");
+                      (output_window_split_factor == 1 ? 1 : 2)
+                        * (this->pipeline_windows ? 2 : 1),
+                      "\n");
+      El::BuildStream(os, "    Pipelined: ", this->pipeline_windows, "\n");
       El::BuildStream(
         os, "    Window size: ",
         pretty_print_bytes(window_size_bytes(input_window_height, window_width,
@@ -327,12 +411,14 @@ BigInt_Shared_Memory_Syrk_Context::BigInt_Shared_Memory_Syrk_Context(
     }
 
   output_residues_window = std::make_unique<Residue_Matrices_Window<double>>(
-    shared_memory_comm, comb.num_primes, window_width, window_width);
+    shared_memory_comm, comb.num_primes, window_width, window_width,
+    numa_aware_windows, huge_pages, numa_node);
 
   input_grouped_block_residues_window_A
     = std::make_unique<Block_Residue_Matrices_Window<double>>(
       shared_memory_comm, comb.num_primes, num_groups,
-      input_window_height_per_group_per_prime, window_width);
+      input_window_height_per_group_per_prime, window_width,
+      numa_aware_windows, huge_pages, numa_node);
 
   // We need a second input window only to calculate off-diagonal blocks
   // of the output window.
@@ -341,16 +427,58 @@ BigInt_Shared_Memory_Syrk_Context::BigInt_Shared_Memory_Syrk_Context(
       input_grouped_block_residues_window_B
         = std::make_unique<Block_Residue_Matrices_Window<double>>(
           shared_memory_comm, comb.num_primes, num_groups,
-          input_window_height_per_group_per_prime, window_width);
+          input_window_height_per_group_per_prime, window_width,
+          numa_aware_windows, huge_pages, numa_node);
     }
 
+  if(this->pipeline_windows)
+    {
+      input_grouped_block_residues_window_A_next
+        = std::make_unique<Block_Residue_Matrices_Window<double>>(
+          shared_memory_comm, comb.num_primes, num_groups,
+          input_window_height_per_group_per_prime, window_width,
+          numa_aware_windows, huge_pages, numa_node);
+      if(output_window_split_factor > 1)
+        {
+          input_grouped_block_residues_window_B_next
+            = std::make_unique<Block_Residue_Matrices_Window<double>>(
+              shared_memory_comm, comb.num_primes, num_groups,
+              input_window_height_per_group_per_prime, window_width,
+              numa_aware_windows, huge_pages, numa_node);
+        }
+    }
+
+  if(dynamic_blas_jobs || numa_aware_windows)
+    {
+      const size_t num_counters = output_residues_window->num_numa_segments();
+      blas_job_counter_window
+        = std::make_unique<Shared_Window_Array<std::atomic<size_t>>>(
+          shared_memory_comm, num_counters);
+      blas_job_counter_offsets.assign(num_counters, 0);
+      // Ranks on a node increment the counter concurrently via atomic
+      // operations on shared memory, which requires lock-free atomics.
+      static_assert(std::atomic<size_t>::is_always_lock_free);
+      if(shared_memory_comm.Rank() == 0)
+        for(size_t index = 0; index < num_counters; ++index)
+          new(&(*blas_job_counter_window)[index]) std::atomic<size_t>(0);
+      blas_job_counter_window->Fence();
+    }
+
+  if(huge_pages)
+    dtlb_miss_counter = std::make_unique<Dtlb_Miss_Counter>();
+
   {
     // Check sizes
     auto total_bytes
       = window_size_bytes(*output_residues_window)
         + window_size_bytes(*input_grouped_block_residues_window_A);
-    if(input_grouped_block_residues_window_B != nullptr)
-      total_bytes += window_size_bytes(*input_grouped_block_residues_window_B);
+    for(const auto &window : {&input_grouped_block_residues_window_B,
+                              &input_grouped_block_residues_window_A_next,
+                              &input_grouped_block_residues_window_B_next})
+      {
+        if(*window != nullptr)
+          total_bytes += window_size_bytes(**window);
+      }
     ASSERT(total_bytes <= max_shared_memory_bytes, DEBUG_STRING(total_bytes),
            DEBUG_STRING(max_shared_memory_bytes));
   }
@@ -373,3 +501,18 @@ El::Int BigInt_Shared_Memory_Syrk_Context::input_group_height_per_prime() const
     .at(group_index)
     .Height();
 }
+
+size_t BigInt_Shared_Memory_Syrk_Context::num_numa_segments() const
+{
+  return output_residues_window->num_numa_segments();
+}
+
+bool BigInt_Shared_Memory_Syrk_Context::is_split() const
+{
+  return output_window_split_factor * input_window_split_factor > 1;
+}
+
+bool BigInt_Shared_Memory_Syrk_Context::is_pipelined() const
+{
+  return pipeline_windows;
+}
@@ -3,6 +3,8 @@
 #include "sdpb_util/assert.hxx"
 #include "sdpb_util/split_range.hxx"
 
+#include <atomic>
+#include <chrono>
 #include <cblas.h>
 
 namespace
@@ -104,6 +106,36 @@ namespace
       }
   }
 
+  // is_nonzero_job(job) returns false if P_I or P_J is zero on the node.
+  // Then Q_IJ = 0, which was already set in clear_residues().
+  //
+  // If overwrite_output=true, each job sets its Q_IJ to zero
+  // before accumulating P_I^T P_J (instead of clear_residues()),
+  // so that the output window can be reused without an extra fence.
+  //
+  // If job_counter_window is null, each rank executes its own jobs
+  // from the static schedule, blas_job_schedule.jobs_by_rank.
+  // Otherwise, ranks pull jobs from blas_job_schedule.jobs_by_priority
+  // (heaviest first) using a shared atomic counter,
+  // so that ranks that finish early take the remaining jobs.
+  // If the output window is split into NUMA segments,
+  // there is a separate job list and counter for each segment:
+  // a rank takes jobs from its own segment first,
+  // and then steals jobs from other segments.
+  // Counters are never reset: job_counter_offsets holds the value
+  // of each counter at the beginning of the call. Each rank increments
+  // each counter once more after the last job, so at the end of the call
+  // the counter is offset + (number of segment jobs) + (number of ranks).
+  // NB: all ranks should finish the call before any rank starts the next one,
+  // i.e. the output window should be fenced between the calls.
+  //
+  // If record_makespan=true, we also record the actual makespan
+  // (max BLAS time among the node ranks) and the makespan estimated
+  // for the static schedule with the same job timings, in microseconds.
+  // This requires synchronizing all ranks after BLAS jobs.
+  //
+  // If dtlb_miss_counter is not null, data TLB misses are also recorded.
+  template <class Is_Nonzero_Job>
   void
   do_blas_jobs(const El::UpperOrLower uplo, const Blas_Job::Kind kind,
                const Blas_Job_Schedule &blas_job_schedule,
@@ -113,27 +145,131 @@ namespace
                  &input_grouped_block_residues_window_B,
                const std::unique_ptr<Residue_Matrices_Window<double>>
                  &output_residues_window,
+               const std::unique_ptr<Shared_Window_Array<std::atomic<size_t>>>
+                 &job_counter_window,
+               std::vector<size_t> &job_counter_offsets,
+               const bool record_makespan,
+               const Is_Nonzero_Job &is_nonzero_job,
+               const bool overwrite_output,
+               Dtlb_Miss_Counter *dtlb_miss_counter,
                const El::mpi::Comm &shared_memory_comm, Timers &timers)
   {
+    const auto do_job = [&](const Blas_Job &job) {
+      if(kind == Blas_Job::syrk && job.I.beg != job.J.beg)
+        ASSERT_EQUAL(job.I.beg < job.J.beg, uplo == El::UPPER);
+      if(overwrite_output)
+        {
+          auto output_matrix = El::View(
+            output_residues_window->residues.at(job.prime_index), job.I,
+            job.J);
+          El::Zero(output_matrix);
+        }
+      if(!is_nonzero_job(job))
+        return;
+      do_blas_job(job, uplo, *input_grouped_block_residues_window_A,
+                  kind == Blas_Job::syrk
+                    ? *input_grouped_block_residues_window_A
+                    : *input_grouped_block_residues_window_B,
+                  *output_residues_window);
+    };
+
+    // Data TLB misses during BLAS calls,
+    // to see the effect of huge pages (if hardware counters are available).
+    if(dtlb_miss_counter != nullptr)
+      dtlb_miss_counter->start();
+
     // Square each residue matrix
-    {
-      Scoped_Timer blas_timer(timers, "blas_jobs");
-      const auto shmem_rank = shared_memory_comm.Rank();
-      for(const auto &job : blas_job_schedule.jobs_by_rank.at(shmem_rank))
+    if(job_counter_window == nullptr)
+      {
+        Scoped_Timer blas_timer(timers, "blas_jobs");
+        const auto shmem_rank = shared_memory_comm.Rank();
+        for(const auto &job : blas_job_schedule.jobs_by_rank.at(shmem_rank))
+          do_job(job);
+        if(dtlb_miss_counter != nullptr)
+          dtlb_miss_counter->stop();
+      }
+    else
+      {
+        const auto &jobs = blas_job_schedule.jobs_by_priority;
+        const size_t num_segments = job_counter_window->size;
+        ASSERT_EQUAL(num_segments,
+                     output_residues_window->num_numa_segments());
+        ASSERT_EQUAL(job_counter_offsets.size(), num_segments);
+        // Job indices for each segment, heaviest first
+        std::vector<std::vector<size_t>> jobs_by_segment(num_segments);
+        for(size_t index = 0; index < jobs.size(); ++index)
+          {
+            const auto prime_index = jobs.at(index).first.prime_index;
+            jobs_by_segment
+              .at(output_residues_window->numa_segment_of_prime(prime_index))
+              .push_back(index);
+          }
+
+        // Time spent on the jobs assigned to each rank by static schedule
+        std::vector<int64_t> static_rank_time_us(
+          blas_job_schedule.jobs_by_rank.size(), 0);
+        int64_t rank_time_us = 0;
+        // Jobs taken from other NUMA segments
+        int64_t num_remote_jobs = 0;
         {
-          if(kind == Blas_Job::syrk && job.I.beg != job.J.beg)
-            ASSERT_EQUAL(job.I.beg < job.J.beg, uplo == El::UPPER);
-          do_blas_job(job, uplo, *input_grouped_block_residues_window_A,
-                      kind == Blas_Job::syrk
-                        ? *input_grouped_block_residues_window_A
-                        : *input_grouped_block_residues_window_B,
-                      *output_residues_window);
+          Scoped_Timer blas_timer(timers, "blas_jobs");
+          const size_t my_segment = output_residues_window->numa_segment();
+          for(size_t offset = 0; offset < num_segments; ++offset)
+            {
+              const size_t segment = (my_segment + offset) % num_segments;
+              const auto &segment_jobs = jobs_by_segment.at(segment);
+              auto &job_counter = (*job_counter_window)[segment];
+              const size_t counter_offset = job_counter_offsets.at(segment);
+              for(size_t index = job_counter.fetch_add(1) - counter_offset;
+                  index < segment_jobs.size();
+                  index = job_counter.fetch_add(1) - counter_offset)
+                {
+                  const auto &[job, static_rank]
+                    = jobs.at(segment_jobs.at(index));
+                  const auto start = std::chrono::steady_clock::now();
+                  do_job(job);
+                  static_rank_time_us.at(static_rank)
+                    += std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+                  if(offset != 0)
+                    ++num_remote_jobs;
+                }
+            }
+          if(dtlb_miss_counter != nullptr)
+            dtlb_miss_counter->stop();
+          rank_time_us
+            = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now()
+                - blas_timer.start_time())
+                .count();
         }
-    }
-    {
-      Scoped_Timer fence_timer(timers, "fence");
-      output_residues_window->Fence();
-    }
+        if(num_segments > 1)
+          timers.add_counter("blas_jobs.remote_jobs", num_remote_jobs);
+        if(record_makespan)
+          {
+            Scoped_Timer makespan_timer(timers, "makespan");
+            const auto makespan_us = El::mpi::AllReduce(
+              rank_time_us, El::mpi::MAX, shared_memory_comm);
+            El::mpi::AllReduce(static_rank_time_us.data(),
+                               static_rank_time_us.size(), El::mpi::SUM,
+                               shared_memory_comm);
+            const auto static_makespan_us
+              = *std::max_element(static_rank_time_us.begin(),
+                                  static_rank_time_us.end());
+            timers.add_counter("blas_jobs.makespan_us", makespan_us);
+            timers.add_counter("blas_jobs.static_makespan_us",
+                               static_makespan_us);
+          }
+        // Counter values at the beginning of the next call
+        const size_t num_ranks = shared_memory_comm.Size();
+        for(size_t segment = 0; segment < num_segments; ++segment)
+          job_counter_offsets.at(segment)
+            += jobs_by_segment.at(segment).size() + num_ranks;
+      }
+    if(dtlb_miss_counter != nullptr && dtlb_miss_counter->is_available())
+      timers.add_counter("blas_jobs.dtlb_misses",
+                         dtlb_miss_counter->value());
   }
 
   void update_block_timings_with_syrk(
@@ -197,6 +333,17 @@ void BigInt_Shared_Memory_Syrk_Context::bigint_syrk_blas(
   ASSERT(output_residues_window->width * output_window_split_factor
          >= bigint_output.Height());
 
+  ASSERT_EQUAL(static_cast<El::Int>(nonzero_columns_prefix_sum.size()),
+               bigint_output.Width() + 1);
+
+  if(pipeline_windows)
+    {
+      bigint_syrk_blas_pipelined(uplo, bigint_input_matrix_blocks,
+                                 bigint_output, timers, block_timings_ms);
+      report_huge_pages(timers);
+      return;
+    }
+
   const auto output_ranges
     = split_range({0, bigint_output.Height()}, output_window_split_factor);
 
@@ -218,6 +365,9 @@ void BigInt_Shared_Memory_Syrk_Context::bigint_syrk_blas(
           restore_and_reduce(uplo_opt, bigint_output_submatrix, timers);
         }
     }
+
+  // All window pages have been touched by now
+  report_huge_pages(timers);
 }
 
 // Calculate contribution to Q_IJ = P_I^T P_J from all ranks of a single node
@@ -260,43 +410,241 @@ void BigInt_Shared_Memory_Syrk_Context::bigint_syrk_blas_shmem_submatrix(
   // If input window is not big enough, we should fill input window
   // several times (taking different input block rows)
   // and call BLAS each time to update output window.
+  const bool overwrite_output = false;
+  const bool fence_output = true;
   for(size_t iter = 0; iter < input_window_split_factor; ++iter)
     {
       Scoped_Timer iter_timer(timers, "split_P_" + std::to_string(iter));
+      compute_submatrix_residues(bigint_input_matrix_blocks, iter, output_I,
+                                 output_J, timers, block_timings_ms);
+      multiply_submatrix_residues(uplo, *blas_job_schedule,
+                                  bigint_input_matrix_blocks, output_I,
+                                  output_J, overwrite_output, fence_output,
+                                  timers, block_timings_ms);
+    }
 
-      // Compute block residues
-      {
-        // For each block group, compute residues and write them
-        // to input residues window,
-        // skipping first skip_rows rows
-        const auto skip_rows = iter * input_group_height_per_prime();
-        compute_block_residues(*input_grouped_block_residues_window_A,
-                               bigint_input_matrix_blocks, skip_rows, output_I,
+  output_residues_window->Fence();
+}
+
+// Pipelined version of the loop in bigint_syrk_blas(),
+// used if the shared memory windows are split.
+//
+// Each step processes one input split of one Q_IJ block:
+// compute residues of P_I (and P_J) -> BLAS -> restore_and_reduce()
+// (the latter only after the last input split of Q_IJ).
+// Non-pipelined version separates each stage by fences,
+// so that ranks wait for the slowest one after each stage.
+//
+// Here, input windows are double-buffered:
+// BLAS jobs of step k read from input_grouped_block_residues_window_A (and _B),
+// while residues for step k+1 are written to the second set of windows.
+// Each rank thus goes on to compute residues for step k+1
+// as soon as it finishes its own BLAS jobs (or restore) for step k.
+// Ranks wait for each other after computing residues for step k+1:
+// input windows are fenced at the end of compute_block_residues(),
+// followed by the output window fence at the end of the step
+// (cheap, since all ranks have just been synchronized).
+// The only other fence is before restore_and_reduce() on the last input split.
+// Load imbalance between the ranks in BLAS jobs
+// is then partially compensated by computing residues, and vice versa.
+// Makespan of dynamic BLAS jobs is not recorded here,
+// since it requires synchronizing ranks after BLAS jobs, see do_blas_jobs().
+//
+// Output window is not cleared by clear_residues(),
+// since other ranks may still restore the previous Q_IJ from it.
+// Instead, each BLAS job of the first input split overwrites its part of Q_IJ.
+// Similarly, input windows are not cleared, and compute_block_residues()
+// writes all residues including zero columns.
+void BigInt_Shared_Memory_Syrk_Context::bigint_syrk_blas_pipelined(
+  const El::UpperOrLower uplo,
+  const std::vector<El::DistMatrix<El::BigFloat>> &bigint_input_matrix_blocks,
+  El::DistMatrix<El::BigFloat> &bigint_output, Timers &timers,
+  El::Matrix<int32_t> &block_timings_ms)
+{
+  Scoped_Timer timer(timers, "pipeline");
+
+  ASSERT(input_grouped_block_residues_window_A_next != nullptr);
+  ASSERT_EQUAL(input_grouped_block_residues_window_B == nullptr,
+               input_grouped_block_residues_window_B_next == nullptr);
+
+  struct Step
+  {
+    size_t i, j;
+    El::Range<El::Int> I, J;
+    size_t input_split_index;
+  };
+  std::vector<Step> steps;
+  const auto output_ranges
+    = split_range({0, bigint_output.Height()}, output_window_split_factor);
+  for(size_t i = 0; i < output_window_split_factor; ++i)
+    for(size_t j = i; j < output_window_split_factor; ++j)
+      for(size_t iter = 0; iter < input_window_split_factor; ++iter)
+        steps.push_back(
+          {i, j, output_ranges.at(i), output_ranges.at(j), iter});
+
+  const auto compute_residues = [&](const Step &step) {
+    compute_submatrix_residues(bigint_input_matrix_blocks,
+                               step.input_split_index, step.I, step.J,
                                timers, block_timings_ms);
-        if(output_I.beg != output_J.beg)
-          {
-            ASSERT(output_I.end != output_J.end);
-            compute_block_residues(*input_grouped_block_residues_window_B,
-                                   bigint_input_matrix_blocks, skip_rows,
-                                   output_J, timers, block_timings_ms);
-          }
-        // TODO if input_split_factor == 1, we can reuse
-        // same P_I for all P_J
-      }
+  };
 
-      // Square each residue matrix
-      {
-        Scoped_Timer syrk_timer(timers, "syrk");
-        do_blas_jobs(uplo, kind, *blas_job_schedule,
-                     input_grouped_block_residues_window_A,
-                     input_grouped_block_residues_window_B,
-                     output_residues_window, shared_memory_comm, timers);
-        update_block_timings_with_syrk(
-          block_timings_ms, syrk_timer, bigint_input_matrix_blocks,
-          block_index_local_to_global, shared_memory_comm,
-          *input_grouped_block_residues_window_A, total_block_height_per_node);
-      }
+  compute_residues(steps.front());
+  for(size_t index = 0; index < steps.size(); ++index)
+    {
+      const auto &step = steps.at(index);
+      Scoped_Timer step_timer(timers, El::BuildString("Q_", step.i, "_",
+                                                      step.j, "_split_P_",
+                                                      step.input_split_index));
+
+      const auto kind = step.I == step.J ? Blas_Job::syrk : Blas_Job::gemm;
+      const auto blas_job_schedule = get_blas_job_schedule(
+        kind, uplo, step.I.end - step.I.beg, step.J.end - step.J.beg);
+
+      const bool is_first_split = step.input_split_index == 0;
+      const bool is_last_split
+        = step.input_split_index + 1 == input_window_split_factor;
+      const bool overwrite_output = is_first_split;
+      // Q_IJ residues should be complete before restore_and_reduce()
+      const bool fence_output = is_last_split;
+      multiply_submatrix_residues(uplo, *blas_job_schedule,
+                                  bigint_input_matrix_blocks, step.I, step.J,
+                                  overwrite_output, fence_output, timers,
+                                  block_timings_ms);
+      if(is_last_split)
+        {
+          auto bigint_output_submatrix = bigint_output(step.I, step.J);
+          std::optional<El::UpperOrLower> uplo_opt;
+          if(step.I.beg == step.J.beg)
+            uplo_opt = uplo;
+          restore_and_reduce(uplo_opt, bigint_output_submatrix, timers);
+        }
+
+      if(index + 1 < steps.size())
+        {
+          // Other ranks may still read the current input windows,
+          // so we write to the second set.
+          std::swap(input_grouped_block_residues_window_A,
+                    input_grouped_block_residues_window_A_next);
+          std::swap(input_grouped_block_residues_window_B,
+                    input_grouped_block_residues_window_B_next);
+          // Input windows are fenced inside
+          compute_residues(steps.at(index + 1));
+        }
+
+      // Wait until all ranks finish BLAS jobs and restore_and_reduce(),
+      // so that the output window can be updated at the next step.
+      Scoped_Timer fence_timer(timers, "fence");
+      output_residues_window->Fence();
     }
+}
 
-  output_residues_window->Fence();
+// For each block group, compute residues and write them
+// to input residues window, for a given input split.
+void BigInt_Shared_Memory_Syrk_Context::compute_submatrix_residues(
+  const std::vector<El::DistMatrix<El::BigFloat>> &bigint_input_matrix_blocks,
+  const size_t input_split_index, const El::Range<El::Int> &output_I,
+  const El::Range<El::Int> &output_J, Timers &timers,
+  El::Matrix<int32_t> &block_timings_ms)
+{
+  // skip first skip_rows rows
+  const auto skip_rows = input_split_index * input_group_height_per_prime();
+  compute_block_residues(*input_grouped_block_residues_window_A,
+                         bigint_input_matrix_blocks, skip_rows, output_I,
+                         timers, block_timings_ms);
+  if(output_I.beg != output_J.beg)
+    {
+      ASSERT(output_I.end != output_J.end);
+      compute_block_residues(*input_grouped_block_residues_window_B,
+                             bigint_input_matrix_blocks, skip_rows, output_J,
+                             timers, block_timings_ms);
+    }
+  // TODO if input_split_factor == 1, we can reuse
+  // same P_I for all P_J
+}
+
+// Square each residue matrix:
+// Q_IJ += P_I^T P_J for the residues currently stored in the input windows.
+// If overwrite_output=true, Q_IJ is overwritten instead.
+// If fence_output=true, wait until all ranks have finished their jobs.
+void BigInt_Shared_Memory_Syrk_Context::multiply_submatrix_residues(
+  const El::UpperOrLower uplo, const Blas_Job_Schedule &blas_job_schedule,
+  const std::vector<El::DistMatrix<El::BigFloat>> &bigint_input_matrix_blocks,
+  const El::Range<El::Int> &output_I, const El::Range<El::Int> &output_J,
+  const bool overwrite_output, const bool fence_output, Timers &timers,
+  El::Matrix<int32_t> &block_timings_ms)
+{
+  Scoped_Timer syrk_timer(timers, "syrk");
+  const auto kind = output_I == output_J ? Blas_Job::syrk : Blas_Job::gemm;
+  // Job ranges I and J are relative to output_I and output_J.
+  // For syrk, both P_I and P_J are taken from output_I.
+  const auto &output_J_for_B = kind == Blas_Job::syrk ? output_I : output_J;
+  const auto is_nonzero_job = [&](const Blas_Job &job) {
+    return has_nonzero_columns({output_I.beg + job.I.beg,
+                                output_I.beg + job.I.end})
+           && has_nonzero_columns({output_J_for_B.beg + job.J.beg,
+                                   output_J_for_B.beg + job.J.end});
+  };
+  // Makespan requires synchronizing all ranks after BLAS jobs,
+  // which would defeat the overlap of stages in the pipelined mode.
+  const bool record_makespan = !pipeline_windows;
+  do_blas_jobs(uplo, kind, blas_job_schedule,
+               input_grouped_block_residues_window_A,
+               input_grouped_block_residues_window_B, output_residues_window,
+               blas_job_counter_window, blas_job_counter_offsets,
+               record_makespan, is_nonzero_job, overwrite_output,
+               dtlb_miss_counter.get(), shared_memory_comm, timers);
+  if(fence_output)
+    {
+      Scoped_Timer fence_timer(timers, "fence");
+      output_residues_window->Fence();
+    }
+  update_block_timings_with_syrk(
+    block_timings_ms, syrk_timer, bigint_input_matrix_blocks,
+    block_index_local_to_global, shared_memory_comm,
+    *input_grouped_block_residues_window_A, total_block_height_per_node);
+}
+
+// Find columns of P that have nonzero elements in any block on the node.
+// E.g. if all node's blocks involve only a part of dual variables y,
+// then the remaining columns of P = L^{-1} B are zero.
+// block_nonzero_columns contains column ranges for each local block,
+// e.g. SDP::free_var_nonzero_columns.
+void BigInt_Shared_Memory_Syrk_Context::find_nonzero_columns(
+  const std::vector<std::vector<El::Range<El::Int>>> &block_nonzero_columns,
+  const El::Int width)
+{
+  std::vector<int> is_nonzero(width, 0);
+  for(const auto &ranges : block_nonzero_columns)
+    {
+      for(const auto &range : ranges)
+        {
+          ASSERT(range.beg >= 0 && range.beg <= range.end
+                   && range.end <= width,
+                 DEBUG_STRING(range.beg), DEBUG_STRING(range.end),
+                 DEBUG_STRING(width));
+          for(El::Int j = range.beg; j < range.end; ++j)
+            is_nonzero.at(j) = 1;
+        }
+    }
+  if(width > 0)
+    El::mpi::AllReduce(is_nonzero.data(), is_nonzero.size(), El::mpi::MAX,
+                       shared_memory_comm);
+
+  nonzero_columns_prefix_sum.resize(width + 1);
+  nonzero_columns_prefix_sum.at(0) = 0;
+  for(El::Int j = 0; j < width; ++j)
+    nonzero_columns_prefix_sum.at(j + 1)
+      = nonzero_columns_prefix_sum.at(j) + is_nonzero.at(j);
+}
+
+bool BigInt_Shared_Memory_Syrk_Context::has_nonzero_columns(
+  const El::Range<El::Int> &columns) const
+{
+  ASSERT(columns.beg >= 0 && columns.beg <= columns.end
+           && columns.end < static_cast<El::Int>(
+                nonzero_columns_prefix_sum.size()),
+         DEBUG_STRING(columns.beg), DEBUG_STRING(columns.end),
+         DEBUG_STRING(nonzero_columns_prefix_sum.size()));
+  return nonzero_columns_prefix_sum.at(columns.end)
+         > nonzero_columns_prefix_sum.at(columns.beg);
 }
@@ -8,6 +8,11 @@
 
 namespace
 {
+  bool is_zero(const El::BigFloat &value)
+  {
+    return mpf_sgn(value.gmp_float.get_mpf_t()) == 0;
+  }
+
   void compute_column_residues_elementwise(
     const El::DistMatrix<El::BigFloat> &block, size_t group_index,
     El::Int residue_row_begin, El::Int global_col, Fmpz_Comb &comb,
@@ -46,9 +51,16 @@ namespace
     for(int iLoc = 0; iLoc < block_column_submatrix.LocalHeight(); ++iLoc)
       {
         const int i = block_column_submatrix.GlobalRow(iLoc);
-        bigint_value.from_BigFloat(
-          block_column_submatrix.GetLocalCRef(iLoc, jLoc));
+        const auto &value = block_column_submatrix.GetLocalCRef(iLoc, jLoc);
         double *data = first_residue_column_submatrix.Buffer(i, j);
+        if(is_zero(value))
+          {
+            for(size_t prime_index = 0; prime_index < comb.num_primes;
+                ++prime_index)
+              data[prime_index * block_residues_window.prime_stride] = 0;
+            continue;
+          }
+        bigint_value.from_BigFloat(value);
         fmpz_multi_mod_uint32_stride(data, block_residues_window.prime_stride,
                                      bigint_value.value, comb);
       }
@@ -89,10 +101,20 @@ namespace
           int jLoc = block.LocalCol(global_col);
           for(int iLoc = 0; iLoc < block.LocalHeight(); ++iLoc)
             {
-              bigint_value.from_BigFloat(block.GetLocalCRef(iLoc, jLoc));
+              const auto &value = block.GetLocalCRef(iLoc, jLoc);
               // pointer to the first residue
               double *data
                 = column_residues_buffer_temp.data() + data_offset + iLoc;
+              // Zero elements are common, e.g. if a block of B
+              // does not depend on some of the dual variables y.
+              if(is_zero(value))
+                {
+                  for(size_t prime_index = 0; prime_index < comb.num_primes;
+                      ++prime_index)
+                    data[prime_index * prime_stride] = 0;
+                  continue;
+                }
+              bigint_value.from_BigFloat(value);
               fmpz_multi_mod_uint32_stride(data, prime_stride,
                                            bigint_value.value, comb);
             }
@@ -285,6 +307,13 @@ void BigInt_Shared_Memory_Syrk_Context::compute_block_residues(
     std::vector<double> column_residues_buffer_temp;
     for(int global_col = 0; global_col < width; ++global_col)
       {
+        // Columns that are zero on the whole node
+        // were already set to zero in clear_residues().
+        // If windows are pipelined, they are not cleared,
+        // see bigint_syrk_blas_pipelined().
+        const El::Int P_col = col_range.beg + global_col;
+        if(!pipeline_windows && !has_nonzero_columns({P_col, P_col + 1}))
+          continue;
         compute_column_residues(group_index, block_views, global_col, comb,
                                 grouped_block_residues_window,
                                 column_residues_buffer_temp);
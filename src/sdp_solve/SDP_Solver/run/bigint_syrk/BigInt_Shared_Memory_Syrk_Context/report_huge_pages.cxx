@@ -0,0 +1,81 @@
+#include "../BigInt_Shared_Memory_Syrk_Context.hxx"
+#include "sdpb_util/assert.hxx"
+#include "sdpb_util/ostream/pretty_print_bytes.hxx"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Report how much of the residue windows is actually backed by huge pages.
+// Pages are allocated when they are touched for the first time,
+// so this should be called after the first bigint_syrk_blas() call.
+//
+// Each rank writes its own numbers to the profile,
+// since the mapping (and thus huge page usage) can differ between processes.
+//
+// The warning tells apart two cases: madvise(MADV_HUGEPAGE) failed
+// (no THP support in the kernel), or madvise() succeeded
+// but the kernel still uses regular pages (e.g. THP disabled for shmem).
+void BigInt_Shared_Memory_Syrk_Context::report_huge_pages(Timers &timers)
+{
+  if(!huge_pages || huge_pages_reported)
+    return;
+  huge_pages_reported = true;
+
+  size_t total_bytes = 0;
+  size_t total_huge_page_bytes = 0;
+  // Windows for which madvise(MADV_HUGEPAGE) failed
+  std::vector<std::string> not_advised_windows;
+  const auto add = [&](const std::string &name, const auto &window) {
+    if(window == nullptr)
+      return;
+    const auto bytes = window->size_bytes();
+    const auto huge_page_bytes = window->huge_page_bytes();
+    timers.add_counter("huge_pages." + name + ".bytes", bytes);
+    timers.add_counter("huge_pages." + name + ".huge_page_bytes",
+                       huge_page_bytes);
+    total_bytes += bytes;
+    total_huge_page_bytes += huge_page_bytes;
+    if(!window->huge_pages_advised())
+      not_advised_windows.push_back(name);
+  };
+  add("output_window", output_residues_window);
+  add("input_window_A", input_grouped_block_residues_window_A);
+  add("input_window_B", input_grouped_block_residues_window_B);
+  add("input_window_A_next", input_grouped_block_residues_window_A_next);
+  add("input_window_B_next", input_grouped_block_residues_window_B_next);
+
+  if(shared_memory_comm.Rank() != 0)
+    return;
+  if(!not_advised_windows.empty() && verbosity >= Verbosity::regular)
+    {
+      std::ostringstream names;
+      for(const auto &name : not_advised_windows)
+        names << " " << name;
+      PRINT_WARNING(
+        "rank=", El::mpi::Rank(),
+        ": huge pages were requested for shared memory windows, "
+        "but madvise(MADV_HUGEPAGE) failed for:", names.str(),
+        ". Either the kernel does not support transparent huge pages, "
+        "or the window is smaller than a huge page. Regular pages are used "
+        "for these windows.");
+    }
+  else if(total_huge_page_bytes == 0 && verbosity >= Verbosity::regular)
+    {
+      PRINT_WARNING(
+        "rank=", El::mpi::Rank(),
+        ": huge pages were requested for shared memory windows, "
+        "and madvise(MADV_HUGEPAGE) succeeded, "
+        "but regular pages are used. Check that transparent huge pages "
+        "are enabled for shared memory, e.g. "
+        "/sys/kernel/mm/transparent_hugepage/shmem_enabled should be "
+        "\"advise\" or \"always\".");
+    }
+  else if(verbosity >= Verbosity::debug)
+    {
+      El::Output("rank=", El::mpi::Rank(),
+                 ": shared memory windows mapped by huge pages: ",
+                 pretty_print_bytes(total_huge_page_bytes, true), " of ",
+                 pretty_print_bytes(total_bytes, true));
+    }
+}
@@ -1,7 +1,6 @@
 #include "../BigInt_Shared_Memory_Syrk_Context.hxx"
 #include "sdp_solve/SDP_Solver/run/bigint_syrk/fmpz/Fmpz_BigInt.hxx"
 #include "restore_bigint_from_residues.hxx"
-#include "sdpb_util/block_mapping/MPI_Comm_Wrapper.hxx"
 
 // Restore output maxtrix from residues (outpet_residues_window) and synchronize it for all nodes.
 //
@@ -14,7 +13,7 @@
 // 2. Accumulate Q_n[i,j] from other nodes to Q[i,j] according to the followin scheme:
 //   for offset = 1..num_nodes-1:
 //   - Each node (n) restores all Q_n[i,j] for [i,j] owned by node (n+offset) from residues,
-//     and sends them to node (n+offset). Implemented via MPI_Sendrecv.
+//     and sends them to node (n+offset). Implemented via MPI_Isend/MPI_Recv.
 //   - Each node updates its own Q[i,j] with data recevied from node (n-offset).
 //
 // All ranks on a node have access to each Q_n[i,j], so how do we decide
@@ -24,12 +23,15 @@
 // For example, for 3 nodes with 128 cores,
 //   rank 0 will communicate only with ranks 128 and 256,
 //   rank 1 - with ranks 129 and 257, and so on.
-//   Communicator for such group, e.g. (0,128,256), (1,129,257) etc.,
-//     is called reduce_comm in the code.
+//
+// Nodes can have different number of ranks, e.g. 64 and 128 cores.
+// Then rank k of node m receives contributions from node n
+//   from the rank (k % size_n) of node n.
+//   Thus, some ranks of a smaller node send several messages at each step.
 //
 // All [i,j] owned by one rank are combined into a single MPI message.
 // Thus, each rank has send and receive buffers of size ~ #(Q) / num_ranks.
-// Each rank performs (num_nodes - 1) send/recv operations.
+// Each rank performs (num_nodes - 1) receive operations.
 //
 void BigInt_Shared_Memory_Syrk_Context::restore_and_reduce(
   std::optional<El::UpperOrLower> uplo, El::DistMatrix<El::BigFloat> &output,
@@ -82,43 +84,34 @@ void BigInt_Shared_Memory_Syrk_Context::restore_and_reduce(
     {
       // Ensure that no one will write to the window until we finish
       // (if we split Q, the window is reused multimple times)
+      // If windows are pipelined, the fence is called after computing
+      // residues for the next step, see bigint_syrk_blas_pipelined().
+      if(pipeline_windows)
+        return;
       Scoped_Timer fence_timer(timers, "fence");
       output_residues_window->Fence();
       return;
     }
 
-  // reduce_comm will combine processes having the same rank on a node,
-  // e.g.: (0,128,256), (1,129,257),... (for 3 nodes, 128 core each)
-  // TODO create communicator in constructor and reuse it?
-  // Generally we don't know output_comm, in practice it's always COMM_WORLD.
-  MPI_Comm_Wrapper reduce_comm_wrapper;
-  auto &reduce_comm = reduce_comm_wrapper.value;
-  El::mpi::Split(output_comm, shared_memory_comm.Rank(), 0, reduce_comm);
-  const int reduce_rank = reduce_comm.Rank();
-
-  // All nodes have the same number of ranks,
-  // so that all reduce_comm should have the same size
-  ASSERT_EQUAL(reduce_comm.Size() * shared_memory_comm.Size(),
-               output_comm.Size());
-
-  std::vector<int> global_ranks(reduce_comm.Size());
-  global_ranks.at(reduce_rank) = output_comm.Rank();
-
-  // Number of output elements owned by a given rank in reduce_comm
-  std::vector<int> num_output_elements(reduce_comm.Size());
+  // node_ranks contain COMM_WORLD ranks, see get_node_ranks().
+  // In practice, output_comm is always COMM_WORLD.
+  ASSERT(El::mpi::Congruent(output_comm, El::mpi::COMM_WORLD),
+         "restore_and_reduce() requires output distributed over all ranks");
+  const size_t num_nodes = node_ranks.size();
+  const int node_rank = shared_memory_comm.Rank();
+  const int node_size = shared_memory_comm.Size();
+  const int rank = output_comm.Rank();
+
+  // Number of output elements owned by the current rank
+  size_t num_output_elements = 0;
   for(int i = 0; i < height; ++i)
     for(int j = 0; j < width; ++j)
       {
         if(skip_element(i, j))
           continue;
         if(output.IsLocal(i, j))
-          ++num_output_elements.at(reduce_rank);
+          ++num_output_elements;
       }
-  for(int rank = 0; rank < reduce_comm.Size(); ++rank)
-    {
-      El::mpi::Broadcast(num_output_elements.at(rank), rank, reduce_comm);
-      El::mpi::Broadcast(global_ranks.at(rank), rank, reduce_comm);
-    }
 
   {
     Scoped_Timer reduce_timer(timers, "reduce");
@@ -126,54 +119,73 @@ void BigInt_Shared_Memory_Syrk_Context::restore_and_reduce(
     El::BigFloat bigfloat_value;
     const size_t serialized_size = bigfloat_value.SerializedSize();
 
-    std::vector<El::byte> send_buf;
+    std::vector<std::vector<El::byte>> send_bufs;
     std::vector<El::byte> recv_buf;
-    // Each rank sends to (rank + offset) Q_n[i,j] for all [i,j] owned by (rank+offset)
+    // Each node sends to (node + offset) Q_n[i,j] for all [i,j] owned by (node+offset)
     // TODO implement via simple MPI_Reduce?
     // Current implementation ensures uniform network load for all nodes.
     // If we switch to MPI_Reduce, we should preserve this uniformity.
     // For example, naive implementation "reduce for all ranks of node 0, then for all ranks of node 1 etc."
     // will be probably worse.
-    for(int rank_offset = 1; rank_offset < reduce_comm.Size(); ++rank_offset)
+    for(size_t node_offset = 1; node_offset < num_nodes; ++node_offset)
       {
         Scoped_Timer iter_timer(timers,
-                                "offset=" + std::to_string(rank_offset));
-        const int to = (reduce_rank + rank_offset) % reduce_comm.Size();
-        const int from = (reduce_comm.Size() + reduce_rank - rank_offset)
-                         % reduce_comm.Size();
-
-        // Fill send buffer
+                                "offset=" + std::to_string(node_offset));
+        const auto &to_ranks
+          = node_ranks.at((node_index + node_offset) % num_nodes);
+        const auto &from_ranks
+          = node_ranks.at((num_nodes + node_index - node_offset) % num_nodes);
+
+        // Ranks of (node + offset) served by the current rank
+        std::vector<int> to;
+        for(size_t index = node_rank; index < to_ranks.size();
+            index += node_size)
+          to.push_back(to_ranks.at(index));
+        const int from = from_ranks.at(node_rank % from_ranks.size());
+
+        // Fill send buffers
+        send_bufs.resize(to.size());
         {
           Scoped_Timer serialize_timer(timers, "serialize");
-          send_buf.resize(num_output_elements.at(to) * serialized_size);
-          El::byte *curr_send = send_buf.data();
-          for(int i = 0; i < height; ++i)
-            for(int j = 0; j < width; ++j)
-              {
-                if(skip_element(i, j))
-                  continue;
-                if(output.Owner(i, j) != global_ranks.at(to))
-                  continue;
-
-                ASSERT(curr_send - send_buf.data() < send_buf.size());
-                restore_bigint_from_residues(*output_residues_window, i, j,
-                                             comb, residues_buffer_temp,
-                                             bigint_value);
-                bigint_value.to_BigFloat(bigfloat_value);
-                bigfloat_value.Serialize(curr_send);
-                curr_send += serialized_size;
-              }
-          ASSERT_EQUAL(curr_send - send_buf.data(), send_buf.size());
+          for(size_t index = 0; index < to.size(); ++index)
+            {
+              auto &send_buf = send_bufs.at(index);
+              send_buf.clear();
+              for(int i = 0; i < height; ++i)
+                for(int j = 0; j < width; ++j)
+                  {
+                    if(skip_element(i, j))
+                      continue;
+                    if(output.Owner(i, j) != to.at(index))
+                      continue;
+
+                    restore_bigint_from_residues(*output_residues_window, i,
+                                                 j, comb, residues_buffer_temp,
+                                                 bigint_value);
+                    bigint_value.to_BigFloat(bigfloat_value);
+                    send_buf.resize(send_buf.size() + serialized_size);
+                    bigfloat_value.Serialize(send_buf.data() + send_buf.size()
+                                             - serialized_size);
+                  }
+            }
         }
 
         // Receive buffer will recieve elements for a current rank
-        recv_buf.resize(num_output_elements.at(reduce_rank) * serialized_size);
+        recv_buf.resize(num_output_elements * serialized_size);
 
         {
           Scoped_Timer mpi_sendrecv_timer(timers, "mpi_sendrecv");
-          El::mpi::SendRecv(send_buf.data(), send_buf.size(), to,
-                            recv_buf.data(), recv_buf.size(), from,
-                            reduce_comm);
+          std::vector<MPI_Request> requests(to.size());
+          for(size_t index = 0; index < to.size(); ++index)
+            {
+              const auto &send_buf = send_bufs.at(index);
+              MPI_Isend(send_buf.data(), send_buf.size(), MPI_BYTE,
+                        to.at(index), 0, output_comm.comm,
+                        &requests.at(index));
+            }
+          MPI_Recv(recv_buf.data(), recv_buf.size(), MPI_BYTE, from, 0,
+                   output_comm.comm, MPI_STATUS_IGNORE);
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
         }
 
         // Restore received
@@ -185,7 +197,7 @@ void BigInt_Shared_Memory_Syrk_Context::restore_and_reduce(
               {
                 if(skip_element(i, j))
                   continue;
-                if(output.Owner(i, j) != global_ranks.at(reduce_rank))
+                if(output.Owner(i, j) != rank)
                   continue;
 
                 ASSERT(curr_recv - recv_buf.data() < recv_buf.size());
@@ -204,6 +216,8 @@ void BigInt_Shared_Memory_Syrk_Context::restore_and_reduce(
 
   // Ensure that no one will write to the window until we finish
   // (if we split Q, the window is reused multimple times)
+  if(pipeline_windows)
+    return;
   Scoped_Timer fence_timer(timers, "fence");
   output_residues_window->Fence();
 }
@@ -29,9 +29,12 @@ public:
   Block_Residue_Matrices_Window(El::mpi::Comm shared_memory_comm,
                                 size_t num_primes, size_t num_blocks,
                                 const std::vector<El::Int> &block_heights,
-                                size_t block_width)
+                                size_t block_width, bool numa_aware = false,
+                                bool huge_pages = false,
+                                std::optional<int> numa_node = std::nullopt)
       : Residue_Matrices_Window<T>(shared_memory_comm, num_primes,
-                                   Sum(block_heights), block_width),
+                                   Sum(block_heights), block_width,
+                                   numa_aware, huge_pages, numa_node),
         num_blocks(num_blocks),
         block_residues(num_primes, std::vector<El::Matrix<T>>(num_blocks))
   {
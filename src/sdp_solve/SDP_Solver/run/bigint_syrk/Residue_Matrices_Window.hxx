@@ -5,6 +5,7 @@
 
 #include <El.hpp>
 #include <boost/noncopyable.hpp>
+#include <optional>
 #include <vector>
 
 // Vector of matrices stored in a contiguous Shared_Window_Array
@@ -23,13 +24,20 @@ private:
   Shared_Window_Array<T> window;
 
 public:
+  // If numa_aware=true, the window is split into per-NUMA-node segments.
+  // If huge_pages=true, the window is backed by huge pages if possible.
+  // numa_node overrides the NUMA node of the current rank.
+  // See Shared_Window_Array.
   Residue_Matrices_Window(El::mpi::Comm shared_memory_comm, size_t num_primes,
-                          size_t height, size_t width)
+                          size_t height, size_t width,
+                          bool numa_aware = false, bool huge_pages = false,
+                          std::optional<int> numa_node = std::nullopt)
       : num_primes(num_primes),
         height(height),
         width(width),
         prime_stride(height * width),
-        window(shared_memory_comm, num_primes * prime_stride)
+        window(shared_memory_comm, num_primes * prime_stride, numa_aware,
+               huge_pages, numa_node)
   {
     ASSERT(num_primes > 0);
     ASSERT(height > 0);
@@ -44,4 +52,27 @@ public:
   }
   [[nodiscard]] El::mpi::Comm Comm() const { return window.comm; }
   void Fence() { window.Fence(); }
+
+  [[nodiscard]] size_t num_numa_segments() const
+  {
+    return window.num_segments();
+  }
+  // Segment of the current rank's NUMA node
+  [[nodiscard]] size_t numa_segment() const { return window.segment_index; }
+  [[nodiscard]] size_t size_bytes() const { return window.size * sizeof(T); }
+  // Bytes mapped by huge pages in the current process
+  [[nodiscard]] size_t huge_page_bytes() const
+  {
+    return window.huge_page_bytes();
+  }
+  // True if madvise(MADV_HUGEPAGE) succeeded in the current process
+  [[nodiscard]] bool huge_pages_advised() const
+  {
+    return window.huge_pages_advised;
+  }
+  // Segment containing (most of) the residue matrix for a given prime
+  [[nodiscard]] size_t numa_segment_of_prime(size_t prime_index) const
+  {
+    return window.segment_of(prime_index * prime_stride + prime_stride / 2);
+  }
 };
@@ -28,11 +28,36 @@ namespace
 
     return jobs_by_rank;
   }
+
+  std::vector<std::pair<Blas_Job, size_t>> get_jobs_by_priority(
+    const std::vector<std::vector<Blas_Job>> &jobs_by_rank)
+  {
+    // (rank, index in jobs_by_rank[rank])
+    std::vector<std::pair<size_t, size_t>> job_ids;
+    for(size_t rank = 0; rank < jobs_by_rank.size(); ++rank)
+      for(size_t index = 0; index < jobs_by_rank.at(rank).size(); ++index)
+        job_ids.emplace_back(rank, index);
+
+    const auto get_job = [&jobs_by_rank](const std::pair<size_t, size_t> &id)
+      -> const Blas_Job & { return jobs_by_rank.at(id.first).at(id.second); };
+    // The heaviest jobs go first
+    std::stable_sort(job_ids.begin(), job_ids.end(),
+                     [&get_job](const auto &a, const auto &b) {
+                       return get_job(b).cost < get_job(a).cost;
+                     });
+
+    std::vector<std::pair<Blas_Job, size_t>> result;
+    result.reserve(job_ids.size());
+    for(const auto &id : job_ids)
+      result.emplace_back(get_job(id), id.first);
+    return result;
+  }
 }
 
 Blas_Job_Schedule::Blas_Job_Schedule(size_t num_ranks,
                                      const std::vector<Blas_Job> &jobs)
-    : jobs_by_rank(get_jobs_by_rank(num_ranks, jobs))
+    : jobs_by_rank(get_jobs_by_rank(num_ranks, jobs)),
+      jobs_by_priority(get_jobs_by_priority(jobs_by_rank))
 {}
 
 Blas_Job::Cost Blas_Job_Schedule::max_rank_cost() const
@@ -7,6 +7,10 @@
 struct Blas_Job_Schedule
 {
   const std::vector<std::vector<Blas_Job>> jobs_by_rank;
+  // All jobs, heaviest first (LPT order),
+  // together with the rank executing the job in jobs_by_rank.
+  // Used for dynamic scheduling, when ranks pull jobs from a shared counter.
+  const std::vector<std::pair<Blas_Job, size_t>> jobs_by_priority;
 
   Blas_Job_Schedule(size_t num_ranks, const std::vector<Blas_Job> &jobs);
 
@@ -103,13 +103,19 @@ inline BigInt_Shared_Memory_Syrk_Context
 initialize_bigint_syrk_context(const Environment &env,
                                const Block_Info &block_info, const SDP &sdp,
                                const size_t max_shared_memory_bytes,
-                               const Verbosity verbosity)
+                               const Verbosity verbosity,
+                               const bool dynamic_blas_jobs = false,
+                               const bool numa_aware_windows = false,
+                               const bool huge_pages = false,
+                               const bool pipeline_windows = false)
 {
   const Grouped_Block_Size_Info info(env, block_info, sdp);
 
   return BigInt_Shared_Memory_Syrk_Context(
-    env.comm_shared_mem, info.group_index, info.group_comm_sizes,
-    El::gmp::Precision(), max_shared_memory_bytes,
-    info.blocks_height_per_group, info.block_width, block_info.block_indices,
-    verbosity);
+    env.comm_shared_mem, env.node_index(), env.procs_per_node(),
+    info.group_index, info.group_comm_sizes, El::gmp::Precision(),
+    max_shared_memory_bytes, info.blocks_height_per_group, info.block_width,
+    block_info.block_indices, sdp.free_var_nonzero_columns, verbosity,
+    create_blas_job_schedule, dynamic_blas_jobs, numa_aware_windows,
+    huge_pages, pipeline_windows);
 }
@@ -1,3 +1,4 @@
+#include "for_each_block.hxx"
 #include "sdp_solve/Block_Diagonal_Matrix.hxx"
 #include "sdp_solve/Block_Info.hxx"
 
@@ -9,19 +10,23 @@ void cholesky_decomposition(const Block_Diagonal_Matrix &A,
 {
   for(size_t b = 0; b < A.blocks.size(); b++)
     {
-      // FIXME: Use pivoting?
       L.blocks[b] = A.blocks[b];
-      try
-        {
-          Cholesky(El::UpperOrLowerNS::LOWER, L.blocks[b]);
-        }
-      catch(std::exception &e)
-        {
-          RUNTIME_ERROR("Error when computing Cholesky decomposition of "
-                        "Block_Diagonal_Matrix ",
-                        name,
-                        ", block index = ", block_info.block_indices.at(b),
-                        ": ", e.what());
-        }
     }
+  for_each_block(L.blocks, [&](const size_t b, const bool local) {
+    // FIXME: Use pivoting?
+    try
+      {
+        if(local)
+          Cholesky(El::UpperOrLowerNS::LOWER, L.blocks[b].Matrix());
+        else
+          Cholesky(El::UpperOrLowerNS::LOWER, L.blocks[b]);
+      }
+    catch(std::exception &e)
+      {
+        RUNTIME_ERROR("Error when computing Cholesky decomposition of "
+                      "Block_Diagonal_Matrix ",
+                      name, ", block index = ", block_info.block_indices.at(b),
+                      ": ", e.what());
+      }
+  });
 }
@@ -1,5 +1,8 @@
+#include "for_each_block.hxx"
 #include "sdp_solve/SDP_Solver.hxx"
 
+#include <type_traits>
+
 // result = \sum_p a[p] A_p,
 //
 // where a[p] is a vector of length primalObjective.size() and the
@@ -15,52 +18,55 @@ void constraint_matrix_weighted_sum(const Block_Info &block_info,
                                     const SDP &sdp, const Block_Vector &a,
                                     Block_Diagonal_Matrix &result)
 {
-  auto a_block(a.blocks.begin());
-  auto result_block(result.blocks.begin());
-  auto bilinear_bases_block(sdp.bilinear_bases.begin());
-
-  for(auto &block_index : block_info.block_indices)
-    {
-      const size_t block_size(block_info.num_points[block_index]);
-      for(size_t parity = 0; parity < 2; ++parity)
+  auto weighted_sum = [](const size_t block_size, const size_t dim,
+                         const auto &a_block, const auto &bilinear_bases_block,
+                         auto &result_block) {
+    using Matrix = std::decay_t<decltype(result_block)>;
+    // TODO: Remove this because it gets zero'd out in Gemm?
+    El::Zero(result_block);
+    for(size_t column_block = 0; column_block < dim; ++column_block)
+      for(size_t row_block = 0; row_block <= column_block; ++row_block)
         {
-          // TODO: Remove this because it gets zero'd out in Gemm?
-          El::Zero(*result_block);
-          for(size_t column_block = 0;
-              column_block < block_info.dimensions[block_index];
-              ++column_block)
-            for(size_t row_block = 0; row_block <= column_block; ++row_block)
-              {
-                const size_t result_block_size(bilinear_bases_block->Height());
-                const size_t column_offset(column_block * result_block_size),
-                  row_offset(row_block * result_block_size);
-                size_t vector_offset(
-                  ((column_block * (column_block + 1)) / 2 + row_block)
-                  * block_size);
-                El::DistMatrix<El::BigFloat> sub_vector(
-                  El::LockedView(*a_block, vector_offset, 0, block_size, 1));
-                El::DistMatrix<El::BigFloat> scaled_bases(
-                  *bilinear_bases_block);
+          const size_t result_block_size(bilinear_bases_block.Height());
+          const size_t column_offset(column_block * result_block_size),
+            row_offset(row_block * result_block_size);
+          size_t vector_offset(
+            ((column_block * (column_block + 1)) / 2 + row_block)
+            * block_size);
+          Matrix sub_vector(
+            El::LockedView(a_block, vector_offset, 0, block_size, 1));
+          Matrix scaled_bases(bilinear_bases_block);
 
-                El::DiagonalScale(El::LeftOrRight::RIGHT,
-                                  El::Orientation::NORMAL, sub_vector,
-                                  scaled_bases);
+          El::DiagonalScale(El::LeftOrRight::RIGHT, El::Orientation::NORMAL,
+                            sub_vector, scaled_bases);
 
-                El::DistMatrix<El::BigFloat> result_sub_block(
-                  El::View(*result_block, row_offset, column_offset,
-                           result_block_size, result_block_size));
-                El::Gemm(El::Orientation::NORMAL, El::Orientation::TRANSPOSE,
-                         El::BigFloat(column_block == row_block ? 1 : 0.5),
-                         *bilinear_bases_block, scaled_bases, El::BigFloat(0),
-                         result_sub_block);
-              }
-          if(block_info.dimensions[block_index] > 1)
-            {
-              El::MakeSymmetric(El::UpperOrLowerNS::UPPER, *result_block);
-            }
-          ++result_block;
-          ++bilinear_bases_block;
+          Matrix result_sub_block(El::View(result_block, row_offset,
+                                           column_offset, result_block_size,
+                                           result_block_size));
+          El::Gemm(El::Orientation::NORMAL, El::Orientation::TRANSPOSE,
+                   El::BigFloat(column_block == row_block ? 1 : 0.5),
+                   bilinear_bases_block, scaled_bases, El::BigFloat(0),
+                   result_sub_block);
         }
-      ++a_block;
-    }
+    if(dim > 1)
+      {
+        El::MakeSymmetric(El::UpperOrLowerNS::UPPER, result_block);
+      }
+  };
+
+  // result.blocks[2 * block + parity]
+  for_each_block(result.blocks, [&](const size_t index, const bool local) {
+    const size_t block_index(block_info.block_indices.at(index / 2));
+    const size_t block_size(block_info.num_points[block_index]),
+      dim(block_info.dimensions[block_index]);
+    const auto &a_block(a.blocks.at(index / 2));
+    const auto &bilinear_bases_block(sdp.bilinear_bases.at(index));
+    auto &result_block(result.blocks.at(index));
+    if(local)
+      weighted_sum(block_size, dim, a_block.LockedMatrix(),
+                   bilinear_bases_block.LockedMatrix(), result_block.Matrix());
+    else
+      weighted_sum(block_size, dim, a_block, bilinear_bases_block,
+                   result_block);
+  });
 }
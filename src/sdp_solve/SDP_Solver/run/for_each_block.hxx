@@ -0,0 +1,60 @@
+#pragma once
+
+#include "sdpb_util/Thread_Pool.hxx"
+
+#include <El.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Call job(index, local) for each index in [0, blocks.size()).
+//
+// If the current rank owns its blocks alone (i.e. the grid has a single
+// process) and Thread_Pool::global() has several threads, blocks are
+// processed concurrently.  Threads pull blocks from a shared counter,
+// largest blocks first, so that the load is balanced dynamically.
+// This allows running fewer MPI ranks per node (saving per-rank memory
+// and MPI overhead) while still using all cores.
+//
+// In that case local=true, and job should work only with local matrices,
+// block.Matrix() or block.LockedMatrix(), since El::DistMatrix operations
+// call MPI on the same communicator from different threads.
+// Otherwise, local=false and blocks are processed sequentially.
+//
+// NB: the threaded path relies on local El::Matrix<El::BigFloat> routines
+// (e.g. El::Gemm, El::Trsm, El::Cholesky) being thread-safe
+// for different matrices. They only touch their arguments, and
+// GMP mpf functions are thread-safe for distinct variables.
+// The job should not change shared state, e.g. the global GMP precision
+// (El::gmp::SetPrecision) or timers, without synchronization.
+template <class Job>
+void for_each_block(const std::vector<El::DistMatrix<El::BigFloat>> &blocks,
+                    const Job &job)
+{
+  if(blocks.empty())
+    return;
+  const bool local = blocks.front().Grid().Size() == 1
+                     && Thread_Pool::global().num_threads() > 1;
+  if(!local)
+    {
+      for(size_t index = 0; index < blocks.size(); ++index)
+        job(index, false);
+      return;
+    }
+
+  // Most expensive first, assuming cubic complexity
+  std::vector<size_t> order(blocks.size());
+  std::iota(order.begin(), order.end(), 0);
+  auto cost = [&blocks](const size_t index) {
+    const size_t height = blocks.at(index).Height();
+    const size_t width = blocks.at(index).Width();
+    return height * height * width;
+  };
+  std::stable_sort(order.begin(), order.end(),
+                   [&](const size_t a, const size_t b) {
+                     return cost(a) > cost(b);
+                   });
+  Thread_Pool::global().parallel_for(
+    order.size(), [&](const size_t i) { job(order.at(i), true); });
+}
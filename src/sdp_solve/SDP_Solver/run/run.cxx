@@ -191,6 +191,10 @@ SDP_Solver_Terminate_Reason SDP_Solver::run(
 {
   SDP_Solver_Terminate_Reason terminate_reason(
     SDP_Solver_Terminate_Reason::MaxIterationsExceeded);
+  ASSERT(parameters.rebalance_threshold == 0
+           || parameters.rebalance_threshold > 1,
+         "rebalanceThreshold should be either 0 or greater than 1, got ",
+         parameters.rebalance_threshold);
   Scoped_Timer solver_timer(timers, "run");
   Scoped_Timer initialize_timer(timers, "initialize");
   if(verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
@@ -199,7 +203,8 @@ SDP_Solver_Terminate_Reason SDP_Solver::run(
                  " Start solver iterations");
     }
 
-  El::BigFloat primal_step_length(0), dual_step_length(0);
+  // NB: primal_step_length and dual_step_length are SDP_Solver members,
+  // so that they survive redistribution of blocks.
 
   Block_Diagonal_Matrix X_cholesky(X), Y_cholesky(X);
   if(verbosity >= Verbosity::debug)
@@ -250,13 +255,17 @@ SDP_Solver_Terminate_Reason SDP_Solver::run(
     = get_max_shared_memory_bytes(parameters.max_shared_memory_bytes, env,
                                   block_info, sdp, *this, verbosity);
   auto bigint_syrk_context = initialize_bigint_syrk_context(
-    env, block_info, sdp, max_shared_memory_bytes, verbosity);
+    env, block_info, sdp, max_shared_memory_bytes, verbosity,
+    parameters.dynamic_blas_jobs, parameters.numa_aware_shared_memory,
+    parameters.huge_pages, parameters.pipeline_shared_memory);
   initialize_bigint_syrk_context_timer.stop();
 
   initialize_timer.stop();
   auto last_checkpoint_time(std::chrono::high_resolution_clock::now());
 
-  if(El::mpi::Rank() == 0)
+  // After blocks are redistributed (see rebalanceThreshold),
+  // we continue writing to the same iterations.json
+  if(El::mpi::Rank() == 0 && num_iterations == 0)
     {
       // Copy old iterations.json e.g. to iterations.0.json
       if(fs::exists(iterations_json_path))
@@ -293,8 +302,16 @@ SDP_Solver_Terminate_Reason SDP_Solver::run(
         }
     }
 
+  // Block timings summed over iterations since the start of run(),
+  // i.e. since the last rebalancing (see rebalanceThreshold).
+  // Averaging over several iterations prevents rebalancing
+  // due to timing noise in a single iteration.
+  constexpr size_t min_rebalance_iterations = 3;
+  std::vector<int64_t> total_block_timings_ms;
+  size_t num_timed_iterations = 0;
+
   print_header(verbosity);
-  for(size_t iteration = 1;; ++iteration)
+  for(size_t iteration = num_iterations + 1;; ++iteration)
     {
       Scoped_Timer iteration_timer(timers,
                                    "iter_" + std::to_string(iteration));
@@ -392,6 +409,7 @@ SDP_Solver_Terminate_Reason SDP_Solver::run(
            beta_corrector, primal_step_length, dual_step_length, terminate_now,
            timers, block_timings_ms, Q_cond_number, max_block_cond_number,
            max_block_cond_number_name);
+      num_iterations = iteration;
 
       if(verbosity >= Verbosity::trace && El::mpi::Rank() == 0)
         {
@@ -423,6 +441,47 @@ SDP_Solver_Terminate_Reason SDP_Solver::run(
                       solver_timer.start_time(), iteration_timer.start_time(),
                       Q_cond_number, max_block_cond_number,
                       max_block_cond_number_name, verbosity);
+      print_iteration_timer.stop();
+
+      // block_timings_ms are empty after the first iteration
+      if(parameters.rebalance_threshold > 0 && El::mpi::Size() > 1
+         && block_timings_ms.Height() != 0)
+        {
+          total_block_timings_ms.resize(block_timings_ms.Height(), 0);
+          for(El::Int block = 0; block < block_timings_ms.Height(); ++block)
+            total_block_timings_ms.at(block) += block_timings_ms(block, 0);
+          ++num_timed_iterations;
+        }
+      if(num_timed_iterations >= min_rebalance_iterations)
+        {
+          Scoped_Timer imbalance_timer(timers, "load_imbalance");
+          El::Matrix<int32_t> average_block_timings_ms(
+            total_block_timings_ms.size(), 1);
+          for(size_t block = 0; block < total_block_timings_ms.size(); ++block)
+            {
+              average_block_timings_ms(block, 0)
+                = total_block_timings_ms.at(block)
+                  / static_cast<int64_t>(num_timed_iterations);
+            }
+          const double imbalance
+            = block_info.load_imbalance(env, average_block_timings_ms);
+          if(verbosity >= Verbosity::debug && El::mpi::Rank() == 0)
+            El::Output("Load imbalance: ", imbalance);
+          if(imbalance > parameters.rebalance_threshold)
+            {
+              // New mapping is computed from the average timings
+              block_timings_ms = average_block_timings_ms;
+              if(verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
+                {
+                  El::Output("Load imbalance ", imbalance,
+                             " exceeds rebalanceThreshold=",
+                             parameters.rebalance_threshold,
+                             ", redistributing blocks");
+                }
+              // NB: iterations.json is left open
+              return SDP_Solver_Terminate_Reason::RebalanceRequired;
+            }
+        }
     }
   if(El::mpi::Rank() == 0 && !iterations_json_path.empty())
     {
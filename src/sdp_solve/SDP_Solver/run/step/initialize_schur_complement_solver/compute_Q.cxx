@@ -44,11 +44,30 @@ void initialize_schur_off_diagonal(
       // schur_off_diagonal = L^{-1} B
       Scoped_Timer solve_timer(timers, "solve_" + block_index_string);
 
-      schur_off_diagonal.blocks.push_back(sdp.free_var_matrix.blocks[block]);
-      El::Trsm(El::LeftOrRightNS::LEFT, El::UpperOrLowerNS::LOWER,
-               El::OrientationNS::NORMAL, El::UnitOrNonUnitNS::NON_UNIT,
-               El::BigFloat(1), schur_complement_cholesky.blocks[block],
-               schur_off_diagonal.blocks[block]);
+      auto &P = schur_off_diagonal.blocks.emplace_back(
+        sdp.free_var_matrix.blocks[block]);
+      // Zero columns of B remain zero in L^{-1} B,
+      // so we solve only for nonzero column ranges.
+      const auto &nonzero_columns = sdp.free_var_nonzero_columns.at(block);
+      if(nonzero_columns.size() == 1 && nonzero_columns.front().beg == 0
+         && nonzero_columns.front().end == P.Width())
+        {
+          El::Trsm(El::LeftOrRightNS::LEFT, El::UpperOrLowerNS::LOWER,
+                   El::OrientationNS::NORMAL, El::UnitOrNonUnitNS::NON_UNIT,
+                   El::BigFloat(1), schur_complement_cholesky.blocks[block],
+                   P);
+        }
+      else
+        {
+          for(const auto &columns : nonzero_columns)
+            {
+              auto P_columns = P(El::ALL, columns);
+              El::Trsm(El::LeftOrRightNS::LEFT, El::UpperOrLowerNS::LOWER,
+                       El::OrientationNS::NORMAL,
+                       El::UnitOrNonUnitNS::NON_UNIT, El::BigFloat(1),
+                       schur_complement_cholesky.blocks[block], P_columns);
+            }
+        }
       block_timings_ms(global_block_index, 0)
         += solve_timer.elapsed_milliseconds();
     }
@@ -1,4 +1,5 @@
 #include "sdp_solve/Block_Diagonal_Matrix.hxx"
+#include "sdp_solve/SDP_Solver/run/for_each_block.hxx"
 
 // Minimum eigenvalue of A.  A is assumed to be symmetric.
 
@@ -7,27 +8,43 @@
 // Still ugly.
 El::BigFloat min_eigenvalue(Block_Diagonal_Matrix &A)
 {
-  El::BigFloat local_min(El::limits::Max<El::BigFloat>());
+  std::vector<El::BigFloat> block_min(A.blocks.size(),
+                                      El::limits::Max<El::BigFloat>());
+
+  for_each_block(A.blocks, [&](const size_t b, const bool local) {
+    auto &block = A.blocks[b];
+    /// There is a bug in El::HermitianEig when there is more than
+    /// one level of recursion when computing eigenvalues.  One fix
+    /// is to increase the cutoff so that there is no more than one
+    /// level of recursion.
 
-  for(auto &block : A.blocks)
-    {
-      El::DistMatrix<El::BigFloat, El::VR, El::STAR> eigenvalues(block.Grid());
-      /// There is a bug in El::HermitianEig when there is more than
-      /// one level of recursion when computing eigenvalues.  One fix
-      /// is to increase the cutoff so that there is no more than one
-      /// level of recursion.
+    /// An alternate workaround is to compute both eigenvalues and
+    /// eigenvectors, but that seems to be significantly slower.
+    El::HermitianEigCtrl<El::BigFloat> hermitian_eig_ctrl;
+    hermitian_eig_ctrl.tridiagEigCtrl.dcCtrl.cutoff = block.Height() / 2 + 1;
 
-      /// An alternate workaround is to compute both eigenvalues and
-      /// eigenvectors, but that seems to be significantly slower.
-      El::HermitianEigCtrl<El::BigFloat> hermitian_eig_ctrl;
-      hermitian_eig_ctrl.tridiagEigCtrl.dcCtrl.cutoff = block.Height() / 2 + 1;
+    /// The default number of iterations is 40.  That is sometimes
+    /// not enough, so we bump it up significantly.
+    hermitian_eig_ctrl.tridiagEigCtrl.dcCtrl.secularCtrl.maxIterations = 16384;
+    if(local)
+      {
+        El::Matrix<El::BigFloat> eigenvalues;
+        El::HermitianEig(El::UpperOrLowerNS::LOWER, block.Matrix(),
+                         eigenvalues, hermitian_eig_ctrl);
+        block_min[b] = El::Min(block_min[b], El::Min(eigenvalues));
+      }
+    else
+      {
+        El::DistMatrix<El::BigFloat, El::VR, El::STAR> eigenvalues(
+          block.Grid());
+        El::HermitianEig(El::UpperOrLowerNS::LOWER, block, eigenvalues,
+                         hermitian_eig_ctrl);
+        block_min[b] = El::Min(block_min[b], El::Min(eigenvalues));
+      }
+  });
 
-      /// The default number of iterations is 40.  That is sometimes
-      /// not enough, so we bump it up significantly.
-      hermitian_eig_ctrl.tridiagEigCtrl.dcCtrl.secularCtrl.maxIterations = 16384;
-      El::HermitianEig(El::UpperOrLowerNS::LOWER, block, eigenvalues,
-                       hermitian_eig_ctrl);
-      local_min = El::Min(local_min, El::Min(eigenvalues));
-    }
+  El::BigFloat local_min(El::limits::Max<El::BigFloat>());
+  for(const auto &value : block_min)
+    local_min = El::Min(local_min, value);
   return El::mpi::AllReduce(local_min, El::mpi::MIN, El::mpi::COMM_WORLD);
 }
@@ -18,6 +18,8 @@ enum class SDP_Solver_Terminate_Reason
   PrimalStepTooSmall,
   DualStepTooSmall,
   SIGTERM_Received,
+  // Not a final result: sdpb redistributes blocks and continues iterations.
+  RebalanceRequired,
 };
 
 std::ostream &
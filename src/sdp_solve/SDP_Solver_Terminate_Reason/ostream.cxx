@@ -39,6 +39,9 @@ operator<<(std::ostream &os, const SDP_Solver_Terminate_Reason &r)
     case SDP_Solver_Terminate_Reason::SIGTERM_Received:
       os << "SIGTERM signal received";
       break;
+    case SDP_Solver_Terminate_Reason::RebalanceRequired:
+      os << "rebalanceThreshold exceeded";
+      break;
     default: RUNTIME_ERROR("Unknown SDP_Solver_Terminate_Reason=", r);
     }
   return os;
@@ -15,8 +15,10 @@ struct Solver_Parameters
   int64_t max_iterations, max_runtime, checkpoint_interval;
   size_t max_shared_memory_bytes;
   bool find_primal_feasible, find_dual_feasible, detect_primal_feasible_jump,
-    detect_dual_feasible_jump;
+    detect_dual_feasible_jump, dynamic_blas_jobs, numa_aware_shared_memory,
+    huge_pages, pipeline_shared_memory;
   size_t precision;
+  double rebalance_threshold;
 
   El::BigFloat duality_gap_threshold, primal_error_threshold,
     dual_error_threshold, initial_matrix_scale_primal,
@@ -69,6 +69,43 @@ boost::program_options::options_description Solver_Parameters::options()
     "in bytes."
     " Optional suffixes: B (bytes), K or KB (kilobytes), M or MB (megabytes), "
     "G or GB (gigabytes).");
+  result.add_options()(
+    "dynamicBlasJobs",
+    boost::program_options::bool_switch(&dynamic_blas_jobs)
+      ->default_value(false),
+    "When computing Q, let MPI processes on a node pull BLAS jobs "
+    "from a shared queue, heaviest jobs first, instead of using "
+    "a static schedule. This can help if BLAS timings vary between "
+    "processes, e.g. due to cache or NUMA effects. "
+    "Actual and estimated static makespans are written to profiling data "
+    "(except for --pipelineSharedMemory, where this would require "
+    "extra synchronization).");
+  result.add_options()(
+    "numaAwareSharedMemory",
+    boost::program_options::bool_switch(&numa_aware_shared_memory)
+      ->default_value(false),
+    "Split shared memory windows used for computing Q into segments, "
+    "one per NUMA node (socket), placed in the memory of that node. "
+    "BLAS jobs are executed preferably by processes on the NUMA node "
+    "holding their data. Implies --dynamicBlasJobs.");
+  result.add_options()(
+    "hugePages",
+    boost::program_options::bool_switch(&huge_pages)->default_value(false),
+    "Back shared memory windows used for computing Q by 2MB transparent "
+    "huge pages, reducing TLB misses during BLAS calls. "
+    "Falls back to regular pages if huge pages are not available. "
+    "Huge page usage and TLB misses (if hardware counters are accessible) "
+    "are written to profiling data.");
+  result.add_options()(
+    "pipelineSharedMemory",
+    boost::program_options::bool_switch(&pipeline_shared_memory)
+      ->default_value(false),
+    "If shared memory windows used for computing Q are split "
+    "(see --maxSharedMemory), allocate a second set of input windows "
+    "and compute residues for the next part of Q while other processes "
+    "are still doing BLAS jobs or restoring the current part. "
+    "This reduces waiting time, but the input windows become twice smaller "
+    "and thus are split into more parts.");
   result.add_options()(
     "dualityGapThreshold",
     boost::program_options::value<El::BigFloat>(&duality_gap_threshold)
@@ -136,6 +173,17 @@ boost::program_options::options_description Solver_Parameters::options()
       ->default_value(El::BigFloat("1e100", 10)),
     "Terminate if the complementarity mu = Tr(X Y)/dim(X) "
     "exceeds this value.");
+  result.add_options()(
+    "rebalanceThreshold",
+    boost::program_options::value<double>(&rebalance_threshold)
+      ->default_value(0),
+    "Redistribute SDP blocks among MPI processes during the run "
+    "if the load imbalance measured from block timings exceeds this value. "
+    "The imbalance is the ratio of the maximal per-process load "
+    "for the current block mapping to that for the optimal mapping, "
+    "so the threshold should be greater than 1, e.g. 1.2. "
+    "If set, SDPB skips the timing run. "
+    "Set to 0 to disable rebalancing.");
   result.add_options()(
     "checkpointDir,c",
     boost::program_options::value<fs::path>(&checkpoint_out),
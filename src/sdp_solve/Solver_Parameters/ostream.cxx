@@ -9,6 +9,12 @@ std::ostream &operator<<(std::ostream &os, const Solver_Parameters &p)
      << "checkpointInterval           = " << p.checkpoint_interval << '\n'
      << "maxSharedMemory              = "
      << pretty_print_bytes(p.max_shared_memory_bytes, true) << '\n'
+     << "dynamicBlasJobs              = " << p.dynamic_blas_jobs << '\n'
+     << "numaAwareSharedMemory        = " << p.numa_aware_shared_memory
+     << '\n'
+     << "hugePages                    = " << p.huge_pages << '\n'
+     << "pipelineSharedMemory         = " << p.pipeline_shared_memory
+     << '\n'
      << "findPrimalFeasible           = " << p.find_primal_feasible << '\n'
      << "findDualFeasible             = " << p.find_dual_feasible << '\n'
      << "detectPrimalFeasibleJump     = " << p.detect_primal_feasible_jump
@@ -31,6 +37,7 @@ std::ostream &operator<<(std::ostream &os, const Solver_Parameters &p)
      << '\n'
      << "stepLengthReduction          = " << p.step_length_reduction << '\n'
      << "maxComplementarity           = " << p.max_complementarity << '\n'
+     << "rebalanceThreshold           = " << p.rebalance_threshold << '\n'
      << "initialCheckpointDir         = " << p.checkpoint_in << '\n'
      << "checkpointDir                = " << p.checkpoint_out << '\n';
   return os;
@@ -9,6 +9,10 @@ boost::property_tree::ptree to_property_tree(const Solver_Parameters &p)
   result.put("maxRuntime", p.max_runtime);
   result.put("maxSharedMemory", p.max_shared_memory_bytes,
              String_To_Bytes_Translator());
+  result.put("dynamicBlasJobs", p.dynamic_blas_jobs);
+  result.put("numaAwareSharedMemory", p.numa_aware_shared_memory);
+  result.put("hugePages", p.huge_pages);
+  result.put("pipelineSharedMemory", p.pipeline_shared_memory);
   result.put("checkpointInterval", p.checkpoint_interval);
   result.put("findPrimalFeasible", p.find_primal_feasible);
   result.put("findDualFeasible", p.find_dual_feasible);
@@ -25,6 +29,7 @@ boost::property_tree::ptree to_property_tree(const Solver_Parameters &p)
   result.put("infeasibleCenteringParameter", p.infeasible_centering_parameter);
   result.put("stepLengthReduction", p.step_length_reduction);
   result.put("maxComplementarity", p.max_complementarity);
+  result.put("rebalanceThreshold", p.rebalance_threshold);
   result.put("initialCheckpointDir", p.checkpoint_in.string());
   result.put("checkpointDir", p.checkpoint_out.string());
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+
+// Index of zip archive entries, parsed from the zip central directory.
+//
+// pmp2sdp writes sdp.zip without compression, so that each entry
+// is stored as a contiguous byte range within the file.
+// Thus, we can read any entry directly via Zip_Entry_Reader
+// instead of scanning through all previous entries with Archive_Reader.
+struct Zip_Index
+{
+  struct Entry
+  {
+    uint16_t flags = 0;
+    uint16_t compression_method = 0;
+    uint64_t compressed_size = 0;
+    uint64_t uncompressed_size = 0;
+    uint64_t local_header_offset = 0;
+
+    // Entry is neither compressed nor encrypted
+    // and can be read directly from the file.
+    [[nodiscard]] bool is_stored() const
+    {
+      return compression_method == 0 && (flags & 1) == 0
+             && compressed_size == uncompressed_size;
+    }
+  };
+
+  std::unordered_map<std::string, Entry> entries;
+
+  // Returns std::nullopt if the file is not a (valid) zip archive,
+  // e.g. tar or 7z, which can be read only sequentially by Archive_Reader.
+  static std::optional<Zip_Index>
+  try_read(const std::filesystem::path &zip_path);
+
+  // Returns nullptr if entry not found
+  [[nodiscard]] const Entry *find(const std::string &name) const;
+
+  // Offset of the entry data from the beginning of the zip file
+  static uint64_t
+  get_data_offset(const std::filesystem::path &zip_path, const Entry &entry);
+};
+
+// Reads a single stored (uncompressed) entry of zip archive.
+struct Zip_Entry_Reader : public std::streambuf
+{
+  std::ifstream file;
+  std::array<char, 8192> buffer;
+  uint64_t num_bytes_left;
+  Zip_Entry_Reader(const std::filesystem::path &zip_path,
+                   const Zip_Index::Entry &entry);
+  Zip_Entry_Reader() = delete;
+  ~Zip_Entry_Reader() override = default;
+
+  int underflow() override;
+};
@@ -0,0 +1,30 @@
+#include "../Zip_Index.hxx"
+#include "sdpb_util/assert.hxx"
+
+Zip_Entry_Reader::Zip_Entry_Reader(const std::filesystem::path &zip_path,
+                                   const Zip_Index::Entry &entry)
+    : file(zip_path, std::ios::binary), num_bytes_left(entry.compressed_size)
+{
+  ASSERT(entry.is_stored(),
+         "Zip_Entry_Reader can read only uncompressed entries from ",
+         zip_path);
+  file.seekg(Zip_Index::get_data_offset(zip_path, entry));
+  setg(buffer.data(), buffer.data(), buffer.data());
+}
+
+int Zip_Entry_Reader::underflow()
+{
+  if(gptr() == egptr() && num_bytes_left > 0)
+    {
+      const auto num_bytes
+        = std::min<uint64_t>(buffer.size(), num_bytes_left);
+      file.read(buffer.data(), num_bytes);
+      ASSERT(file.gcount() == static_cast<std::streamsize>(num_bytes),
+             "Error reading zip entry: expected ", num_bytes,
+             " bytes, got ", file.gcount());
+      num_bytes_left -= num_bytes;
+      setg(buffer.data(), buffer.data(), buffer.data() + num_bytes);
+    }
+  return (gptr() == egptr()) ? std::char_traits<char>::eof()
+                             : std::char_traits<char>::to_int_type(*gptr());
+}
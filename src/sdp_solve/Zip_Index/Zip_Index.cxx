@@ -0,0 +1,174 @@
+#include "../Zip_Index.hxx"
+#include "read_little_endian.hxx"
+
+#include <algorithm>
+#include <vector>
+
+// Zip format specification:
+// https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  constexpr uint32_t eocd_signature = 0x06054b50;
+  constexpr uint32_t zip64_eocd_locator_signature = 0x07064b50;
+  constexpr uint32_t zip64_eocd_signature = 0x06064b50;
+  constexpr uint32_t central_header_signature = 0x02014b50;
+  constexpr uint16_t zip64_extra_field_id = 0x0001;
+
+  constexpr size_t eocd_size = 22;
+  constexpr size_t zip64_eocd_locator_size = 20;
+  constexpr size_t zip64_eocd_size = 56;
+  constexpr size_t central_header_size = 46;
+
+  bool read_bytes(std::ifstream &file, const uint64_t offset,
+                  const size_t count, char *data)
+  {
+    file.seekg(offset);
+    file.read(data, count);
+    return file.good();
+  }
+}
+
+std::optional<Zip_Index> Zip_Index::try_read(const fs::path &zip_path)
+{
+  std::ifstream file(zip_path, std::ios::binary);
+  if(!file.good())
+    return {};
+  file.seekg(0, std::ios::end);
+  const uint64_t file_size = file.tellg();
+  if(file_size < eocd_size)
+    return {};
+
+  // Find End of Central Directory record (EOCD).
+  // It is located at the end of the file,
+  // followed only by a comment of at most 65535 bytes.
+  const uint64_t tail_size
+    = std::min<uint64_t>(file_size, eocd_size + 0xFFFF);
+  std::vector<char> tail(tail_size);
+  if(!read_bytes(file, file_size - tail_size, tail_size, tail.data()))
+    return {};
+  std::optional<uint64_t> eocd_pos;
+  for(int64_t pos = tail_size - eocd_size; pos >= 0; --pos)
+    {
+      if(read_little_endian<uint32_t>(&tail[pos]) == eocd_signature)
+        {
+          eocd_pos = pos;
+          break;
+        }
+    }
+  if(!eocd_pos.has_value())
+    return {};
+  const char *eocd = &tail[eocd_pos.value()];
+
+  uint64_t num_entries = read_little_endian<uint16_t>(eocd + 10);
+  uint64_t central_directory_size = read_little_endian<uint32_t>(eocd + 12);
+  uint64_t central_directory_offset = read_little_endian<uint32_t>(eocd + 16);
+
+  // Zip64 archive (large number of entries or large file),
+  // Zip64 EOCD locator precedes EOCD.
+  if(num_entries == 0xFFFF || central_directory_size == 0xFFFFFFFF
+     || central_directory_offset == 0xFFFFFFFF)
+    {
+      const uint64_t eocd_offset = file_size - tail_size + eocd_pos.value();
+      if(eocd_offset < zip64_eocd_locator_size)
+        return {};
+      std::array<char, zip64_eocd_locator_size> locator;
+      if(!read_bytes(file, eocd_offset - zip64_eocd_locator_size,
+                     locator.size(), locator.data())
+         || read_little_endian<uint32_t>(locator.data())
+              != zip64_eocd_locator_signature)
+        return {};
+
+      const auto zip64_eocd_offset
+        = read_little_endian<uint64_t>(locator.data() + 8);
+      std::array<char, zip64_eocd_size> zip64_eocd;
+      if(zip64_eocd_offset + zip64_eocd_size > file_size
+         || !read_bytes(file, zip64_eocd_offset, zip64_eocd.size(),
+                        zip64_eocd.data())
+         || read_little_endian<uint32_t>(zip64_eocd.data())
+              != zip64_eocd_signature)
+        return {};
+      num_entries = read_little_endian<uint64_t>(zip64_eocd.data() + 32);
+      central_directory_size
+        = read_little_endian<uint64_t>(zip64_eocd.data() + 40);
+      central_directory_offset
+        = read_little_endian<uint64_t>(zip64_eocd.data() + 48);
+    }
+
+  if(central_directory_offset + central_directory_size > file_size)
+    return {};
+  std::vector<char> central_directory(central_directory_size);
+  if(!read_bytes(file, central_directory_offset, central_directory_size,
+                 central_directory.data()))
+    return {};
+
+  // Parse central directory file headers
+  Zip_Index result;
+  result.entries.reserve(num_entries);
+  uint64_t pos = 0;
+  for(uint64_t entry_index = 0; entry_index < num_entries; ++entry_index)
+    {
+      if(pos + central_header_size > central_directory_size)
+        return {};
+      const char *header = &central_directory[pos];
+      if(read_little_endian<uint32_t>(header) != central_header_signature)
+        return {};
+
+      Entry entry;
+      entry.flags = read_little_endian<uint16_t>(header + 8);
+      entry.compression_method = read_little_endian<uint16_t>(header + 10);
+      entry.compressed_size = read_little_endian<uint32_t>(header + 20);
+      entry.uncompressed_size = read_little_endian<uint32_t>(header + 24);
+      const auto name_length = read_little_endian<uint16_t>(header + 28);
+      const auto extra_length = read_little_endian<uint16_t>(header + 30);
+      const auto comment_length = read_little_endian<uint16_t>(header + 32);
+      entry.local_header_offset = read_little_endian<uint32_t>(header + 42);
+
+      const uint64_t header_size
+        = central_header_size + name_length + extra_length + comment_length;
+      if(pos + header_size > central_directory_size)
+        return {};
+
+      std::string name(header + central_header_size, name_length);
+
+      // Zip64 extended information:
+      // 64-bit values for the fields set to 0xFFFFFFFF, in fixed order.
+      const char *extra = header + central_header_size + name_length;
+      for(size_t extra_pos = 0; extra_pos + 4 <= extra_length;)
+        {
+          const auto id = read_little_endian<uint16_t>(extra + extra_pos);
+          const auto size
+            = read_little_endian<uint16_t>(extra + extra_pos + 2);
+          if(extra_pos + 4 + size > extra_length)
+            return {};
+          if(id == zip64_extra_field_id)
+            {
+              const char *field = extra + extra_pos + 4;
+              size_t field_pos = 0;
+              for(uint64_t *value :
+                  {&entry.uncompressed_size, &entry.compressed_size,
+                   &entry.local_header_offset})
+                {
+                  if(*value == 0xFFFFFFFF && field_pos + 8 <= size)
+                    {
+                      *value = read_little_endian<uint64_t>(field + field_pos);
+                      field_pos += 8;
+                    }
+                }
+            }
+          extra_pos += 4 + size;
+        }
+
+      result.entries.emplace(std::move(name), entry);
+      pos += header_size;
+    }
+  return result;
+}
+
+const Zip_Index::Entry *Zip_Index::find(const std::string &name) const
+{
+  const auto it = entries.find(name);
+  return it == entries.end() ? nullptr : &it->second;
+}
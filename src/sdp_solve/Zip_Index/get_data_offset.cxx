@@ -0,0 +1,31 @@
+#include "../Zip_Index.hxx"
+#include "read_little_endian.hxx"
+#include "sdpb_util/assert.hxx"
+
+namespace
+{
+  constexpr uint32_t local_header_signature = 0x04034b50;
+  constexpr size_t local_header_size = 30;
+}
+
+uint64_t Zip_Index::get_data_offset(const std::filesystem::path &zip_path,
+                                    const Entry &entry)
+{
+  // Local file header may have different extra field than central directory,
+  // so we have to read it to find the beginning of the data.
+  std::ifstream file(zip_path, std::ios::binary);
+  std::array<char, local_header_size> local_header;
+  file.seekg(entry.local_header_offset);
+  file.read(local_header.data(), local_header.size());
+  ASSERT(file.good()
+           && read_little_endian<uint32_t>(local_header.data())
+                == local_header_signature,
+         "Invalid zip local file header at offset=", entry.local_header_offset,
+         " in ", zip_path);
+  const auto name_length
+    = read_little_endian<uint16_t>(local_header.data() + 26);
+  const auto extra_length
+    = read_little_endian<uint16_t>(local_header.data() + 28);
+  return entry.local_header_offset + local_header_size + name_length
+         + extra_length;
+}
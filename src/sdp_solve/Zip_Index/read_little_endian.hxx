@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+// All integers in zip headers are little-endian
+template <class T> T read_little_endian(const char *data)
+{
+  T result = 0;
+  for(size_t i = 0; i < sizeof(T); ++i)
+    {
+      result |= static_cast<T>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+  return result;
+}
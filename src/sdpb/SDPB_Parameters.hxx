@@ -14,12 +14,14 @@ struct SDPB_Parameters
   bool no_final_checkpoint;
   size_t proc_granularity;
   bool require_initial_checkpoint = false;
+  bool memory_aware_mapping;
+  size_t num_threads;
   Write_Solution write_solution;
 
   Solver_Parameters solver;
   Verbosity verbosity;
 
-  std::filesystem::path sdp_path, out_directory, param_path;
+  std::filesystem::path sdp_path, out_directory, param_path, cost_model_path;
 
   SDPB_Parameters(int argc, char *argv[]);
   bool is_valid() const { return !sdp_path.empty(); }
@@ -57,6 +57,26 @@ SDPB_Parameters::SDPB_Parameters(int argc, char *argv[])
     "not bitwise identical to, the original run.\nTo only output the result "
     "(because, for example, you only want to know if SDPB found a primal "
     "feasible point), set this to an empty string.");
+  basic_options.add_options()(
+    "costModel", po::value<fs::path>(&cost_model_path),
+    "JSON file with block cost model calibrated for the current machine. "
+    "If block_timings are not available, SDPB estimates block costs "
+    "using this model instead of doing a timing run. "
+    "If the file does not exist or does not contain the model for the "
+    "current precision, SDPB runs a short benchmark and saves the result "
+    "to this file.");
+  basic_options.add_options()(
+    "memoryAwareMapping",
+    po::bool_switch(&memory_aware_mapping)->default_value(false),
+    "When assigning blocks to nodes, keep the estimated memory of blocks "
+    "on each node below the limit derived from MemTotal in /proc/meminfo. "
+    "Blocks are moved between nodes if necessary, at the price of a worse "
+    "time balance. SDPB fails if the blocks cannot fit into memory.");
+  basic_options.add_options()(
+    "numThreads", po::value<size_t>(&num_threads)->default_value(1),
+    "Number of threads per process. Blocks owned by a single process are "
+    "processed concurrently by these threads. Running fewer processes per "
+    "node with several threads each reduces memory usage and MPI overhead.");
   basic_options.add_options()(
     "verbosity",
     po::value<Verbosity>(&verbosity)->default_value(Verbosity::regular),
@@ -147,6 +167,7 @@ SDPB_Parameters::SDPB_Parameters(int argc, char *argv[])
 
           ASSERT(fs::exists(sdp_path),
                  "sdp directory does not exist:", sdp_path);
+          ASSERT(num_threads > 0, "--numThreads should be positive");
 
           if(variables_map.count("outDir") == 0)
             {
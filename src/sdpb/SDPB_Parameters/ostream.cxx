@@ -9,6 +9,9 @@ std::ostream &operator<<(std::ostream &os, const SDPB_Parameters &p)
      << "noFinalCheckpoint            = " << p.no_final_checkpoint << '\n'
      << "writeSolution                = " << p.write_solution << '\n'
      << "procGranularity              = " << p.proc_granularity << '\n'
+     << "costModel                    = " << p.cost_model_path << '\n'
+     << "memoryAwareMapping           = " << p.memory_aware_mapping << '\n'
+     << "numThreads                   = " << p.num_threads << '\n'
      << "verbosity                    = " << static_cast<int>(p.verbosity)
      << '\n';
   return os;
@@ -9,6 +9,9 @@ boost::property_tree::ptree to_property_tree(const SDPB_Parameters &p)
   result.put("noFinalCheckpoint", p.no_final_checkpoint);
   result.put("writeSolution", p.write_solution);
   result.put("procGranularity", p.proc_granularity);
+  result.put("costModel", p.cost_model_path.string());
+  result.put("memoryAwareMapping", p.memory_aware_mapping);
+  result.put("numThreads", p.num_threads);
   result.put("verbosity", static_cast<int>(p.verbosity));
 
   return result;
@@ -7,6 +7,7 @@
 
 #include "SDPB_Parameters.hxx"
 #include "sdpb_util/Proc_Meminfo.hxx"
+#include "sdpb_util/Thread_Pool.hxx"
 #include "sdpb_util/ostream/pretty_print_bytes.hxx"
 
 #include <El.hpp>
@@ -15,7 +16,7 @@
 
 namespace fs = std::filesystem;
 
-Timers solve(const Block_Info &block_info, const SDPB_Parameters &parameters,
+Timers solve(Block_Info &block_info, const SDPB_Parameters &parameters,
              const Environment &env,
              const std::chrono::time_point<std::chrono::high_resolution_clock>
                &start_time,
@@ -41,6 +42,7 @@ int main(int argc, char **argv)
         }
 
       Environment::set_precision(parameters.solver.precision);
+      Thread_Pool::set_global_num_threads(parameters.num_threads);
       auto start_time = std::chrono::high_resolution_clock::now();
       if(parameters.verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
         {
@@ -76,16 +78,27 @@ int main(int argc, char **argv)
           El::mpi::Barrier(env.comm_shared_mem);
         }
 
+      std::optional<Block_Cost_Model> cost_model;
+      if(!parameters.cost_model_path.empty())
+        {
+          cost_model = Block_Cost_Model::load_or_calibrate(
+            parameters.cost_model_path, parameters.verbosity);
+        }
       Block_Info block_info(env, parameters.sdp_path,
                             parameters.solver.checkpoint_in,
-                            parameters.proc_granularity, parameters.verbosity);
+                            parameters.proc_granularity, parameters.verbosity,
+                            cost_model, parameters.memory_aware_mapping);
       // Only generate a block_timings file if
       // 1) We are running in parallel
       // 2) We did not load a block_timings file
       // 3) We are not going to load a checkpoint.
+      // 4) Blocks are not rebalanced during the run (see rebalanceThreshold).
+      // 5) Block costs are not estimated by the cost model.
       if(El::mpi::Size(El::mpi::COMM_WORLD) > 1
          && block_info.block_timings_filename.empty()
-         && !exists(parameters.solver.checkpoint_in / "checkpoint.0"))
+         && !exists(parameters.solver.checkpoint_in / "checkpoint.0")
+         && parameters.solver.rebalance_threshold == 0
+         && !cost_model.has_value())
         {
           if(parameters.verbosity >= Verbosity::regular
              && El::mpi::Rank() == 0)
@@ -140,7 +153,8 @@ int main(int argc, char **argv)
           El::mpi::Barrier(El::mpi::COMM_WORLD);
           Block_Info new_info(env, parameters.sdp_path, block_timings_ms,
                               parameters.proc_granularity,
-                              parameters.verbosity);
+                              parameters.verbosity,
+                              parameters.memory_aware_mapping);
           std::swap(block_info, new_info);
 
           auto elapsed_seconds
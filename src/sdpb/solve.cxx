@@ -9,6 +9,7 @@
 #include <cstdlib>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <filesystem>
+#include <memory>
 
 namespace fs = std::filesystem;
 
@@ -20,7 +21,32 @@ void save_solution(
   const std::optional<std::vector<El::BigFloat>> &normalization,
   const Verbosity &verbosity);
 
-Timers solve(const Block_Info &block_info, const SDPB_Parameters &parameters,
+void write_block_timings(const fs::path &checkpoint_out,
+                         const Block_Info &block_info,
+                         const El::Matrix<int32_t> &block_timings_ms,
+                         Verbosity verbosity);
+
+namespace
+{
+  std::unique_ptr<SDP>
+  read_sdp(const SDPB_Parameters &parameters, const Environment &env,
+           const Block_Info &block_info, const El::Grid &grid, Timers &timers)
+  {
+    Scoped_Timer read_sdp_timer(timers, "read_sdp");
+    auto sdp = std::make_unique<SDP>(parameters.sdp_path, block_info, grid,
+                                     timers);
+    if(parameters.verbosity >= Verbosity::debug)
+      {
+        print_allocation_message_per_node(env, "SDP",
+                                          get_allocated_bytes(*sdp));
+      }
+    return sdp;
+  }
+}
+
+// NB: if blocks are redistributed during the run (see rebalanceThreshold),
+// block_info is replaced by the new mapping.
+Timers solve(Block_Info &block_info, const SDPB_Parameters &parameters,
              const Environment &env,
              const std::chrono::time_point<std::chrono::high_resolution_clock>
                &start_time,
@@ -29,30 +55,25 @@ Timers solve(const Block_Info &block_info, const SDPB_Parameters &parameters,
   Timers timers(env, parameters.verbosity);
   Scoped_Timer solve_timer(timers, "sdpb.solve");
 
-  El::Grid grid(block_info.mpi_comm.value);
+  auto grid = std::make_unique<El::Grid>(block_info.mpi_comm.value);
 
-  Scoped_Timer read_sdp_timer(timers, "read_sdp");
-  SDP sdp(parameters.sdp_path, block_info, grid, timers);
-  if(parameters.verbosity >= Verbosity::debug)
-    {
-      print_allocation_message_per_node(env, "SDP", get_allocated_bytes(sdp));
-    }
+  auto sdp = read_sdp(parameters, env, block_info, *grid, timers);
   if(El::mpi::Rank() == 0 && parameters.write_solution.vector_z)
     {
-      ASSERT(sdp.normalization.has_value(),
+      ASSERT(sdp->normalization.has_value(),
              "Please provide SDP with valid normalization.json "
              "or exclude z from --writeSolution arguments.");
     }
-  read_sdp_timer.stop();
 
   Scoped_Timer solver_ctor_timer(timers, "SDP_Solver.ctor");
-  SDP_Solver solver(parameters.solver, parameters.verbosity,
-                    parameters.require_initial_checkpoint, block_info, grid,
-                    sdp.dual_objective_b.Height());
+  auto solver = std::make_unique<SDP_Solver>(
+    parameters.solver, parameters.verbosity,
+    parameters.require_initial_checkpoint, block_info, *grid,
+    sdp->dual_objective_b.Height());
   if(parameters.verbosity >= Verbosity::debug)
     {
       print_allocation_message_per_node(env, "SDP_Solver",
-                                        get_allocated_bytes(solver));
+                                        get_allocated_bytes(*solver));
     }
   solver_ctor_timer.stop();
 
@@ -61,20 +82,76 @@ Timers solve(const Block_Info &block_info, const SDPB_Parameters &parameters,
 
   const auto iterations_json_path
     = parameters.out_directory / "iterations.json";
-  SDP_Solver_Terminate_Reason reason(solver.run(
-    env, parameters.solver, parameters.verbosity, parameters_tree, block_info,
-    sdp, grid, start_time, iterations_json_path, timers, block_timings_ms));
+  // Rebalancing is disabled after max_num_rebalances,
+  // to avoid spending too much time on redistributing blocks
+  // if the timings fluctuate.
+  constexpr size_t max_num_rebalances = 3;
+  auto solver_parameters = parameters.solver;
+  SDP_Solver_Terminate_Reason reason;
+  for(size_t num_rebalances = 0;; ++num_rebalances)
+    {
+      if(num_rebalances >= max_num_rebalances
+         && solver_parameters.rebalance_threshold > 0)
+        {
+          if(parameters.verbosity >= Verbosity::regular
+             && El::mpi::Rank() == 0)
+            El::Output("Blocks were redistributed ", num_rebalances,
+                       " times, disable rebalancing.");
+          solver_parameters.rebalance_threshold = 0;
+        }
+      reason = solver->run(env, solver_parameters, parameters.verbosity,
+                           parameters_tree, block_info, *sdp, *grid,
+                           start_time, iterations_json_path, timers,
+                           block_timings_ms);
+      if(reason != SDP_Solver_Terminate_Reason::RebalanceRequired)
+        break;
+
+      // Compute new block mapping from the last iteration timings
+      // and move everything to it.
+      Scoped_Timer rebalance_timer(timers, "rebalance_"
+                                             + std::to_string(num_rebalances));
+      Block_Info new_block_info(env, parameters.sdp_path, block_timings_ms,
+                                parameters.proc_granularity,
+                                parameters.verbosity,
+                                parameters.memory_aware_mapping);
+      auto new_grid = std::make_unique<El::Grid>(new_block_info.mpi_comm.value);
+      // Release SDP before copying solver to reduce memory peak.
+      // We read it from disk again for the new mapping.
+      const size_t dual_objective_b_height = sdp->dual_objective_b.Height();
+      sdp.reset();
+      {
+        Scoped_Timer redistribute_timer(timers, "redistribute_solver");
+        solver = std::make_unique<SDP_Solver>(*solver, block_info,
+                                              new_block_info, *new_grid,
+                                              dual_objective_b_height);
+      }
+      std::swap(block_info, new_block_info);
+      grid = std::move(new_grid);
+      sdp = read_sdp(parameters, env, block_info, *grid, timers);
+
+      // Binary checkpoints depend on the block mapping,
+      // which is restored from block_timings on restart.
+      // Thus we save both of them now, to keep checkpointDir consistent.
+      if(!parameters.solver.checkpoint_out.empty())
+        {
+          Scoped_Timer save_timer(timers, "save_checkpoint");
+          solver->save_checkpoint(parameters.solver.checkpoint_out,
+                                  parameters.verbosity, parameters_tree);
+          write_block_timings(parameters.solver.checkpoint_out, block_info,
+                              block_timings_ms, parameters.verbosity);
+        }
+    }
 
   if(parameters.verbosity >= Verbosity::regular && El::mpi::Rank() == 0)
     {
       set_stream_precision(std::cout);
       std::cout << "-----" << reason << "-----\n"
                 << '\n'
-                << "primalObjective = " << solver.primal_objective << '\n'
-                << "dualObjective   = " << solver.dual_objective << '\n'
-                << "dualityGap      = " << solver.duality_gap << '\n'
-                << "primalError     = " << solver.primal_error() << '\n'
-                << "dualError       = " << solver.dual_error << '\n'
+                << "primalObjective = " << solver->primal_objective << '\n'
+                << "dualObjective   = " << solver->dual_objective << '\n'
+                << "dualityGap      = " << solver->duality_gap << '\n'
+                << "primalError     = " << solver->primal_error() << '\n'
+                << "dualError       = " << solver->dual_error << '\n'
                 << '\n';
     }
 
@@ -82,7 +159,7 @@ Timers solve(const Block_Info &block_info, const SDPB_Parameters &parameters,
      || !parameters.no_final_checkpoint)
     {
       Scoped_Timer save_timer(timers, "save_checkpoint");
-      solver.save_checkpoint(parameters.solver.checkpoint_out,
+      solver->save_checkpoint(parameters.solver.checkpoint_out,
                              parameters.verbosity, parameters_tree);
     }
 
@@ -91,9 +168,9 @@ Timers solve(const Block_Info &block_info, const SDPB_Parameters &parameters,
     auto runtime = std::chrono::duration_cast<std::chrono::seconds>(
                     std::chrono::high_resolution_clock::now() - start_time)
                     .count();
-    save_solution(solver, reason, runtime, parameters.out_directory,
+    save_solution(*solver, reason, runtime, parameters.out_directory,
                   parameters.write_solution, block_info.block_indices,
-                  sdp.normalization, parameters.verbosity);
+                  sdp->normalization, parameters.verbosity);
   }
 
   if(reason == SDP_Solver_Terminate_Reason::SIGTERM_Received)
@@ -0,0 +1,57 @@
+#include "Dtlb_Miss_Counter.hxx"
+
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+Dtlb_Miss_Counter::Dtlb_Miss_Counter() noexcept
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.config = PERF_COUNT_HW_CACHE_DTLB
+                | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // pid = 0, cpu = -1: calling thread on any CPU
+  fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+Dtlb_Miss_Counter::~Dtlb_Miss_Counter()
+{
+  if(is_available())
+    close(fd);
+}
+
+bool Dtlb_Miss_Counter::is_available() const
+{
+  return fd >= 0;
+}
+
+void Dtlb_Miss_Counter::start()
+{
+  if(!is_available())
+    return;
+  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+void Dtlb_Miss_Counter::stop()
+{
+  if(is_available())
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+}
+
+int64_t Dtlb_Miss_Counter::value() const
+{
+  int64_t result = 0;
+  if(!is_available() || read(fd, &result, sizeof(result)) != sizeof(result))
+    return 0;
+  return result;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+
+#include <cstdint>
+
+// Counts data TLB load misses of the calling thread
+// via Linux perf_event_open(), e.g.
+//
+// Dtlb_Miss_Counter counter;
+// counter.start();
+// do_blas_jobs();
+// counter.stop();
+// if(counter.is_available())
+//   timers.add_counter("dtlb_misses", counter.value());
+//
+// If hardware counters are not accessible
+// (e.g. /proc/sys/kernel/perf_event_paranoid is too strict, or in a VM),
+// is_available() returns false and all calls do nothing.
+struct Dtlb_Miss_Counter : boost::noncopyable
+{
+  Dtlb_Miss_Counter() noexcept;
+  ~Dtlb_Miss_Counter();
+
+  [[nodiscard]] bool is_available() const;
+  void start();
+  void stop();
+  [[nodiscard]] int64_t value() const;
+
+private:
+  int fd = -1;
+};
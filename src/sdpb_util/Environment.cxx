@@ -42,6 +42,10 @@ int Environment::node_index() const
 {
   return _node_index;
 }
+const std::vector<size_t> &Environment::procs_per_node() const
+{
+  return _procs_per_node;
+}
 size_t Environment::initial_node_mem_used() const
 {
   return _initial_node_mem_used;
@@ -82,6 +86,14 @@ void Environment::initialize()
     ASSERT(_node_index >= 0, DEBUG_STRING(_node_index));
     ASSERT(_node_index < _num_nodes, DEBUG_STRING(_node_index),
            DEBUG_STRING(_num_nodes));
+
+    // Only the first rank on each node sets its node size,
+    // then we sum over all ranks.
+    _procs_per_node.resize(_num_nodes, 0);
+    if(comm_shared_mem.Rank() == 0)
+      _procs_per_node.at(_node_index) = comm_shared_mem.Size();
+    El::mpi::AllReduce(_procs_per_node.data(), _procs_per_node.size(),
+                       El::mpi::SUM, El::mpi::COMM_WORLD);
   }
 
   // Initial MemUsed (at SDPB start)
@@ -99,5 +111,6 @@ void Environment::finalize()
 {
   _node_index = -1;
   _num_nodes = -1;
+  _procs_per_node.clear();
   El::mpi::Free(comm_shared_mem);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <El.hpp>
 
+#include <vector>
+
 struct Environment
 {
   // Shared memory communicator.
@@ -19,6 +21,9 @@ struct Environment
   [[nodiscard]] int num_nodes() const;
   // Node index for current rank, 0..(num_nodes-1)
   [[nodiscard]] int node_index() const;
+  // Number of ranks on each node.
+  // Nodes can have different number of ranks, e.g. 64 and 128 cores.
+  [[nodiscard]] const std::vector<size_t> &procs_per_node() const;
 
   // Memory used on a node at the initialization (in bytes)
   [[nodiscard]] size_t initial_node_mem_used() const;
@@ -30,6 +35,7 @@ private:
   size_t _initial_node_mem_used = 0;
   int _num_nodes = -1;
   int _node_index = -1;
+  std::vector<size_t> _procs_per_node;
 
   void initialize();
   void finalize();
@@ -0,0 +1,50 @@
+#include "Memory_Mapped_File.hxx"
+
+#include "assert.hxx"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+Memory_Mapped_File::Memory_Mapped_File(const fs::path &path,
+                                       const uint64_t offset,
+                                       const size_t size)
+    : region_size(size)
+{
+  if(size == 0)
+    return;
+
+  const int fd = open(path.c_str(), O_RDONLY);
+  ASSERT(fd != -1, "Cannot open ", path, ": ", std::strerror(errno));
+
+  // mmap() offset must be a multiple of the page size
+  const uint64_t page_size = sysconf(_SC_PAGE_SIZE);
+  const uint64_t mapping_offset = offset - offset % page_size;
+  const size_t delta = offset - mapping_offset;
+  mapping_size = size + delta;
+  mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd,
+                   mapping_offset);
+  const int mmap_errno = errno;
+  close(fd);
+  ASSERT(mapping != MAP_FAILED, "mmap() failed for ", path,
+         ", offset=", offset, ", size=", size, ": ",
+         std::strerror(mmap_errno));
+
+  // We usually read the data once, from beginning to end
+  madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+  region_begin = static_cast<const char *>(mapping) + delta;
+}
+
+Memory_Mapped_File::Memory_Mapped_File(const fs::path &path)
+    : Memory_Mapped_File(path, 0, fs::file_size(path))
+{}
+
+Memory_Mapped_File::~Memory_Mapped_File()
+{
+  if(mapping != nullptr && mapping != MAP_FAILED)
+    munmap(mapping, mapping_size);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Read-only memory mapping of a file region [offset, offset + size).
+// The region need not be page-aligned, e.g. it can be an uncompressed entry
+// inside a zip archive.
+class Memory_Mapped_File
+{
+public:
+  Memory_Mapped_File(const std::filesystem::path &path, uint64_t offset,
+                     size_t size);
+  // Map the whole file
+  explicit Memory_Mapped_File(const std::filesystem::path &path);
+  ~Memory_Mapped_File();
+
+  Memory_Mapped_File(const Memory_Mapped_File &other) = delete;
+  Memory_Mapped_File &operator=(const Memory_Mapped_File &other) = delete;
+
+  [[nodiscard]] const char *data() const { return region_begin; }
+  [[nodiscard]] size_t size() const { return region_size; }
+
+private:
+  void *mapping = nullptr;
+  size_t mapping_size = 0;
+  const char *region_begin = nullptr;
+  size_t region_size = 0;
+};
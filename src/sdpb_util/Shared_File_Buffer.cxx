@@ -0,0 +1,56 @@
+#include "Shared_File_Buffer.hxx"
+
+#include "assert.hxx"
+
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  size_t get_file_size(const El::mpi::Comm &comm, const fs::path &path)
+  {
+    // Avoid metadata requests from all ranks
+    size_t file_size = 0;
+    int ok = 1;
+    if(comm.Rank() == 0)
+      {
+        std::error_code ec;
+        file_size = fs::file_size(path, ec);
+        ok = !ec;
+      }
+    // All ranks should throw, otherwise the others would wait
+    // forever for the root in the window constructor
+    El::mpi::Broadcast(ok, 0, comm);
+    if(!ok)
+      RUNTIME_ERROR("Failed to get size of ", path);
+    El::mpi::Broadcast(file_size, 0, comm);
+    return file_size;
+  }
+}
+
+Shared_File_Buffer::Shared_File_Buffer(const El::mpi::Comm &shared_memory_comm,
+                                       const fs::path &path)
+    : window(shared_memory_comm, get_file_size(shared_memory_comm, path))
+{
+  // If root fails to read the file, all ranks should throw,
+  // otherwise they will wait forever in the window destructor.
+  std::string error;
+  if(shared_memory_comm.Rank() == 0)
+    {
+      std::ifstream file(path, std::ios::binary);
+      file.read(window.data, window.size);
+      if(!file.good() || static_cast<size_t>(file.gcount()) != window.size)
+        error = El::BuildString("Failed to read ", window.size,
+                                " bytes from ", path);
+    }
+  int ok = error.empty();
+  El::mpi::Broadcast(ok, 0, shared_memory_comm);
+  if(!ok)
+    {
+      if(error.empty())
+        error = El::BuildString("Root rank failed to read ", path);
+      RUNTIME_ERROR(error);
+    }
+  window.Fence();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Shared_Window_Array.hxx"
+
+#include <El.hpp>
+
+#include <filesystem>
+
+// File content shared by all ranks of a communicator.
+// The root (rank 0) reads the file once into a shared memory window,
+// and other ranks access the same memory without touching the filesystem.
+//
+// The constructor and destructor are collective operations:
+// all ranks of the communicator should create the buffer for the same file.
+// shared_memory_comm should contain only ranks from a single node,
+// see Shared_Window_Array.
+class Shared_File_Buffer
+{
+public:
+  Shared_File_Buffer(const El::mpi::Comm &shared_memory_comm,
+                     const std::filesystem::path &path);
+
+  [[nodiscard]] const char *data() const { return window.data; }
+  [[nodiscard]] size_t size() const { return window.size; }
+
+private:
+  Shared_Window_Array<char> window;
+};
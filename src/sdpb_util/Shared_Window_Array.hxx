@@ -1,9 +1,18 @@
 #pragma once
 
 #include "assert.hxx"
+#include "huge_pages.hxx"
+#include "numa_node.hxx"
 
 #include <El.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+#include <unistd.h>
+
 template <class T> class Shared_Window_Array
 {
 public:
@@ -17,6 +26,15 @@ public:
   El::mpi::Comm comm;
   T *data;
   size_t size = 0;
+  // The array is split into contiguous segments [segment_begin[s], segment_begin[s+1]).
+  // In NUMA-aware mode, there is one segment per NUMA node of the ranks,
+  // otherwise a single segment.
+  std::vector<size_t> segment_begin;
+  // Segment belonging to the NUMA node of the current rank
+  size_t segment_index = 0;
+  // True if madvise(MADV_HUGEPAGE) succeeded on the current rank,
+  // see huge_pages.hxx
+  bool huge_pages_advised = false;
 
 public:
   Shared_Window_Array() = default;
@@ -26,8 +44,27 @@ public:
   //
   // It ensures that all ranks in the communicator are on the same node
   // and can share memory.
-  Shared_Window_Array(El::mpi::Comm shared_memory_comm, size_t size)
-      : comm(shared_memory_comm), size(size)
+  //
+  // All memory is allocated by rank=0. Physical pages are placed
+  // by the OS when they are touched for the first time (first-touch policy),
+  // normally in the memory of the NUMA node of the rank writing to it.
+  // If numa_aware=true, the array is split into segments,
+  // one for each NUMA node, proportional to the number of ranks on that node,
+  // and each segment is zeroed (thus first touched) by the ranks
+  // on the corresponding NUMA node.
+  // This spreads the pages over all sockets instead of placing them
+  // wherever the first writer happens to run.
+  //
+  // NUMA node of the current rank is current_numa_node(),
+  // unless numa_node is set (e.g. to emulate several NUMA nodes in tests).
+  //
+  // If huge_pages=true, each rank asks the kernel to back its mapping
+  // of the window by transparent huge pages before the memory is touched.
+  // If huge pages are not available, regular pages are used.
+  Shared_Window_Array(El::mpi::Comm shared_memory_comm, size_t size,
+                      bool numa_aware = false, bool huge_pages = false,
+                      std::optional<int> numa_node = std::nullopt)
+      : comm(shared_memory_comm), size(size), segment_begin{0, size}
   {
     MPI_Aint local_window_size; // number of bytes allocated by current rank
     int disp_unit = sizeof(T);
@@ -44,6 +81,14 @@ public:
     MPI_Win_shared_query(win, 0, &local_window_size, &disp_unit, &data);
     ASSERT_EQUAL(local_window_size, size * sizeof(T));
     ASSERT_EQUAL(disp_unit, sizeof(T));
+    if(huge_pages)
+      {
+        huge_pages_advised = advise_huge_pages(data, size * sizeof(T));
+        // Everyone should call madvise() before anyone touches the memory
+        Fence();
+      }
+    if(numa_aware)
+      first_touch_numa_segments(numa_node.value_or(current_numa_node()));
     Fence();
   }
 
@@ -78,4 +123,72 @@ public:
   void Fence() const { MPI_Win_fence(0, win); }
   T &operator[](size_t index) { return data[index]; }
   const T &operator[](size_t index) const { return data[index]; }
+
+  [[nodiscard]] size_t num_segments() const
+  {
+    return segment_begin.empty() ? 0 : segment_begin.size() - 1;
+  }
+  // Segment containing the element at index
+  [[nodiscard]] size_t segment_of(size_t index) const
+  {
+    ASSERT(index < size, DEBUG_STRING(index), DEBUG_STRING(size));
+    const auto it = std::upper_bound(segment_begin.begin(),
+                                     segment_begin.end() - 1, index);
+    return std::distance(segment_begin.begin(), it) - 1;
+  }
+  // Bytes of the window mapped by huge pages in the current process
+  [[nodiscard]] size_t huge_page_bytes() const
+  {
+    return mapped_huge_page_bytes(data, size * sizeof(T));
+  }
+
+private:
+  void first_touch_numa_segments(const int numa_node)
+  {
+    const int rank = comm.Rank();
+    const int num_ranks = comm.Size();
+    std::vector<int> numa_node_by_rank(num_ranks);
+    El::mpi::AllGather(&numa_node, 1, numa_node_by_rank.data(), 1, comm);
+
+    std::vector<int> numa_nodes(numa_node_by_rank);
+    std::sort(numa_nodes.begin(), numa_nodes.end());
+    numa_nodes.erase(std::unique(numa_nodes.begin(), numa_nodes.end()),
+                     numa_nodes.end());
+    segment_index = std::distance(
+      numa_nodes.begin(),
+      std::lower_bound(numa_nodes.begin(), numa_nodes.end(), numa_node));
+
+    // Segment sizes are proportional to the number of ranks
+    // on each NUMA node. Boundaries are aligned to pages.
+    const size_t page_elements
+      = std::max<size_t>(1, sysconf(_SC_PAGESIZE) / sizeof(T));
+    segment_begin.assign(1, 0);
+    size_t num_ranks_before = 0;
+    for(const int node : numa_nodes)
+      {
+        num_ranks_before += std::count(numa_node_by_rank.begin(),
+                                       numa_node_by_rank.end(), node);
+        size_t end = size * num_ranks_before / num_ranks;
+        end = (end + page_elements - 1) / page_elements * page_elements;
+        segment_begin.push_back(std::min(std::max(end, segment_begin.back()),
+                                         size));
+      }
+    ASSERT_EQUAL(segment_begin.back(), size);
+
+    // Ranks of the current NUMA node split the segment
+    // and touch their parts.
+    const size_t num_node_ranks
+      = std::count(numa_node_by_rank.begin(), numa_node_by_rank.end(),
+                   numa_node);
+    const size_t node_rank
+      = std::count(numa_node_by_rank.begin(),
+                   numa_node_by_rank.begin() + rank, numa_node);
+    const size_t begin = segment_begin.at(segment_index);
+    const size_t length = segment_begin.at(segment_index + 1) - begin;
+    const size_t touch_begin = begin + length * node_rank / num_node_ranks;
+    const size_t touch_end = begin + length * (node_rank + 1) / num_node_ranks;
+    if(touch_end > touch_begin)
+      std::memset(static_cast<void *>(data + touch_begin), 0,
+                  (touch_end - touch_begin) * sizeof(T));
+  }
 };
@@ -0,0 +1,128 @@
+#include "Thread_Pool.hxx"
+
+#include "assert.hxx"
+
+#include <memory>
+
+namespace
+{
+  // Is the current thread executing a Thread_Pool job?
+  thread_local bool inside_job = false;
+
+  std::unique_ptr<Thread_Pool> global_pool;
+}
+
+Thread_Pool::Thread_Pool(const size_t num_threads)
+{
+  ASSERT(num_threads > 0, "Number of threads should be positive");
+  workers.reserve(num_threads - 1);
+  for(size_t i = 1; i < num_threads; ++i)
+    workers.emplace_back([this] { worker_loop(); });
+}
+
+Thread_Pool::~Thread_Pool()
+{
+  {
+    std::lock_guard lock(mutex);
+    stop = true;
+  }
+  batch_started.notify_all();
+  for(auto &worker : workers)
+    worker.join();
+}
+
+void Thread_Pool::parallel_for(const size_t num_jobs,
+                               const std::function<void(size_t)> &job)
+{
+  if(num_jobs == 0)
+    return;
+  if(workers.empty() || num_jobs == 1 || inside_job
+     || !batch_mutex.try_lock())
+    {
+      for(size_t i = 0; i < num_jobs; ++i)
+        job(i);
+      return;
+    }
+  std::lock_guard batch_lock(batch_mutex, std::adopt_lock);
+
+  {
+    std::lock_guard lock(mutex);
+    this->job = &job;
+    this->num_jobs = num_jobs;
+    next_job = 0;
+    num_busy_workers = workers.size();
+    error = nullptr;
+    ++batch_id;
+  }
+  batch_started.notify_all();
+
+  run_jobs();
+
+  std::unique_lock lock(mutex);
+  batch_finished.wait(lock, [this] { return num_busy_workers == 0; });
+  this->job = nullptr;
+  if(error)
+    std::rethrow_exception(error);
+}
+
+void Thread_Pool::run_jobs()
+{
+  inside_job = true;
+  while(true)
+    {
+      size_t index;
+      {
+        std::lock_guard lock(mutex);
+        if(next_job >= num_jobs)
+          break;
+        index = next_job++;
+      }
+      try
+        {
+          (*job)(index);
+        }
+      catch(...)
+        {
+          std::lock_guard lock(mutex);
+          if(!error)
+            error = std::current_exception();
+          // Cancel remaining jobs
+          next_job = num_jobs;
+        }
+    }
+  inside_job = false;
+}
+
+void Thread_Pool::worker_loop()
+{
+  size_t last_batch_id = 0;
+  std::unique_lock lock(mutex);
+  while(true)
+    {
+      batch_started.wait(
+        lock, [&] { return stop || batch_id != last_batch_id; });
+      if(stop)
+        return;
+      last_batch_id = batch_id;
+
+      lock.unlock();
+      run_jobs();
+      lock.lock();
+
+      --num_busy_workers;
+      if(num_busy_workers == 0)
+        batch_finished.notify_one();
+    }
+}
+
+Thread_Pool &Thread_Pool::global()
+{
+  if(!global_pool)
+    global_pool = std::make_unique<Thread_Pool>(1);
+  return *global_pool;
+}
+
+void Thread_Pool::set_global_num_threads(const size_t num_threads)
+{
+  global_pool = std::make_unique<Thread_Pool>(num_threads);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads for independent jobs inside a single rank,
+// e.g. MPFR computations of bilinear bases and sample scalings in pmp2sdp.
+//
+// parallel_for() is executed by the workers and by the calling thread.
+// Nested calls (from inside a job) and concurrent calls from other threads
+// do not wait for the pool, but run sequentially in the calling thread.
+class Thread_Pool
+{
+public:
+  // Total number of threads, including the calling thread,
+  // i.e. num_threads - 1 workers are started.
+  explicit Thread_Pool(size_t num_threads);
+  ~Thread_Pool();
+
+  Thread_Pool(const Thread_Pool &other) = delete;
+  Thread_Pool &operator=(const Thread_Pool &other) = delete;
+
+  [[nodiscard]] size_t num_threads() const { return workers.size() + 1; }
+
+  // Call job(i) for each i in [0, num_jobs) and wait until all calls finish.
+  // If some job throws, remaining jobs are cancelled
+  // and the first exception is rethrown.
+  void parallel_for(size_t num_jobs, const std::function<void(size_t)> &job);
+
+  // Process-wide pool, single-threaded by default.
+  static Thread_Pool &global();
+  // Should be called at startup, when no jobs are running,
+  // and after Environment::set_precision(), so that workers see
+  // the correct default precision also if Boost keeps it per thread.
+  static void set_global_num_threads(size_t num_threads);
+
+private:
+  std::vector<std::thread> workers;
+
+  // Allows only one parallel_for() at a time
+  std::mutex batch_mutex;
+
+  // Current batch, guarded by mutex (except for next_job)
+  std::mutex mutex;
+  std::condition_variable batch_started;
+  std::condition_variable batch_finished;
+  const std::function<void(size_t)> *job = nullptr;
+  size_t num_jobs = 0;
+  size_t next_job = 0;
+  size_t num_busy_workers = 0;
+  size_t batch_id = 0;
+  std::exception_ptr error;
+  bool stop = false;
+
+  void worker_loop();
+  void run_jobs();
+};
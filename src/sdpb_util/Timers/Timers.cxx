@@ -47,6 +47,10 @@ Timer &Timers::add_and_start(const std::string &name)
   named_timers.emplace_back(full_name, Timer());
   return named_timers.back().second;
 }
+void Timers::add_counter(const std::string &name, const int64_t value)
+{
+  named_counters.emplace_back(prefix + name, value);
+}
 void Timers::write_profile(const std::filesystem::path &path) const
 {
   if(!path.parent_path().empty())
@@ -54,16 +58,19 @@ void Timers::write_profile(const std::filesystem::path &path) const
   std::ofstream f(path);
 
   f << "{" << '\n';
-  for(auto it(named_timers.begin()); it != named_timers.end();)
-    {
-      f << "    {\"" << it->first << "\", " << it->second << "}";
-      ++it;
-      if(it != named_timers.end())
-        {
-          f << ",";
-        }
-      f << '\n';
-    }
+  bool first = true;
+  auto write_entry = [&f, &first](const std::string &name, const auto &value) {
+    if(!first)
+      f << "," << '\n';
+    first = false;
+    f << "    {\"" << name << "\", " << value << "}";
+  };
+  for(const auto &[name, timer] : named_timers)
+    write_entry(name, timer);
+  for(const auto &[name, value] : named_counters)
+    write_entry(name, value);
+  if(!first)
+    f << '\n';
   f << "}" << '\n';
 
   ASSERT(f.good(), "Error when writing to: ", path);
@@ -28,6 +28,9 @@ private:
   // Scoped_Timer holds reference to timer, which would be invalidated after reallocation.
   // TODO refactor timers in a way that prevents such obscure bugs.
   std::list<std::pair<std::string, Timer>> named_timers;
+  // Integer statistics, e.g. cache hits/misses.
+  // Written to profile together with timers.
+  std::list<std::pair<std::string, int64_t>> named_counters;
   std::string prefix;
 
   Verbosity verbosity = Verbosity::regular;
@@ -48,6 +51,8 @@ private:
   Timer &add_and_start(const std::string &name);
 
 public:
+  // Add counter with current prefix, e.g. "read_pmp.parse.cache.hits"
+  void add_counter(const std::string &name, int64_t value);
   void write_profile(const std::filesystem::path &path) const;
 
   [[nodiscard]] int64_t elapsed_milliseconds(const std::string &s) const;
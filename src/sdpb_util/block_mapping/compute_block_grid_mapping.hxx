@@ -7,7 +7,9 @@
 // major difference from the classical bin-packing problem is that we
 // have a fixed set of bins.  The capacity of each node is also
 // somewhat elastic, in that we can cram more blocks into a node if
-// they will not fit anywhere else.
+// they will not fit anywhere else.  Nodes can have different number
+// of procs (e.g. 64- and 128-core nodes), so node capacity is
+// proportional to its number of procs.
 
 // This algorithm starts by assigning blocks to nodes, where the
 // number of procs for a given block is
@@ -43,11 +45,16 @@
 //
 // 2) When large blocks are forced to fit into a node, there is no
 // sharing of procs between the existing block_maps and the new entry.
+//
+// To address these issues, we take the result as a starting point
+// for improve_block_grid_mapping(), which moves blocks and procs
+// between block_maps to reduce the maximal cost per proc.
 
 #pragma once
 
 #include "Block_Cost.hxx"
 #include "Block_Map.hxx"
+#include "improve_block_grid_mapping.hxx"
 #include "sdpb_util/assert.hxx"
 
 #include <algorithm>
@@ -55,12 +62,13 @@
 #include <numeric>
 #include <optional>
 
+// procs_per_node[node] is the number of procs on a given node.
 inline std::vector<std::vector<Block_Map>>
-compute_block_grid_mapping(const size_t &procs_per_node,
-                           const size_t &num_nodes,
+compute_block_grid_mapping(const std::vector<size_t> &procs_per_node,
                            std::vector<Block_Cost> block_costs)
 {
   //NB: we pass block_costs by value instead of const&, since we'll sort it.
+  const size_t num_nodes = procs_per_node.size();
 
   // Reverse sort, with largest first:
   std::sort(block_costs.rbegin(), block_costs.rend());
@@ -72,8 +80,9 @@ compute_block_grid_mapping(const size_t &procs_per_node,
                     [](const size_t &cost, const Block_Cost &element) {
                       return cost + element.cost;
                     }));
-  const size_t num_procs(procs_per_node * num_nodes);
-  std::vector<size_t> available_procs(num_nodes, procs_per_node);
+  const size_t num_procs(std::accumulate(procs_per_node.begin(),
+                                         procs_per_node.end(), size_t(0)));
+  std::vector<size_t> available_procs(procs_per_node);
 
   std::vector<std::vector<Block_Map>> result(num_nodes);
 
@@ -179,5 +188,16 @@ compute_block_grid_mapping(const size_t &procs_per_node,
       {
         result[node].push_back(available);
       }
+  improve_block_grid_mapping(result, block_costs);
   return result;
 }
+
+// All nodes have the same number of procs
+inline std::vector<std::vector<Block_Map>>
+compute_block_grid_mapping(const size_t &procs_per_node,
+                           const size_t &num_nodes,
+                           const std::vector<Block_Cost> &block_costs)
+{
+  return compute_block_grid_mapping(
+    std::vector<size_t>(num_nodes, procs_per_node), block_costs);
+}
@@ -0,0 +1,306 @@
+// Iteratively improve the block mapping created by the worst-fit
+// algorithm in compute_block_grid_mapping(), minimizing the maximal
+// cost per process.
+//
+// At each step we take the block_map with the maximal cost per
+// process and try to unload it:
+//
+// 1) If the block_map has several blocks, move one of them to the
+// least loaded single-proc block_map (on any node), or swap it with a
+// cheaper block from another single-proc block_map.
+//
+// 2) If the block_map has a single block, give it one more proc from
+// the same node.  The proc is taken either from another multi-proc
+// block_map, or from a single-proc block_map whose blocks are moved
+// to other single-proc block_maps.  This way, large blocks forced
+// onto a node can share procs with the existing block_maps, and
+// left-over procs get some work.
+//
+// A step is accepted only if all modified block_maps end up strictly
+// cheaper than the current maximum, so the maximum never increases.
+// We stop when the most expensive block_map cannot be improved.
+//
+// All comparisons are done in integers to make sure that the results
+// are the same on different processes.
+
+#pragma once
+
+#include "Block_Cost.hxx"
+#include "Block_Map.hxx"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace Block_Grid_Mapping_Detail
+{
+  // Whether cost_a/procs_a < cost_b/procs_b
+  inline bool
+  less_per_proc(const size_t cost_a, const size_t procs_a,
+                const size_t cost_b, const size_t procs_b)
+  {
+    return cost_a * procs_b < cost_b * procs_a;
+  }
+
+  struct Map_Ref
+  {
+    size_t node;
+    size_t index;
+  };
+
+  // Move or swap blocks between max_map (with several blocks)
+  // and other single-proc block_maps.
+  inline bool
+  move_or_swap_block(std::vector<std::vector<Block_Map>> &mapping,
+                     const Map_Ref &max_ref,
+                     const std::vector<size_t> &cost_by_index)
+  {
+    auto &max_map = mapping.at(max_ref.node).at(max_ref.index);
+    const size_t max_cost = max_map.cost;
+
+    // Blocks of max_map, most expensive first
+    std::vector<size_t> blocks(max_map.block_indices);
+    std::stable_sort(blocks.begin(), blocks.end(),
+                     [&](const size_t a, const size_t b) {
+                       return cost_by_index.at(a) > cost_by_index.at(b);
+                     });
+
+    Block_Map *min_map = nullptr;
+    for(size_t node = 0; node < mapping.size(); ++node)
+      for(size_t index = 0; index < mapping[node].size(); ++index)
+        {
+          auto &block_map = mapping[node][index];
+          if(block_map.num_procs != 1 || &block_map == &max_map)
+            continue;
+          if(min_map == nullptr || block_map.cost < min_map->cost)
+            min_map = &block_map;
+        }
+    if(min_map == nullptr)
+      return false;
+
+    // Move the largest block that fits below the maximum
+    for(const auto block : blocks)
+      {
+        const auto cost = cost_by_index.at(block);
+        if(min_map->cost + cost < max_cost)
+          {
+            auto &indices = max_map.block_indices;
+            indices.erase(std::find(indices.begin(), indices.end(), block));
+            max_map.cost -= cost;
+            min_map->block_indices.push_back(block);
+            min_map->cost += cost;
+            return true;
+          }
+      }
+
+    // Swap two blocks, reducing max_map cost as much as possible
+    Block_Map *best_map = nullptr;
+    size_t best_from = 0, best_to = 0, best_delta = 0;
+    for(auto &node_mapping : mapping)
+      for(auto &block_map : node_mapping)
+        {
+          if(block_map.num_procs != 1 || &block_map == &max_map)
+            continue;
+          for(const auto from : blocks)
+            for(const auto to : block_map.block_indices)
+              {
+                const auto from_cost = cost_by_index.at(from);
+                const auto to_cost = cost_by_index.at(to);
+                if(to_cost >= from_cost)
+                  continue;
+                const auto delta = from_cost - to_cost;
+                if(delta > best_delta && block_map.cost + delta < max_cost)
+                  {
+                    best_map = &block_map;
+                    best_from = from;
+                    best_to = to;
+                    best_delta = delta;
+                  }
+              }
+        }
+    if(best_map == nullptr)
+      return false;
+
+    auto &from_indices = max_map.block_indices;
+    *std::find(from_indices.begin(), from_indices.end(), best_from) = best_to;
+    max_map.cost -= best_delta;
+    auto &to_indices = best_map->block_indices;
+    *std::find(to_indices.begin(), to_indices.end(), best_to) = best_from;
+    best_map->cost += best_delta;
+    return true;
+  }
+
+  // Give one more proc to max_map (with a single block)
+  // from the same node.
+  inline bool
+  add_proc(std::vector<std::vector<Block_Map>> &mapping,
+           const Map_Ref &max_ref, const std::vector<size_t> &cost_by_index)
+  {
+    auto &node_mapping = mapping.at(max_ref.node);
+    auto &max_map = node_mapping.at(max_ref.index);
+    const size_t max_cost = max_map.cost;
+    const size_t max_procs = max_map.num_procs;
+
+    // Take a proc from another multi-proc block_map
+    std::optional<size_t> best_donor;
+    for(size_t index = 0; index < node_mapping.size(); ++index)
+      {
+        const auto &donor = node_mapping[index];
+        if(index == max_ref.index || donor.num_procs < 2)
+          continue;
+        if(!less_per_proc(donor.cost, donor.num_procs - 1, max_cost,
+                          max_procs))
+          continue;
+        if(!best_donor.has_value()
+           || less_per_proc(donor.cost, donor.num_procs - 1,
+                            node_mapping[*best_donor].cost,
+                            node_mapping[*best_donor].num_procs - 1))
+          best_donor = index;
+      }
+    if(best_donor.has_value())
+      {
+        --node_mapping[*best_donor].num_procs;
+        ++max_map.num_procs;
+        return true;
+      }
+
+    // Free a single-proc block_map, cheapest first
+    std::vector<size_t> donors;
+    for(size_t index = 0; index < node_mapping.size(); ++index)
+      {
+        if(index != max_ref.index && node_mapping[index].num_procs == 1)
+          donors.push_back(index);
+      }
+    std::stable_sort(donors.begin(), donors.end(),
+                     [&](const size_t a, const size_t b) {
+                       return node_mapping[a].cost < node_mapping[b].cost;
+                     });
+
+    for(const auto donor_index : donors)
+      {
+        const auto &donor = node_mapping[donor_index];
+
+        // All other single-proc block_maps can receive blocks
+        std::vector<Block_Map *> targets;
+        for(auto &other_node_mapping : mapping)
+          for(auto &block_map : other_node_mapping)
+            {
+              if(block_map.num_procs == 1 && &block_map != &donor
+                 && &block_map != &max_map)
+                targets.push_back(&block_map);
+            }
+        if(targets.empty() && !donor.block_indices.empty())
+          continue;
+
+        // Greedily assign donor blocks, most expensive first,
+        // to the least loaded targets
+        std::vector<size_t> blocks(donor.block_indices);
+        std::stable_sort(blocks.begin(), blocks.end(),
+                         [&](const size_t a, const size_t b) {
+                           return cost_by_index.at(a) > cost_by_index.at(b);
+                         });
+        std::vector<size_t> target_costs;
+        for(const auto *target : targets)
+          target_costs.push_back(target->cost);
+        std::vector<size_t> assignment;
+        bool fits = true;
+        for(const auto block : blocks)
+          {
+            const auto min_target = std::distance(
+              target_costs.begin(),
+              std::min_element(target_costs.begin(), target_costs.end()));
+            target_costs.at(min_target) += cost_by_index.at(block);
+            if(!less_per_proc(target_costs.at(min_target), 1, max_cost,
+                              max_procs))
+              {
+                fits = false;
+                break;
+              }
+            assignment.push_back(min_target);
+          }
+        if(!fits)
+          continue;
+
+        for(size_t i = 0; i < blocks.size(); ++i)
+          {
+            auto &target = *targets.at(assignment.at(i));
+            target.block_indices.push_back(blocks.at(i));
+            target.cost += cost_by_index.at(blocks.at(i));
+          }
+        ++max_map.num_procs;
+        // NB: invalidates references to node_mapping elements
+        node_mapping.erase(node_mapping.begin() + donor_index);
+        return true;
+      }
+    return false;
+  }
+}
+
+inline void
+improve_block_grid_mapping(std::vector<std::vector<Block_Map>> &mapping,
+                           const std::vector<Block_Cost> &block_costs)
+{
+  using namespace Block_Grid_Mapping_Detail;
+
+  std::vector<size_t> cost_by_index;
+  for(const auto &block : block_costs)
+    {
+      if(block.index >= cost_by_index.size())
+        cost_by_index.resize(block.index + 1, 0);
+      cost_by_index.at(block.index) = block.cost;
+    }
+
+  // Each step either moves a block to a cheaper place
+  // or adds a proc to the most expensive block,
+  // so the number of steps is limited in practice.
+  // We set a hard limit just in case.
+  const size_t max_steps = 4 * (block_costs.size() + 1);
+  for(size_t step = 0; step < max_steps; ++step)
+    {
+      std::optional<Map_Ref> max_ref;
+      for(size_t node = 0; node < mapping.size(); ++node)
+        for(size_t index = 0; index < mapping[node].size(); ++index)
+          {
+            if(!max_ref.has_value()
+               || mapping[max_ref->node][max_ref->index]
+                    < mapping[node][index])
+              max_ref = Map_Ref{node, index};
+          }
+      if(!max_ref.has_value())
+        return;
+
+      const auto &max_map = mapping[max_ref->node][max_ref->index];
+      if(max_map.block_indices.size() > 1)
+        {
+          if(move_or_swap_block(mapping, max_ref.value(), cost_by_index))
+            continue;
+        }
+      else if(max_map.block_indices.size() == 1)
+        {
+          if(add_proc(mapping, max_ref.value(), cost_by_index))
+            continue;
+        }
+      return;
+    }
+}
+
+// Ratio of the maximal cost per proc to the average cost per proc.
+// For a perfectly balanced mapping, it is equal to 1.
+inline double
+block_grid_mapping_imbalance(const std::vector<std::vector<Block_Map>> &mapping)
+{
+  size_t total_cost = 0, total_procs = 0;
+  double max_cost_per_proc = 0;
+  for(const auto &node_mapping : mapping)
+    for(const auto &block_map : node_mapping)
+      {
+        total_cost += block_map.cost;
+        total_procs += block_map.num_procs;
+        max_cost_per_proc = std::max(
+          max_cost_per_proc,
+          block_map.cost / static_cast<double>(block_map.num_procs));
+      }
+  if(total_cost == 0)
+    return 1;
+  return max_cost_per_proc * total_procs / total_cost;
+}
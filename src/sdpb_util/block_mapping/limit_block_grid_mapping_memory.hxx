@@ -0,0 +1,163 @@
+// Adjust block mapping so that the estimated memory of blocks
+// assigned to each node does not exceed max_memory_per_node.
+//
+// compute_block_grid_mapping() balances only block costs (i.e. time),
+// so a node can get several blocks that are cheap in time but large in
+// memory, and fail with OOM while other nodes have some headroom.
+//
+// While some node exceeds the limit, we take the node with the largest
+// excess and move one of its blocks to a single-proc block_map on
+// another node, or swap it with a smaller block from another node.
+// Among all such moves that keep the target node within the limit,
+// we choose the one that gives the smallest cost of the two modified
+// block_maps, so that time balance is spoiled as little as possible.
+//
+// Blocks of multi-proc block_maps are never moved, since we cannot
+// move procs between nodes.  Single-proc block_maps never become empty.
+//
+// Returns false if the limit cannot be satisfied.  In that case,
+// mapping is left in some intermediate state.
+//
+// All computations are done in integers to make sure that the results
+// are the same on different processes.
+
+#pragma once
+
+#include "Block_Cost.hxx"
+#include "Block_Map.hxx"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+// Total memory of the blocks assigned to each node
+inline std::vector<size_t>
+block_grid_mapping_node_memory(const std::vector<std::vector<Block_Map>> &mapping,
+                               const std::vector<size_t> &block_memory)
+{
+  std::vector<size_t> result(mapping.size(), 0);
+  for(size_t node = 0; node < mapping.size(); ++node)
+    for(const auto &block_map : mapping[node])
+      for(const auto block_index : block_map.block_indices)
+        result[node] += block_memory.at(block_index);
+  return result;
+}
+
+inline bool
+limit_block_grid_mapping_memory(std::vector<std::vector<Block_Map>> &mapping,
+                                const std::vector<Block_Cost> &block_costs,
+                                const std::vector<size_t> &block_memory,
+                                const size_t max_memory_per_node)
+{
+  std::vector<size_t> cost_by_index;
+  for(const auto &block : block_costs)
+    {
+      if(block.index >= cost_by_index.size())
+        cost_by_index.resize(block.index + 1, 0);
+      cost_by_index.at(block.index) = block.cost;
+    }
+
+  auto node_memory = block_grid_mapping_node_memory(mapping, block_memory);
+
+  // Each step reduces the total excess, so the loop terminates anyway.
+  // We set a hard limit just in case.
+  const size_t max_steps = 4 * (block_costs.size() + 1) * mapping.size();
+  for(size_t step = 0; step < max_steps; ++step)
+    {
+      std::optional<size_t> over_node;
+      for(size_t node = 0; node < mapping.size(); ++node)
+        {
+          if(node_memory[node] > max_memory_per_node
+             && (!over_node.has_value()
+                 || node_memory[node] > node_memory[*over_node]))
+            over_node = node;
+        }
+      if(!over_node.has_value())
+        return true;
+
+      // Best move found so far.
+      // If to_block is not set, from_block is moved without swapping.
+      Block_Map *from_map = nullptr, *to_map = nullptr;
+      size_t from_block = 0, to_node = 0;
+      std::optional<size_t> to_block;
+      size_t best_cost = 0;
+
+      auto try_candidate
+        = [&](Block_Map &from, const size_t from_index, const size_t node,
+              Block_Map &to, const std::optional<size_t> &to_index) {
+            const size_t from_memory = block_memory.at(from_index);
+            const size_t to_memory
+              = to_index.has_value() ? block_memory.at(*to_index) : 0;
+            if(to_memory >= from_memory
+               || node_memory[node] - to_memory + from_memory
+                    > max_memory_per_node)
+              return;
+            const size_t from_cost = cost_by_index.at(from_index);
+            const size_t to_cost
+              = to_index.has_value() ? cost_by_index.at(*to_index) : 0;
+            const size_t cost = std::max(from.cost - from_cost + to_cost,
+                                         to.cost - to_cost + from_cost);
+            if(from_map == nullptr || cost < best_cost)
+              {
+                from_map = &from;
+                from_block = from_index;
+                to_map = &to;
+                to_node = node;
+                to_block = to_index;
+                best_cost = cost;
+              }
+          };
+
+      for(auto &from : mapping[*over_node])
+        {
+          if(from.num_procs != 1)
+            continue;
+          for(const auto from_index : from.block_indices)
+            for(size_t node = 0; node < mapping.size(); ++node)
+              {
+                if(node == *over_node)
+                  continue;
+                for(auto &to : mapping[node])
+                  {
+                    if(to.num_procs != 1)
+                      continue;
+                    if(from.block_indices.size() > 1)
+                      try_candidate(from, from_index, node, to, std::nullopt);
+                    for(const auto to_index : to.block_indices)
+                      try_candidate(from, from_index, node, to, to_index);
+                  }
+              }
+        }
+      if(from_map == nullptr)
+        return false;
+
+      const size_t from_memory = block_memory.at(from_block);
+      const size_t from_cost = cost_by_index.at(from_block);
+      auto &from_indices = from_map->block_indices;
+      auto &to_indices = to_map->block_indices;
+      if(to_block.has_value())
+        {
+          const size_t to_memory = block_memory.at(*to_block);
+          const size_t to_cost = cost_by_index.at(*to_block);
+          *std::find(from_indices.begin(), from_indices.end(), from_block)
+            = *to_block;
+          *std::find(to_indices.begin(), to_indices.end(), *to_block)
+            = from_block;
+          from_map->cost = from_map->cost - from_cost + to_cost;
+          to_map->cost = to_map->cost - to_cost + from_cost;
+          node_memory[*over_node] -= from_memory - to_memory;
+          node_memory[to_node] += from_memory - to_memory;
+        }
+      else
+        {
+          from_indices.erase(
+            std::find(from_indices.begin(), from_indices.end(), from_block));
+          to_indices.push_back(from_block);
+          from_map->cost -= from_cost;
+          to_map->cost += from_cost;
+          node_memory[*over_node] -= from_memory;
+          node_memory[to_node] += from_memory;
+        }
+    }
+  return false;
+}
@@ -0,0 +1,82 @@
+#include "huge_pages.hxx"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <sys/mman.h>
+
+namespace
+{
+  constexpr uintptr_t huge_page_size = 2 * 1024 * 1024;
+}
+
+bool advise_huge_pages(void *data, const size_t bytes) noexcept
+{
+#ifdef MADV_HUGEPAGE
+  const auto begin = reinterpret_cast<uintptr_t>(data);
+  const auto end = begin + bytes;
+  const auto aligned_begin
+    = (begin + huge_page_size - 1) / huge_page_size * huge_page_size;
+  const auto aligned_end = end / huge_page_size * huge_page_size;
+  if(aligned_end <= aligned_begin)
+    return false;
+  return madvise(reinterpret_cast<void *>(aligned_begin),
+                 aligned_end - aligned_begin, MADV_HUGEPAGE)
+         == 0;
+#else
+  return false;
+#endif
+}
+
+size_t mapped_huge_page_bytes(const void *data, const size_t bytes) noexcept
+{
+  try
+    {
+      const auto begin = reinterpret_cast<uintptr_t>(data);
+      const auto end = begin + bytes;
+      std::ifstream smaps("/proc/self/smaps");
+      if(!smaps.good())
+        return 0;
+
+      // smaps consists of mapping headers, e.g.
+      // 7f1c2a000000-7f1c6a000000 rw-s 00000000 00:19 123 /dev/shm/...
+      // followed by fields, e.g.
+      // ShmemPmdMapped:  1048576 kB
+      size_t result_kb = 0;
+      bool is_overlapping = false;
+      std::string line;
+      while(std::getline(smaps, line))
+        {
+          std::istringstream iss(line);
+          std::string name;
+          if(!(iss >> name))
+            continue;
+          const auto dash = name.find('-');
+          if(name.back() != ':' && dash != std::string::npos)
+            {
+              const auto vma_begin
+                = std::stoull(name.substr(0, dash), nullptr, 16);
+              const auto vma_end
+                = std::stoull(name.substr(dash + 1), nullptr, 16);
+              is_overlapping = vma_begin < end && begin < vma_end;
+              continue;
+            }
+          if(!is_overlapping)
+            continue;
+          if(name == "AnonHugePages:" || name == "ShmemPmdMapped:"
+             || name == "FilePmdMapped:")
+            {
+              size_t value_kb;
+              if(iss >> value_kb)
+                result_kb += value_kb;
+            }
+        }
+      return result_kb * 1024;
+    }
+  catch(...)
+    {
+      return 0;
+    }
+}
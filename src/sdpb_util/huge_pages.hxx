@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+// Transparent huge pages (THP) for large shared memory windows.
+//
+// Large BLAS sweeps over residue windows touch many 4KB pages,
+// and each page needs a TLB entry. Backing the memory by 2MB pages
+// reduces the number of TLB misses.
+
+// Ask the kernel to back [data, data + bytes) by huge pages
+// via madvise(MADV_HUGEPAGE), for the 2MB-aligned part of the range.
+// Should be called before the memory is touched.
+// Returns false if the call fails, e.g. if the kernel has no THP support.
+// NB: the call can succeed even if huge pages are not used in the end,
+// e.g. if /sys/kernel/mm/transparent_hugepage/shmem_enabled is "never".
+// Check mapped_huge_page_bytes() after touching the memory.
+// NB: madvise() affects only the mapping in the calling process.
+bool advise_huge_pages(void *data, size_t bytes) noexcept;
+
+// Number of bytes in [data, data + bytes) mapped by huge pages
+// in the calling process, according to /proc/self/smaps.
+// Returns 0 if smaps cannot be read.
+[[nodiscard]] size_t
+mapped_huge_page_bytes(const void *data, size_t bytes) noexcept;
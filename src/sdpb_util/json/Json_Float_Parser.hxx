@@ -2,6 +2,7 @@
 
 #include "Abstract_Element_Parser.hxx"
 #include "Json_Vector_Parser.hxx"
+#include "sdpb_util/parse_BigFloat.hxx"
 
 #include <El.hpp>
 
@@ -9,6 +10,7 @@
 #include <rapidjson/encodings.h>
 
 #include <functional>
+#include <string_view>
 
 // TODO merge with NumberState
 template <class TFloat>
@@ -33,16 +35,19 @@ public:
   {
     if(!this->skip)
       {
-        std::string string_value(str, length);
+        const std::string_view string_value(str, length);
         try
           {
             // GMP does not have inf or nan, so we approximate inf
             // with max double.
             // TODO throw an error insted?
-            using namespace std::string_literals;
-            this->result = string_value == "inf"s
-                             ? TFloat(std::numeric_limits<double>::max())
-                             : TFloat(string_value);
+            using namespace std::string_view_literals;
+            if(string_value == "inf"sv)
+              this->result = TFloat(std::numeric_limits<double>::max());
+            else if constexpr(std::is_same_v<TFloat, El::BigFloat>)
+              parse_BigFloat(str, str + length, this->result);
+            else
+              this->result = TFloat(std::string(string_value));
           }
         catch(std::exception &e)
           {
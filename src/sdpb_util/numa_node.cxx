@@ -0,0 +1,31 @@
+#include "numa_node.hxx"
+
+#include <filesystem>
+#include <string>
+
+#include <sched.h>
+
+namespace fs = std::filesystem;
+
+int current_numa_node() noexcept
+{
+  try
+    {
+      const int cpu = sched_getcpu();
+      if(cpu < 0)
+        return 0;
+      const fs::path cpu_dir
+        = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+      std::error_code ec;
+      for(const auto &entry : fs::directory_iterator(cpu_dir, ec))
+        {
+          const auto name = entry.path().filename().string();
+          if(name.size() > 4 && name.compare(0, 4, "node") == 0
+             && name.find_first_not_of("0123456789", 4) == std::string::npos)
+            return std::stoi(name.substr(4));
+        }
+    }
+  catch(...)
+    {}
+  return 0;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// NUMA node (memory domain, usually a CPU socket) of the CPU
+// on which the calling process is currently running.
+// Determined from /sys/devices/system/cpu/cpuN/nodeM on Linux.
+// Returns 0 if NUMA information is not available.
+//
+// NB: the result is meaningful only if the process is bound to a core
+// or a socket, which is the default for most MPI launchers.
+[[nodiscard]] int current_numa_node() noexcept;
@@ -0,0 +1,208 @@
+#include "parse_BigFloat.hxx"
+
+#include "assert.hxx"
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <map>
+
+// Algorithm:
+// 1. Collect decimal digits of the mantissa (without leading and trailing
+//    zeros) and convert them to an integer M via mpn_set_str().
+// 2. Compute decimal exponent e, so that the value is M * 10^e.
+// 3. For e >= 0, multiply M by exact integer 10^e.
+//    For e < 0, multiply M by 10^e, precomputed with 64 guard bits.
+// 4. If |e| is far beyond the working precision (e.g. 1e100000000),
+//    exact 10^|e| would take too much memory.
+//    In that case we fall back to mpf_set_str(), which computes
+//    powers of ten only up to the working precision.
+//    Exponents that do not fit into int32 are rejected.
+//
+// All temporaries are thread_local, so that we don't allocate memory
+// for each number.
+
+namespace
+{
+  // Extra precision for intermediate calculations
+  constexpr mp_bitcnt_t guard_bits = 64;
+  // Don't cache too large powers of ten
+  constexpr size_t max_cached_power = 4096;
+  // Use exact powers of ten only for
+  // |exponent| <= precision * log10(2) + exponent_margin
+  constexpr int64_t exponent_margin = 1024;
+  constexpr int64_t max_abs_exponent = std::numeric_limits<int32_t>::max();
+
+  const mpz_class &pow10_z(const size_t exponent)
+  {
+    thread_local std::map<size_t, mpz_class> cache;
+    thread_local mpz_class uncached;
+    if(exponent > max_cached_power)
+      {
+        mpz_ui_pow_ui(uncached.get_mpz_t(), 10, exponent);
+        return uncached;
+      }
+    auto [it, inserted] = cache.try_emplace(exponent);
+    if(inserted)
+      mpz_ui_pow_ui(it->second.get_mpz_t(), 10, exponent);
+    return it->second;
+  }
+
+  // 10^(-exponent), computed with given precision
+  const mpf_class &
+  inverse_pow10(const size_t exponent, const mp_bitcnt_t precision)
+  {
+    thread_local std::map<std::pair<mp_bitcnt_t, size_t>, mpf_class> cache;
+    thread_local mpf_class uncached;
+    auto compute = [exponent](mpf_class &result) {
+      mpf_set_z(result.get_mpf_t(), pow10_z(exponent).get_mpz_t());
+      mpf_ui_div(result.get_mpf_t(), 1, result.get_mpf_t());
+    };
+    if(exponent > max_cached_power)
+      {
+        uncached.set_prec(precision);
+        compute(uncached);
+        return uncached;
+      }
+    auto [it, inserted]
+      = cache.try_emplace({precision, exponent}, 0, precision);
+    if(inserted)
+      compute(it->second);
+    return it->second;
+  }
+
+  [[noreturn]] void
+  throw_invalid(const char *begin, const char *end, const std::string &reason)
+  {
+    RUNTIME_ERROR("Failed to parse number '", std::string(begin, end),
+                  "': ", reason);
+  }
+}
+
+void parse_BigFloat(const char *begin, const char *end, El::BigFloat &result)
+{
+  // Decimal digits as values 0..9, as required by mpn_set_str()
+  thread_local std::vector<unsigned char> digits;
+  thread_local mpz_class mantissa;
+  thread_local mpf_class scaled;
+
+  digits.clear();
+
+  // Skip leading whitespace, as mpf_set_str() does
+  auto start = begin;
+  while(start != end && std::isspace(static_cast<unsigned char>(*start)))
+    ++start;
+
+  auto c = start;
+  bool negative = false;
+  if(c != end && (*c == '-' || *c == '+'))
+    {
+      negative = (*c == '-');
+      ++c;
+    }
+
+  // Exponent correction due to fractional digits and stripped trailing zeros
+  int64_t exponent = 0;
+  size_t num_digit_chars = 0;
+  size_t num_trailing_zeros = 0;
+  bool has_point = false;
+  for(; c != end; ++c)
+    {
+      if(*c >= '0' && *c <= '9')
+        {
+          ++num_digit_chars;
+          if(has_point)
+            --exponent;
+          if(*c == '0')
+            {
+              // Skip leading zeros, postpone trailing zeros
+              if(!digits.empty())
+                ++num_trailing_zeros;
+              continue;
+            }
+          digits.insert(digits.end(), num_trailing_zeros, 0);
+          num_trailing_zeros = 0;
+          digits.push_back(*c - '0');
+        }
+      else if(*c == '.' && !has_point)
+        {
+          has_point = true;
+        }
+      else
+        {
+          break;
+        }
+    }
+  if(num_digit_chars == 0)
+    throw_invalid(begin, end, "no digits found");
+  exponent += num_trailing_zeros;
+
+  if(c != end)
+    {
+      if(*c != 'e' && *c != 'E')
+        throw_invalid(begin, end, "unexpected character");
+      ++c;
+      // std::from_chars() does not accept leading '+'
+      if(c != end && *c == '+' && std::next(c) != end && *std::next(c) != '-')
+        ++c;
+      int64_t exp10 = 0;
+      const auto [ptr, ec] = std::from_chars(c, end, exp10);
+      if(ec == std::errc::result_out_of_range)
+        throw_invalid(begin, end, "exponent out of range");
+      if(ec != std::errc() || ptr != end)
+        throw_invalid(begin, end, "invalid exponent");
+      // Check before adding, to prevent int64 overflow
+      if(exp10 > max_abs_exponent || exp10 < -max_abs_exponent)
+        throw_invalid(begin, end, "exponent out of range");
+      exponent += exp10;
+    }
+  if(exponent > max_abs_exponent || exponent < -max_abs_exponent)
+    throw_invalid(begin, end, "exponent out of range");
+
+  mpf_ptr output = result.gmp_float.get_mpf_t();
+  if(digits.empty())
+    {
+      mpf_set_ui(output, 0);
+      return;
+    }
+
+  const auto max_exact_exponent
+    = static_cast<int64_t>(mpf_get_prec(output) * std::log10(2.0))
+      + exponent_margin;
+  if(std::abs(exponent) > max_exact_exponent)
+    {
+      // GMP does not accept leading '+'
+      const char *str_begin = (*start == '+') ? std::next(start) : start;
+      const std::string str(str_begin, end);
+      if(mpf_set_str(output, str.c_str(), 10) != 0)
+        throw_invalid(begin, end, "mpf_set_str() failed");
+      return;
+    }
+
+  // Convert digits to limbs.
+  // log2(10) < 3.33, so we need at most 10/3 bits per digit.
+  mpz_ptr z = mantissa.get_mpz_t();
+  const mp_size_t max_limbs = (digits.size() * 10 / 3) / GMP_NUMB_BITS + 2;
+  mp_ptr limbs = mpz_limbs_write(z, max_limbs);
+  const mp_size_t num_limbs
+    = mpn_set_str(limbs, digits.data(), digits.size(), 10);
+  mpz_limbs_finish(z, num_limbs);
+
+  if(exponent >= 0)
+    {
+      if(exponent > 0)
+        mpz_mul(z, z, pow10_z(exponent).get_mpz_t());
+      mpf_set_z(output, z);
+    }
+  else
+    {
+      const mp_bitcnt_t precision = mpf_get_prec(output) + guard_bits;
+      scaled.set_prec(precision);
+      mpf_set_z(scaled.get_mpf_t(), z);
+      mpf_mul(output, scaled.get_mpf_t(),
+              inverse_pow10(-exponent, precision).get_mpf_t());
+    }
+  if(negative)
+    mpf_neg(output, output);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <El.hpp>
+
+// Convert decimal number in [begin, end) to El::BigFloat,
+// e.g. "-1.25e-3", "42", ".5E+10".
+// Format: [+-]digits[.digits][(e|E)[+-]digits]
+// Leading whitespace is skipped, as in mpf_set_str().
+//
+// This is a faster replacement for El::BigFloat(std::string):
+// it does not copy input to a null-terminated string,
+// reuses GMP temporaries and caches powers of ten.
+// Result has the precision of the result argument.
+void parse_BigFloat(const char *begin, const char *end, El::BigFloat &result);
+
+inline El::BigFloat parse_BigFloat(const char *begin, const char *end)
+{
+  El::BigFloat result;
+  parse_BigFloat(begin, end, result);
+  return result;
+}
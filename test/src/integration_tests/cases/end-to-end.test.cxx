@@ -16,12 +16,21 @@ namespace fs = std::filesystem;
 
 namespace
 {
+  // Additional checks after SDPB run,
+  // e.g. check_sdpb(output_dir, sdpb_runner)
+  using Check_Sdpb_Func = std::function<void(
+    const fs::path &output_dir, const Test_Case_Runner &sdpb_runner)>;
+
+  // runner_name_suffix distinguishes runs of the same input
+  // with different default_sdpb_args
   void end_to_end_test(const std::string &name, int num_procs, int precision,
                        const std::string &default_sdpb_args = "",
                        const Named_Args_Map &pmp2sdp_args = {},
                        const std::vector<std::string> &out_txt_keys = {},
                        bool check_sdp_normalization = true,
-                       bool run_sdpb_twice = false)
+                       bool run_sdpb_twice = false,
+                       const std::string &runner_name_suffix = "",
+                       const Check_Sdpb_Func &check_sdpb = {})
   {
     int diff_precision = precision / 2;
 
@@ -67,6 +76,10 @@ namespace
           = "end-to-end_tests/" + name + "/" + pmp_path.filename().string();
         if(!sdp_format.empty())
           runner_name += "/format=" + sdp_format;
+        if(pmp2sdp_args.find("--zipShards") != pmp2sdp_args.end())
+          runner_name += "/zipShards=" + pmp2sdp_args.at("--zipShards");
+        if(!runner_name_suffix.empty())
+          runner_name += "/" + runner_name_suffix;
         Test_Case_Runner runner(runner_name);
         const auto &output_dir = runner.output_dir;
 
@@ -99,19 +112,39 @@ namespace
             {"--sdpDir", sdp_path},
             {"--outDir", (output_dir / "out").string()},
             {"--checkpointDir", (output_dir / "ck").string()}};
-          runner.create_nested("sdpb").mpi_run(
-            {"build/sdpb", default_sdpb_args}, args, num_procs);
+          const auto sdpb_runner = runner.create_nested("sdpb");
+          sdpb_runner.mpi_run({"build/sdpb", default_sdpb_args}, args,
+                              num_procs);
           if(run_sdpb_twice)
             {
               runner.create_nested("sdpb-2").mpi_run(
                 {"build/sdpb", default_sdpb_args}, args, num_procs);
             }
+          if(check_sdpb)
+            check_sdpb(output_dir, sdpb_runner);
+
+          // iterations.0.json is written by the timing run.
+          // If SDPB skips it (e.g. with --rebalanceThreshold),
+          // we compare other files only.
+          std::vector<std::string> out_filenames;
+          if(exists(data_output_dir / "out" / "iterations.0.json")
+             && !exists(output_dir / "out" / "iterations.0.json"))
+            {
+              for(const auto &it :
+                  fs::directory_iterator(data_output_dir / "out"))
+                {
+                  const auto filename = it.path().filename().string();
+                  if(filename != "iterations.0.json")
+                    out_filenames.push_back(filename);
+                }
+            }
 
           // SDPB runs with --precision=<precision>
           // We check test output up to lower precision=<sdpb_output_diff_precision>
           // in order to neglect unimportant rounding errors
           diff_sdpb_output_dir(output_dir / "out", data_output_dir / "out",
-                               precision, diff_precision, {}, out_txt_keys);
+                               precision, diff_precision, out_filenames,
+                               out_txt_keys);
         }
 
         if(exists(data_output_dir / "spectrum.json"))
@@ -203,7 +236,7 @@ TEST_CASE("end-to-end_tests")
         "--feasibleCenteringParameter=0.1 --infeasibleCenteringParameter=0.3 "
         "--stepLengthReduction=0.7 "
         "--maxSharedMemory=100K"; // forces split_factor=3 for Q window
-    for(std::string sdp_format : {"", "bin", "json"})
+    for(std::string sdp_format : {"", "bin", "json", "mmap"})
       {
         DYNAMIC_SECTION(
           "format=" << (sdp_format.empty() ? "default(bin)" : sdp_format))
@@ -215,6 +248,64 @@ TEST_CASE("end-to-end_tests")
                           build_pmp2sdp_args(sdp_format, zip));
         }
       }
+    SECTION("zipShards")
+    {
+      INFO("Write block_data files to several sdp.shard_K.zip archives. "
+           "Each group of SDPB processes reads only its own shards.");
+      bool zip = true;
+      auto pmp2sdp_args = build_pmp2sdp_args("", zip);
+      pmp2sdp_args["--zipShards"] = "4";
+      end_to_end_test("dfibo-0-0-j=3-c=3.0000-d=3-s=6", num_procs, precision,
+                      default_sdpb_args, pmp2sdp_args);
+    }
+    // Check that SDPB has redistributed blocks during the run
+    const auto check_rebalance = [](const fs::path &output_dir,
+                                    const Test_Case_Runner &sdpb_runner) {
+      std::ifstream is(sdpb_runner.stdout_path);
+      std::stringstream ss;
+      ss << is.rdbuf();
+      const auto stdout_string = ss.str();
+      CAPTURE(sdpb_runner.stdout_path);
+      REQUIRE(stdout_string.find("redistributing blocks")
+              != std::string::npos);
+      // New block mapping is saved to checkpoint
+      REQUIRE(exists(output_dir / "ck" / "block_timings"));
+    };
+    SECTION("rebalanceThreshold")
+    {
+      INFO("Redistribute blocks during the run. "
+           "Solution and iterations should not change.");
+      INFO("Nonzero --minPrimalStep and --minDualStep check that step "
+           "lengths are kept after redistribution.");
+      bool zip = true;
+      end_to_end_test("dfibo-0-0-j=3-c=3.0000-d=3-s=6", num_procs, precision,
+                      default_sdpb_args
+                        + " --rebalanceThreshold=1.001"
+                          " --minPrimalStep=1e-30 --minDualStep=1e-30",
+                      build_pmp2sdp_args("", zip), {}, true, false,
+                      "rebalanceThreshold=1.001", check_rebalance);
+    }
+    SECTION("numThreads")
+    {
+      INFO("Blocks owned by a single rank are processed by several threads.");
+      INFO("With 2 ranks for 98 blocks, each block group has one rank.");
+      bool zip = true;
+      end_to_end_test("dfibo-0-0-j=3-c=3.0000-d=3-s=6", 2, precision,
+                      default_sdpb_args + " --numThreads=2",
+                      build_pmp2sdp_args("", zip), {}, true, false,
+                      "numThreads=2");
+    }
+    SECTION("memoryAwareMapping")
+    {
+      INFO("Block mapping with memory limit per node, "
+           "both for the initial mapping and for rebalancing.");
+      bool zip = true;
+      end_to_end_test("dfibo-0-0-j=3-c=3.0000-d=3-s=6", num_procs, precision,
+                      default_sdpb_args
+                        + " --memoryAwareMapping --rebalanceThreshold=1.001",
+                      build_pmp2sdp_args("", zip), {}, true, false,
+                      "memoryAwareMapping", check_rebalance);
+    }
   }
 
   SECTION("SingletScalar_cT_test_nmax6/primal_dual_optimal")
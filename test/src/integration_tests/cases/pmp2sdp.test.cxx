@@ -1,6 +1,7 @@
 #include "integration_tests/common.hxx"
 
 #include <filesystem>
+#include <map>
 
 namespace fs = std::filesystem;
 using namespace std::string_literals;
@@ -16,7 +17,7 @@ TEST_CASE("pmp2sdp")
 
   SECTION("run")
   {
-    std::string input_format = GENERATE("json", "m");
+    std::string input_format = GENERATE("json", "m", "xml");
     DYNAMIC_SECTION(input_format)
     {
       auto data_dir = Test_Config::test_data_dir / "pmp2sdp" / input_format;
@@ -45,12 +46,59 @@ TEST_CASE("pmp2sdp")
     }
   }
 
+  SECTION("numThreads")
+  {
+    INFO("Compute bilinear bases and sample scalings in several threads");
+    auto data_dir = Test_Config::test_data_dir / "pmp2sdp" / "json";
+    auto sdp_orig = data_dir / "sdp_orig";
+
+    Test_Util::Test_Case_Runner runner("pmp2sdp/numThreads");
+    Test_Util::Test_Case_Runner::Named_Args_Map args(default_args);
+    args["--input"] = (data_dir / "file_list.nsv").string();
+    auto sdp_path = (runner.output_dir / "sdp").string();
+    args["--output"] = sdp_path;
+    args["--numThreads"] = "2";
+    runner.create_nested("run").mpi_run({"build/pmp2sdp"}, args);
+
+    Test_Util::REQUIRE_Equal::diff_sdp(sdp_path, sdp_orig, precision,
+                                       diff_precision,
+                                       runner.create_nested("diff"));
+  }
+
+  SECTION("pmp2binary")
+  {
+    INFO("Convert PMP to .pmpb with pmp2binary, "
+         "then run pmp2sdp on the .pmpb file");
+    auto data_dir = Test_Config::test_data_dir / "pmp2sdp" / "json";
+    auto sdp_orig = data_dir / "sdp_orig";
+
+    Test_Util::Test_Case_Runner runner("pmp2sdp/pmp2binary");
+    auto pmpb_path = (runner.output_dir / "pmp.pmpb").string();
+    {
+      Test_Util::Test_Case_Runner::Named_Args_Map args(default_args);
+      args["--input"] = (data_dir / "file_list.nsv").string();
+      args["--output"] = pmpb_path;
+      runner.create_nested("pmp2binary").mpi_run({"build/pmp2binary"}, args);
+    }
+    REQUIRE(fs::file_size(pmpb_path) > 0);
+
+    Test_Util::Test_Case_Runner::Named_Args_Map args(default_args);
+    args["--input"] = pmpb_path;
+    auto sdp_path = (runner.output_dir / "sdp").string();
+    args["--output"] = sdp_path;
+    runner.create_nested("run").mpi_run({"build/pmp2sdp"}, args);
+
+    Test_Util::REQUIRE_Equal::diff_sdp(sdp_path, sdp_orig, precision,
+                                       diff_precision,
+                                       runner.create_nested("diff"));
+  }
+
   SECTION("outputFormat")
   {
     INFO("Check different --outputFormat options");
     auto data_dir = Test_Config::test_data_dir / "end-to-end_tests" / "1d";
 
-    for(std::string output_format : {"", "bin", "json"})
+    for(std::string output_format : {"", "bin", "json", "mmap"})
       {
         auto format_description
           = output_format.empty() ? "default(bin)" : output_format;
@@ -89,6 +137,67 @@ TEST_CASE("pmp2sdp")
       }
   }
 
+  SECTION("incremental")
+  {
+    INFO("Run pmp2sdp --incremental twice. "
+         "The second run should reuse all blocks from sdp.block_cache");
+    auto data_dir = Test_Config::test_data_dir / "pmp2sdp" / "json";
+    auto sdp_orig = data_dir / "sdp_orig";
+
+    for(const bool zip : {false, true})
+      DYNAMIC_SECTION((zip ? "zip" : "dir"))
+      {
+        Test_Util::Test_Case_Runner runner("pmp2sdp/incremental/"s
+                                           + (zip ? "zip" : "dir"));
+        Test_Util::Test_Case_Runner::Named_Args_Map args(default_args);
+        args["--input"] = (data_dir / "file_list.nsv").string();
+        auto sdp_path = runner.output_dir / (zip ? "sdp.zip" : "sdp");
+        args["--output"] = sdp_path.string();
+        args["--incremental"] = "";
+        if(zip)
+          args["--zip"] = "";
+        auto block_cache_dir = sdp_path;
+        block_cache_dir += ".block_cache";
+
+        auto get_cache_write_times = [&block_cache_dir] {
+          std::map<fs::path, fs::file_time_type> result;
+          for(const auto &entry : fs::directory_iterator(block_cache_dir))
+            result.emplace(entry.path(), entry.last_write_time());
+          return result;
+        };
+
+        runner.create_nested("run-1").mpi_run({"build/pmp2sdp"}, args);
+        Test_Util::REQUIRE_Equal::diff_sdp(sdp_path, sdp_orig, precision,
+                                           diff_precision,
+                                           runner.create_nested("diff-1"));
+        const auto write_times = get_cache_write_times();
+        // block_info and block_data for each block
+        REQUIRE(!write_times.empty());
+        REQUIRE(write_times.size() % 2 == 0);
+
+        runner.create_nested("run-2").mpi_run({"build/pmp2sdp"}, args);
+        Test_Util::REQUIRE_Equal::diff_sdp(sdp_path, sdp_orig, precision,
+                                           diff_precision,
+                                           runner.create_nested("diff-2"));
+        // All cached files are reused, none is rewritten
+        REQUIRE(get_cache_write_times() == write_times);
+
+        INFO("Changing output format invalidates the cache");
+        args["--outputFormat"] = "json";
+        runner.create_nested("run-json").mpi_run({"build/pmp2sdp"}, args);
+        Test_Util::REQUIRE_Equal::diff_sdp(sdp_path, sdp_orig, precision,
+                                           diff_precision,
+                                           runner.create_nested("diff-json"));
+        const auto json_write_times = get_cache_write_times();
+        REQUIRE(json_write_times.size() == write_times.size());
+        for(const auto &[path, time] : json_write_times)
+          {
+            CAPTURE(path);
+            REQUIRE(write_times.count(path) == 0);
+          }
+      }
+  }
+
   SECTION("filesystem errors")
   {
     INFO("pmp2sdp should fail due to invalid input/output arguments");
@@ -169,4 +169,31 @@ TEST_CASE("sdpb")
                              "Corrupted data in file");
     }
   }
+
+  SECTION("costModel")
+  {
+    INFO("With --costModel, SDPB estimates block costs "
+         "instead of running the timing run.");
+    Test_Util::Test_Case_Runner runner("sdpb/costModel");
+    const auto cost_model_path = runner.output_dir / "cost_model.json";
+    auto args = default_args;
+    args["--maxIterations"] = "3";
+    args["--costModel"] = cost_model_path.string();
+
+    for(const std::string &name : {"calibrate", "read"})
+      {
+        INFO(name);
+        const auto nested = runner.create_nested(name);
+        args["--checkpointDir"] = (nested.output_dir / "ck").string();
+        args["--outDir"] = (nested.output_dir / "out").string();
+        nested.mpi_run({"build/sdpb"}, args, num_procs);
+
+        REQUIRE(fs::file_size(cost_model_path) > 0);
+        INFO("No timing run: block_timings and iterations.0.json "
+             "are not written");
+        REQUIRE(!exists(nested.output_dir / "ck" / "block_timings"));
+        REQUIRE(exists(nested.output_dir / "out" / "iterations.json"));
+        REQUIRE(!exists(nested.output_dir / "out" / "iterations.0.json"));
+      }
+  }
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "Test_Config.hxx"
 #include "sdpb_util/assert.hxx"
 
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+
 #include <fstream>
 
 namespace fs = std::filesystem;
@@ -195,6 +198,24 @@ namespace Test_Util
     auto unzip_command
       = build_command_line("unzip -o", zip_path, "-d", output_path);
     run(unzip_command);
+
+    // If sdp.zip is sharded (pmp2sdp --zipShards),
+    // unzip also block_data files from sdp.shard_K.zip to the same directory
+    const auto shards_json = output_path / "shards.json";
+    if(exists(shards_json))
+      {
+        std::ifstream is(shards_json);
+        rapidjson::IStreamWrapper wrapper(is);
+        rapidjson::Document document;
+        document.ParseStream(wrapper);
+        for(const auto &shard : document["shards"].GetArray())
+          {
+            const auto shard_path
+              = zip_path.parent_path() / shard["path"].GetString();
+            run(build_command_line("unzip -o", shard_path, "-d",
+                                   output_path));
+          }
+      }
     return output_path;
   }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Float.hxx"
 #include "json.hxx"
+#include "pmp2sdp/Mmap_Block_Format.hxx"
 #include "sdpb_util/boost_serialization.hxx"
 
 #include <catch2/catch_amalgamated.hpp>
@@ -104,6 +105,12 @@ namespace
       if(exists(block_path))
         {
           parse_bin(block_path);
+          return;
+        }
+      block_path.replace_extension(".mmap");
+      if(exists(block_path))
+        {
+          parse_mmap(block_path);
         }
       else
         {
@@ -141,6 +148,22 @@ namespace
       ar >> bilinear_bases_even;
       ar >> bilinear_bases_odd;
     }
+    void parse_mmap(const fs::path &block_path)
+    {
+      namespace Format = Mmap_Block_Format;
+      CAPTURE(block_path);
+      std::ifstream is(block_path, std::ios::binary);
+      const std::vector<char> data((std::istreambuf_iterator<char>(is)),
+                                   std::istreambuf_iterator<char>());
+      const Format::View view(data.data(), data.size());
+      constraint_matrix = view.read_matrix(Format::B);
+      const auto c = view.read_matrix(Format::c);
+      REQUIRE(c.Width() == 1);
+      constraint_constants.assign(c.LockedBuffer(),
+                                  c.LockedBuffer() + c.Height());
+      bilinear_bases_even = view.read_matrix(Format::bilinear_bases_even);
+      bilinear_bases_odd = view.read_matrix(Format::bilinear_bases_odd);
+    }
   };
 }
 
@@ -0,0 +1,110 @@
+#include <catch2/catch_amalgamated.hpp>
+#include <El.hpp>
+
+#include "sdp_solve/Block_Cost_Model.hxx"
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+TEST_CASE("Block_Cost_Model")
+{
+  SECTION("block_time_ms")
+  {
+    INFO("Block time should grow with block size, N and number of primes");
+    Block_Cost_Model model;
+    model.precision = El::gmp::Precision();
+    model.bigfloat_fma_ns = 10;
+    model.residue_ns = 1;
+    model.blas_fma_ns = 0.1;
+
+    const size_t num_points = 10;
+    const size_t dim = 2;
+    const size_t N = 20;
+    const size_t num_primes = 50;
+    const double time = model.block_time_ms(num_points, dim, N, num_primes);
+    REQUIRE(time > 0);
+    CHECK(model.block_time_ms(num_points + 1, dim, N, num_primes) > time);
+    CHECK(model.block_time_ms(num_points, dim + 1, N, num_primes) > time);
+    CHECK(model.block_time_ms(num_points, dim, N + 1, num_primes) > time);
+    CHECK(model.block_time_ms(num_points, dim, N, num_primes + 1) > time);
+
+    INFO("Time is linear in unit timings");
+    Block_Cost_Model model_2x = model;
+    model_2x.bigfloat_fma_ns *= 2;
+    model_2x.residue_ns *= 2;
+    model_2x.blas_fma_ns *= 2;
+    CHECK(model_2x.block_time_ms(num_points, dim, N, num_primes)
+          == Catch::Approx(2 * time));
+  }
+
+  SECTION("load_or_calibrate")
+  {
+    // load_or_calibrate() is collective, so all ranks use the same file
+    const auto dir = fs::temp_directory_path() / "sdpb_unit_tests_cost_model";
+    const auto path = dir / "cost_model.json";
+    const std::string key = std::to_string(mpf_get_default_prec());
+    // Some other precision
+    const std::string other_key = "123";
+    REQUIRE(key != other_key);
+
+    if(El::mpi::Rank() == 0)
+      {
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+        std::ofstream os(path);
+        os << R"({")" << other_key << R"(": {"bigfloat_fma_ns": 1, )"
+           << R"("residue_ns": 2, "blas_fma_ns": 3}})";
+      }
+    El::mpi::Barrier();
+
+    INFO("No entry for the current precision: calibrate and save");
+    const auto model
+      = Block_Cost_Model::load_or_calibrate(path, Verbosity::none);
+    CHECK(model.precision == mpf_get_default_prec());
+    CHECK(model.bigfloat_fma_ns > 0);
+    CHECK(model.residue_ns > 0);
+    CHECK(model.blas_fma_ns > 0);
+
+    {
+      INFO("Entries for other precisions are kept");
+      boost::property_tree::ptree tree;
+      boost::property_tree::read_json(path.string(), tree);
+      CHECK(tree.get<double>(other_key + ".bigfloat_fma_ns") == 1);
+      CHECK(tree.get<double>(other_key + ".residue_ns") == 2);
+      CHECK(tree.get<double>(other_key + ".blas_fma_ns") == 3);
+      CHECK(tree.get_child_optional(key).has_value());
+    }
+
+    {
+      INFO("Read the model back");
+      const auto loaded
+        = Block_Cost_Model::load_or_calibrate(path, Verbosity::none);
+      CHECK(loaded.precision == model.precision);
+      CHECK(loaded.bigfloat_fma_ns == Catch::Approx(model.bigfloat_fma_ns));
+      CHECK(loaded.residue_ns == Catch::Approx(model.residue_ns));
+      CHECK(loaded.blas_fma_ns == Catch::Approx(model.blas_fma_ns));
+    }
+
+    {
+      INFO("Corrupted file: all ranks should throw");
+      El::mpi::Barrier();
+      if(El::mpi::Rank() == 0)
+        {
+          std::ofstream os(path);
+          os << "not a json";
+        }
+      El::mpi::Barrier();
+      CHECK_THROWS_WITH(
+        Block_Cost_Model::load_or_calibrate(path, Verbosity::none),
+        Catch::Matchers::ContainsSubstring("Error when reading cost model"));
+    }
+
+    El::mpi::Barrier();
+    if(El::mpi::Rank() == 0)
+      fs::remove_all(dir);
+  }
+}
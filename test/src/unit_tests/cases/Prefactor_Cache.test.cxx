@@ -0,0 +1,111 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "pmp/convert/Prefactor_Cache.hxx"
+#include "sdpb_util/Environment.hxx"
+#include "test_util/diff.hxx"
+
+using Test_Util::REQUIRE_Equal::diff;
+
+namespace
+{
+  // Restore default precision when leaving the scope,
+  // so that a failed check does not affect other tests.
+  struct Precision_Guard
+  {
+    const mp_bitcnt_t old_precision = El::gmp::Precision();
+    explicit Precision_Guard(const mp_bitcnt_t precision)
+    {
+      Environment::set_precision(precision);
+    }
+    ~Precision_Guard() { Environment::set_precision(old_precision); }
+  };
+
+  Damped_Rational damped_rational(const Boost_Float &base)
+  {
+    Damped_Rational result;
+    result.constant = 1;
+    result.base = base;
+    result.poles = {Boost_Float(-1), Boost_Float("-0.5")};
+    return result;
+  }
+
+  void diff_basis(const Polynomial_Vector &a, const Polynomial_Vector &b)
+  {
+    REQUIRE(a.size() == b.size());
+    for(size_t i = 0; i < a.size(); ++i)
+      {
+        CAPTURE(i);
+        DIFF(a.at(i).coefficients, b.at(i).coefficients);
+      }
+  }
+}
+
+TEST_CASE("Prefactor_Cache")
+{
+  Prefactor_Cache::clear();
+  const auto prefactor = damped_rational(Boost_Float("0.25"));
+  const size_t num_points = 5;
+  const size_t half_max_degree = 2;
+
+  INFO("First call is a miss");
+  const auto points = Prefactor_Cache::sample_points(num_points);
+  const auto scalings = Prefactor_Cache::sample_scalings(prefactor, points);
+  const auto basis
+    = Prefactor_Cache::bilinear_basis(prefactor, half_max_degree);
+  REQUIRE(points.size() == num_points);
+  REQUIRE(scalings.size() == num_points);
+  REQUIRE(Prefactor_Cache::stats().hits == 0);
+  REQUIRE(Prefactor_Cache::stats().misses == 3);
+
+  SECTION("hit")
+  {
+    DIFF(Prefactor_Cache::sample_points(num_points), points);
+    DIFF(Prefactor_Cache::sample_scalings(prefactor, points), scalings);
+    diff_basis(Prefactor_Cache::bilinear_basis(prefactor, half_max_degree),
+               basis);
+    REQUIRE(Prefactor_Cache::stats().hits == 3);
+    REQUIRE(Prefactor_Cache::stats().misses == 3);
+  }
+
+  SECTION("miss")
+  {
+    INFO("Different number of points, degree or prefactor");
+    const auto other_prefactor = damped_rational(Boost_Float("0.5"));
+    REQUIRE(Prefactor_Cache::sample_points(num_points + 1).size()
+            == num_points + 1);
+    const auto other_scalings
+      = Prefactor_Cache::sample_scalings(other_prefactor, points);
+    const auto other_basis
+      = Prefactor_Cache::bilinear_basis(prefactor, half_max_degree + 1);
+    Prefactor_Cache::bilinear_basis(other_prefactor, half_max_degree);
+    REQUIRE(Prefactor_Cache::stats().hits == 0);
+    REQUIRE(Prefactor_Cache::stats().misses == 7);
+    REQUIRE(other_scalings.at(1) != scalings.at(1));
+    REQUIRE(other_basis.size() == basis.size() + 1);
+  }
+
+  SECTION("precision")
+  {
+    INFO("Key differing only in precision is a miss");
+    {
+      const Precision_Guard guard(El::gmp::Precision() / 2);
+      const auto low_precision_points
+        = Prefactor_Cache::sample_points(num_points);
+      REQUIRE(low_precision_points.size() == num_points);
+      for(const auto &point : low_precision_points)
+        REQUIRE(point.Precision() == El::gmp::Precision());
+      Prefactor_Cache::bilinear_basis(prefactor, half_max_degree);
+      REQUIRE(Prefactor_Cache::stats().hits == 0);
+      REQUIRE(Prefactor_Cache::stats().misses == 5);
+    }
+
+    INFO("Values for the original precision are kept");
+    DIFF(Prefactor_Cache::sample_points(num_points), points);
+    REQUIRE(Prefactor_Cache::stats().hits == 1);
+    REQUIRE(Prefactor_Cache::stats().misses == 5);
+  }
+
+  Prefactor_Cache::clear();
+  REQUIRE(Prefactor_Cache::stats().hits == 0);
+  REQUIRE(Prefactor_Cache::stats().misses == 0);
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "pmp_read/PMP_File_Index.hxx"
+#include "sdpb_util/Shared_File_Buffer.hxx"
+
+#include <El.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+TEST_CASE("Shared_File_Buffer")
+{
+  El::mpi::Comm comm;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                      &comm.comm);
+
+  // Small PMP fixture, written by the first rank on each node
+  const auto dir = fs::temp_directory_path() / "sdpb_unit_tests_file_buffer";
+  const auto path = dir / "pmp.json";
+  const std::string matrix_0 = R"({"polynomials": [[[["1", "2"]]]]})";
+  const std::string matrix_1 = R"({"polynomials": [[[["3"]]]]})";
+  const std::string content = R"({"objective": ["1", "0"],)"
+                              "\n"
+                              R"("PositiveMatrixWithPrefactorArray": [)"
+                              + matrix_0 + ", " + matrix_1 + "]}\n";
+  if(comm.Rank() == 0)
+    {
+      fs::remove_all(dir);
+      fs::create_directories(dir);
+      std::ofstream os(path, std::ios::binary);
+      os << content;
+    }
+  El::mpi::Barrier(comm);
+
+  SECTION("all ranks see the file content")
+  {
+    const Shared_File_Buffer buffer(comm, path);
+    REQUIRE(buffer.size() == content.size());
+    REQUIRE(std::string(buffer.data(), buffer.size()) == content);
+
+    INFO("Index built from the buffer is the same on all ranks");
+    const auto index = PMP_File_Index::create(
+      path, buffer.data(), buffer.data() + buffer.size());
+    REQUIRE(index.matrices.size() == 2);
+    REQUIRE(content.substr(index.matrices.at(0).begin,
+                           index.matrices.at(0).size())
+            == matrix_0);
+    REQUIRE(content.substr(index.matrices.at(1).begin,
+                           index.matrices.at(1).size())
+            == matrix_1);
+    for(const auto &range : index.matrices)
+      {
+        size_t begin = range.begin;
+        El::mpi::Broadcast(begin, 0, comm);
+        REQUIRE(begin == range.begin);
+      }
+  }
+
+  SECTION("missing file")
+  {
+    INFO("All ranks should throw");
+    REQUIRE_THROWS(Shared_File_Buffer(comm, dir / "missing.json"));
+  }
+
+  El::mpi::Barrier(comm);
+  if(comm.Rank() == 0)
+    fs::remove_all(dir);
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "sdpb_util/Thread_Pool.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Thread_Pool")
+{
+  for(const size_t num_threads : {1, 2, 4})
+    DYNAMIC_SECTION("num_threads=" << num_threads)
+    {
+      Thread_Pool pool(num_threads);
+      REQUIRE(pool.num_threads() == num_threads);
+
+      SECTION("each index exactly once")
+      {
+        // Several batches, to check that the pool can be reused
+        for(const size_t num_jobs : {0, 1, 3, 1000})
+          {
+            CAPTURE(num_jobs);
+            std::vector<std::atomic<size_t>> counts(num_jobs);
+            pool.parallel_for(num_jobs, [&](const size_t i) { ++counts.at(i); });
+            for(size_t i = 0; i < num_jobs; ++i)
+              {
+                CAPTURE(i);
+                REQUIRE(counts.at(i) == 1);
+              }
+          }
+      }
+
+      SECTION("exception")
+      {
+        INFO("The first exception is rethrown after all running jobs finish");
+        std::atomic<size_t> num_running = 0;
+        std::atomic<size_t> num_started = 0;
+        std::atomic<size_t> num_finished = 0;
+        auto job = [&](const size_t i) {
+          ++num_started;
+          ++num_running;
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          --num_running;
+          if(i == 0)
+            throw std::runtime_error("job 0 failed");
+          ++num_finished;
+        };
+        REQUIRE_THROWS_WITH(pool.parallel_for(100, job), "job 0 failed");
+        REQUIRE(num_running == 0);
+        REQUIRE(num_finished + 1 == num_started);
+        // Remaining jobs are cancelled
+        REQUIRE(num_started < 100);
+
+        INFO("The pool is still usable after exception");
+        std::atomic<size_t> count = 0;
+        pool.parallel_for(10, [&](size_t) { ++count; });
+        REQUIRE(count == 10);
+      }
+
+      SECTION("nested call runs sequentially")
+      {
+        std::atomic<size_t> num_mismatched_threads = 0;
+        std::atomic<size_t> count = 0;
+        pool.parallel_for(4, [&](size_t) {
+          const auto outer_id = std::this_thread::get_id();
+          pool.parallel_for(10, [&](size_t) {
+            if(std::this_thread::get_id() != outer_id)
+              ++num_mismatched_threads;
+            ++count;
+          });
+        });
+        REQUIRE(count == 40);
+        REQUIRE(num_mismatched_threads == 0);
+      }
+
+      SECTION("concurrent call runs sequentially")
+      {
+        INFO("parallel_for() from another thread while a batch is running "
+             "should not wait for the pool");
+        std::atomic<size_t> num_mismatched_threads = 0;
+        std::atomic<size_t> count = 0;
+        pool.parallel_for(2, [&](const size_t i) {
+          if(i != 0)
+            return;
+          std::thread other([&] {
+            const auto other_id = std::this_thread::get_id();
+            pool.parallel_for(10, [&](size_t) {
+              if(std::this_thread::get_id() != other_id)
+                ++num_mismatched_threads;
+              ++count;
+            });
+          });
+          other.join();
+        });
+        REQUIRE(count == 10);
+        REQUIRE(num_mismatched_threads == 0);
+      }
+    }
+
+  SECTION("single thread runs jobs in calling thread")
+  {
+    Thread_Pool pool(1);
+    const auto id = std::this_thread::get_id();
+    size_t num_mismatched_threads = 0;
+    pool.parallel_for(10, [&](size_t) {
+      if(std::this_thread::get_id() != id)
+        ++num_mismatched_threads;
+    });
+    REQUIRE(num_mismatched_threads == 0);
+  }
+
+  SECTION("zero threads")
+  {
+    REQUIRE_THROWS(Thread_Pool(0));
+  }
+}
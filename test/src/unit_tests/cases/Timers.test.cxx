@@ -0,0 +1,50 @@
+#include <catch2/catch_amalgamated.hpp>
+#include <El.hpp>
+
+#include "sdpb_util/Timers/Timers.hxx"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+TEST_CASE("Timers")
+{
+  SECTION("add_counter")
+  {
+    INFO("Counters are written to profile with the current prefix");
+    const auto path
+      = fs::temp_directory_path()
+        / ("sdpb_unit_tests_profile." + std::to_string(El::mpi::Rank())
+           + ".json");
+
+    {
+      Timers timers;
+      timers.add_counter("top_level", -1);
+      {
+        Scoped_Timer read_timer(timers, "read_pmp");
+        Scoped_Timer parse_timer(timers, "parse");
+        timers.add_counter("cache.hits", 42);
+        timers.add_counter("cache.misses", 0);
+      }
+      timers.write_profile(path);
+    }
+
+    std::ifstream is(path);
+    REQUIRE(is.good());
+    std::stringstream ss;
+    ss << is.rdbuf();
+    const auto profile = ss.str();
+    CAPTURE(profile);
+    using Catch::Matchers::ContainsSubstring;
+    CHECK_THAT(profile, ContainsSubstring("{\"top_level\", -1}"));
+    CHECK_THAT(profile,
+               ContainsSubstring("{\"read_pmp.parse.cache.hits\", 42}"));
+    CHECK_THAT(profile,
+               ContainsSubstring("{\"read_pmp.parse.cache.misses\", 0}"));
+    CHECK_THAT(profile, ContainsSubstring("\"read_pmp.parse\""));
+
+    fs::remove(path);
+  }
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "unit_tests/util/util.hxx"
+#include "pmp_read/Binary_PMP_Format.hxx"
+
+using Test_Util::random_bigfloat;
+using Test_Util::random_vector;
+using Test_Util::REQUIRE_Equal::diff;
+
+namespace
+{
+  Binary_PMP_Format::Reader reader(const Binary_PMP_Format::Writer &writer)
+  {
+    const auto &buffer = writer.buffer;
+    return {buffer.data(), buffer.data() + buffer.size()};
+  }
+
+  Polynomial random_polynomial(const size_t degree)
+  {
+    Polynomial result;
+    result.coefficients = random_vector(degree + 1);
+    return result;
+  }
+}
+
+TEST_CASE("Binary_PMP_Format")
+{
+  // this test is purely single-process, thus testing at rank=0 is sufficient
+  if(El::mpi::Rank() != 0)
+    return;
+
+  El::InitializeRandom(true);
+
+  SECTION("numbers")
+  {
+    auto values = random_vector(100);
+    values.emplace_back(0);
+    values.emplace_back(-1);
+    values.emplace_back(std::string("1e-1000"));
+    values.emplace_back(std::string("-3.5e1000"));
+
+    Binary_PMP_Format::Writer writer;
+    writer.write(values);
+    DIFF(reader(writer).read_vector(), values);
+
+    // Reading with lower precision
+    El::BigFloat result;
+    result.SetPrecision(64);
+    for(const auto &value : values)
+      {
+        Binary_PMP_Format::Writer number_writer;
+        number_writer.write(value);
+        reader(number_writer).read(result);
+        REQUIRE(result.Precision() == 64);
+        El::BigFloat expected;
+        expected.SetPrecision(64);
+        expected = value;
+        DIFF_PREC(result, expected, 60);
+      }
+
+    // Truncated input
+    writer.buffer.pop_back();
+    REQUIRE_THROWS(reader(writer).read_vector());
+  }
+
+  SECTION("matrix")
+  {
+    const size_t degree = 6;
+    El::Matrix<Polynomial_Vector> polynomials(2, 2);
+    for(int i = 0; i < 2; ++i)
+      for(int j = 0; j <= i; ++j)
+        {
+          Polynomial_Vector vector;
+          for(size_t n = 0; n < 3; ++n)
+            vector.push_back(random_polynomial(degree));
+          polynomials(i, j) = vector;
+          polynomials(j, i) = vector;
+        }
+    const Polynomial_Vector_Matrix matrix(polynomials, std::nullopt,
+                                          std::nullopt, std::nullopt,
+                                          std::nullopt);
+
+    Binary_PMP_Format::Writer writer;
+    writer.write(matrix);
+    const auto result = reader(writer).read_matrix();
+
+    REQUIRE(result.polynomials.Height() == 2);
+    REQUIRE(result.polynomials.Width() == 2);
+    for(int i = 0; i < 2; ++i)
+      for(int j = 0; j < 2; ++j)
+        {
+          CAPTURE(i, j);
+          const auto &expected = matrix.polynomials(i, j);
+          const auto &actual = result.polynomials(i, j);
+          REQUIRE(actual.size() == expected.size());
+          for(size_t n = 0; n < expected.size(); ++n)
+            DIFF(actual.at(n).coefficients, expected.at(n).coefficients);
+        }
+    DIFF(result.sample_points, matrix.sample_points);
+    DIFF(result.sample_scalings, matrix.sample_scalings);
+    REQUIRE(result.bilinear_basis.size() == matrix.bilinear_basis.size());
+    for(size_t m = 0; m < matrix.bilinear_basis.size(); ++m)
+      DIFF(result.bilinear_basis.at(m).coefficients,
+           matrix.bilinear_basis.at(m).coefficients);
+  }
+
+  SECTION("index")
+  {
+    Binary_PMP_Format::Writer writer;
+    writer.buffer = std::string(1000, 'x');
+    const auto &buffer = writer.buffer;
+    REQUIRE_THROWS(Binary_PMP_Format::read_index(
+      buffer.data(), buffer.data() + buffer.size()));
+  }
+}
@@ -93,8 +93,8 @@ TEST_CASE("block_data serialization")
   Dual_Constraint_Group group = random_group_from_singlet_scalar_block_0();
   Dual_Constraint_Group zero_group = zero_group_from_singlet_scalar_block_0();
 
-  Block_File_Format format = GENERATE(bin, json);
-  DYNAMIC_SECTION((format == bin ? ".bin" : ".json"))
+  Block_File_Format format = GENERATE(bin, json, mmap_bin);
+  DYNAMIC_SECTION(format)
   {
     auto other = serialize_deserialize(group, format);
     DIFF(group, other);
@@ -1,6 +1,7 @@
 #include <catch2/catch_amalgamated.hpp>
 
 #include "sdpb_util/block_mapping/compute_block_grid_mapping.hxx"
+#include "sdpb_util/block_mapping/limit_block_grid_mapping_memory.hxx"
 #include "test_util/diff.hxx"
 #include "unit_tests/util/util.hxx"
 
@@ -46,6 +47,30 @@ TEST_CASE("compute_block_grid_mapping")
     }
   }
 
+  SECTION("Different node sizes")
+  {
+    // Node capacity is proportional to the number of procs,
+    // so the larger node gets more blocks.
+    const std::vector<size_t> procs_per_node = {1, 3};
+    const std::vector<Block_Cost> block_costs
+      = {{10, 0}, {10, 1}, {10, 2}, {10, 3}};
+    const auto mapping
+      = compute_block_grid_mapping(procs_per_node, block_costs);
+    REQUIRE(mapping.size() == procs_per_node.size());
+    for(size_t node = 0; node < mapping.size(); ++node)
+      {
+        CAPTURE(node);
+        size_t num_procs = 0, num_blocks = 0;
+        for(const auto &block_map : mapping[node])
+          {
+            num_procs += block_map.num_procs;
+            num_blocks += block_map.block_indices.size();
+          }
+        REQUIRE(num_procs == procs_per_node[node]);
+        REQUIRE(num_blocks == procs_per_node[node]);
+      }
+  }
+
   SECTION("Random")
   {
     size_t num_nodes = GENERATE(1, 2, 5);
@@ -115,4 +140,143 @@ TEST_CASE("compute_block_grid_mapping")
       REQUIRE(processed_indices.size() == num_blocks);
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("improve_block_grid_mapping")
+{
+  if(El::mpi::Rank() != 0)
+    return;
+
+  SECTION("Move block")
+  {
+    const std::vector<Block_Cost> block_costs = {{10, 0}, {10, 1}, {1, 2}};
+    std::vector<std::vector<Block_Map>> mapping
+      = {{Block_Map(1, 20, {0, 1}), Block_Map(1, 1, {2})}};
+    CHECK(block_grid_mapping_imbalance(mapping) == Catch::Approx(40.0 / 21));
+
+    improve_block_grid_mapping(mapping, block_costs);
+    const decltype(mapping) expected_mapping
+      = {{Block_Map(1, 10, {1}), Block_Map(1, 11, {2, 0})}};
+    DIFF(mapping, expected_mapping);
+    CHECK(block_grid_mapping_imbalance(mapping) == Catch::Approx(22.0 / 21));
+  }
+
+  SECTION("Share procs with large block")
+  {
+    // Single-proc block_maps on the first node are merged,
+    // and the large block gets one more proc.
+    const std::vector<Block_Cost> block_costs = {{100, 0}, {5, 1}, {5, 2}};
+    std::vector<std::vector<Block_Map>> mapping
+      = {{Block_Map(2, 100, {0}), Block_Map(1, 5, {1}), Block_Map(1, 5, {2})}};
+
+    improve_block_grid_mapping(mapping, block_costs);
+    const decltype(mapping) expected_mapping
+      = {{Block_Map(3, 100, {0}), Block_Map(1, 10, {2, 1})}};
+    DIFF(mapping, expected_mapping);
+  }
+
+  SECTION("Use idle procs")
+  {
+    const std::vector<Block_Cost> block_costs = {{10, 0}};
+    std::vector<std::vector<Block_Map>> mapping
+      = {{Block_Map(1, 10, {0}), Block_Map(1, 0, {})}};
+
+    improve_block_grid_mapping(mapping, block_costs);
+    const decltype(mapping) expected_mapping = {{Block_Map(2, 10, {0})}};
+    DIFF(mapping, expected_mapping);
+  }
+
+  SECTION("Random")
+  {
+    // Result of improvement should not be worse than the initial mapping
+    const size_t num_nodes = GENERATE(1, 3);
+    const size_t procs_per_node = GENERATE(4, 16);
+    const size_t num_blocks = GENERATE(10, 100);
+    CAPTURE(num_nodes);
+    CAPTURE(procs_per_node);
+    CAPTURE(num_blocks);
+
+    std::default_random_engine rand_engine;
+    std::uniform_int_distribution<size_t> dist(1, 100);
+    std::vector<Block_Cost> block_costs;
+    for(size_t index = 0; index < num_blocks; ++index)
+      block_costs.emplace_back(dist(rand_engine), index);
+
+    // Naive initial mapping: round-robin over single-proc block_maps
+    std::vector<std::vector<Block_Map>> mapping(num_nodes);
+    for(auto &node_mapping : mapping)
+      for(size_t proc = 0; proc < procs_per_node; ++proc)
+        node_mapping.push_back(Block_Map(1, 0, {}));
+    for(const auto &block : block_costs)
+      {
+        const size_t proc = block.index % (num_nodes * procs_per_node);
+        auto &block_map
+          = mapping.at(proc / procs_per_node).at(proc % procs_per_node);
+        block_map.cost += block.cost;
+        block_map.block_indices.push_back(block.index);
+      }
+
+    const auto initial_imbalance = block_grid_mapping_imbalance(mapping);
+    improve_block_grid_mapping(mapping, block_costs);
+    CHECK(block_grid_mapping_imbalance(mapping) <= initial_imbalance);
+
+    size_t num_indices = 0;
+    for(const auto &node_mapping : mapping)
+      {
+        size_t num_procs = 0;
+        for(const auto &block_map : node_mapping)
+          {
+            size_t cost = 0;
+            for(const auto index : block_map.block_indices)
+              cost += block_costs.at(index).cost;
+            REQUIRE(cost == block_map.cost);
+            num_indices += block_map.block_indices.size();
+            num_procs += block_map.num_procs;
+          }
+        REQUIRE(num_procs == procs_per_node);
+      }
+    REQUIRE(num_indices == num_blocks);
+  }
+}
+
+TEST_CASE("limit_block_grid_mapping_memory")
+{
+  if(El::mpi::Rank() != 0)
+    return;
+
+  // Blocks 0 and 1 are cheap but large, block 2 and 3 are small
+  const std::vector<Block_Cost> block_costs
+    = {{10, 0}, {10, 1}, {10, 2}, {10, 3}};
+  const std::vector<size_t> block_memory = {100, 100, 10, 10};
+
+  SECTION("Swap blocks")
+  {
+    std::vector<std::vector<Block_Map>> mapping
+      = {{Block_Map(1, 20, {0, 1})}, {Block_Map(1, 20, {2, 3})}};
+    REQUIRE(limit_block_grid_mapping_memory(mapping, block_costs,
+                                            block_memory, 150));
+    const decltype(mapping) expected_mapping
+      = {{Block_Map(1, 20, {2, 1})}, {Block_Map(1, 20, {0, 3})}};
+    DIFF(mapping, expected_mapping);
+    DIFF(block_grid_mapping_node_memory(mapping, block_memory),
+         std::vector<size_t>{110, 110});
+  }
+
+  SECTION("Fits already")
+  {
+    std::vector<std::vector<Block_Map>> mapping
+      = {{Block_Map(1, 20, {0, 1})}, {Block_Map(1, 20, {2, 3})}};
+    const auto initial_mapping = mapping;
+    REQUIRE(limit_block_grid_mapping_memory(mapping, block_costs,
+                                            block_memory, 200));
+    DIFF(mapping, initial_mapping);
+  }
+
+  SECTION("Impossible")
+  {
+    std::vector<std::vector<Block_Map>> mapping
+      = {{Block_Map(1, 20, {0, 1})}, {Block_Map(1, 20, {2, 3})}};
+    REQUIRE(!limit_block_grid_mapping_memory(mapping, block_costs,
+                                             block_memory, 100));
+  }
+}
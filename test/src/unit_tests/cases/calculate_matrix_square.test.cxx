@@ -7,6 +7,8 @@
 #include "unit_tests/util/util.hxx"
 
 #include <El.hpp>
+#include <numeric>
+#include <optional>
 #include <vector>
 
 using Test_Util::REQUIRE_Equal::diff;
@@ -84,6 +86,122 @@ namespace
     El::MakeSymmetric(El::UPPER, Q_result);
     return Q_result;
   }
+
+  // Calculate Q = P^T P via BigInt_Shared_Memory_Syrk_Context
+  // and compare it with El::Syrk.
+  // P_matrix should be the same on all ranks.
+  // COMM_WORLD is split into quasi-nodes of sizes procs_per_node,
+  // each quasi-node has a single MPI group.
+  // Blocks of P are distributed among the quasi-nodes round-robin.
+  // If emulate_numa_nodes=true, windows are NUMA-aware,
+  // and even and odd ranks of each quasi-node pretend to be
+  // on two different NUMA nodes.
+  void check_bigint_syrk_blas(const El::Matrix<El::BigFloat> &P_matrix,
+                              const std::vector<El::Int> &block_heights,
+                              const std::vector<size_t> &procs_per_node,
+                              const bool emulate_numa_nodes = false)
+  {
+    const El::mpi::Comm comm_world = El::mpi::COMM_WORLD;
+    const size_t num_nodes = procs_per_node.size();
+    CAPTURE(procs_per_node);
+    REQUIRE(std::accumulate(procs_per_node.begin(), procs_per_node.end(),
+                            size_t(0))
+            == comm_world.Size());
+
+    // Each quasi-node contains consecutive ranks
+    int node_index = 0;
+    size_t node_end = procs_per_node.at(0);
+    while(static_cast<size_t>(comm_world.Rank()) >= node_end)
+      node_end += procs_per_node.at(++node_index);
+    CAPTURE(node_index);
+    El::mpi::Comm node_comm;
+    MPI_Comm_split(comm_world.comm, node_index, 0, &node_comm.comm);
+    REQUIRE(node_comm.Size() == procs_per_node.at(node_index));
+    const El::Grid node_grid(node_comm);
+
+    const int block_width = P_matrix.Width();
+    std::vector<El::DistMatrix<El::BigFloat>> P_matrix_blocks;
+    std::vector<size_t> block_indices;
+    std::vector<std::vector<El::Range<El::Int>>> block_nonzero_columns;
+    std::vector<El::Int> blocks_height_per_group(1, 0);
+    El::Int global_block_offset = 0;
+    for(size_t block_index = 0; block_index < block_heights.size();
+        ++block_index)
+      {
+        const auto block_height = block_heights.at(block_index);
+        if(block_index % num_nodes == static_cast<size_t>(node_index))
+          {
+            auto &block = P_matrix_blocks.emplace_back(
+              block_height, block_width, node_grid);
+            for(int iLoc = 0; iLoc < block.LocalHeight(); ++iLoc)
+              for(int jLoc = 0; jLoc < block.LocalWidth(); ++jLoc)
+                block.SetLocal(
+                  iLoc, jLoc,
+                  P_matrix.Get(global_block_offset + block.GlobalRow(iLoc),
+                               block.GlobalCol(jLoc)));
+            block_indices.push_back(block_index);
+            block_nonzero_columns.push_back(
+              {El::Range<El::Int>(0, block_width)});
+            blocks_height_per_group.at(0) += block_height;
+          }
+        global_block_offset += block_height;
+      }
+    REQUIRE(!P_matrix_blocks.empty());
+
+    const int bits = El::gmp::Precision();
+    const El::UpperOrLower uplo = El::UPPER;
+    El::DistMatrix<El::BigFloat> Q_result(block_width, block_width);
+    Matrix_Normalizer normalizer(P_matrix_blocks, block_width, bits,
+                                 El::mpi::COMM_WORLD);
+    for(auto &block : P_matrix_blocks)
+      normalizer.normalize_and_shift_P(block);
+    {
+      const std::vector<int> group_comm_sizes{node_comm.Size()};
+      const size_t group_index = 0;
+      const size_t max_shared_memory_bytes = 0;
+      const bool dynamic_blas_jobs = false;
+      const bool huge_pages = false;
+      const bool pipeline_windows = false;
+      std::optional<int> numa_node;
+      if(emulate_numa_nodes)
+        numa_node = node_comm.Rank() % 2;
+      BigInt_Shared_Memory_Syrk_Context context(
+        node_comm, node_index, procs_per_node, group_index, group_comm_sizes,
+        bits, max_shared_memory_bytes, blocks_height_per_group, block_width,
+        block_indices, block_nonzero_columns, Verbosity::regular,
+        create_blas_job_schedule, dynamic_blas_jobs, emulate_numa_nodes,
+        huge_pages, pipeline_windows, numa_node);
+      if(emulate_numa_nodes)
+        {
+          INFO("Each emulated NUMA node should have its own segment");
+          REQUIRE(context.num_numa_segments()
+                  == std::min<size_t>(node_comm.Size(), 2));
+        }
+
+      Timers timers;
+      El::Matrix<int32_t> block_timings_ms(block_heights.size(), 1);
+      El::Zero(block_timings_ms);
+      context.bigint_syrk_blas(uplo, P_matrix_blocks, Q_result, timers,
+                               block_timings_ms);
+    }
+    normalizer.restore_Q(uplo, Q_result);
+    El::MakeSymmetric(uplo, Q_result);
+
+    const auto Q_result_El_Syrk = calculate_matrix_square_El_Syrk(P_matrix);
+    // See diff_precision in calculate_Block_Matrix_square test
+    const int diff_precision = bits / 2;
+    for(int iLoc = 0; iLoc < Q_result.LocalHeight(); ++iLoc)
+      for(int jLoc = 0; jLoc < Q_result.LocalWidth(); ++jLoc)
+        {
+          const auto global_row = Q_result.GlobalRow(iLoc);
+          const auto global_col = Q_result.GlobalCol(jLoc);
+          CAPTURE(global_row);
+          CAPTURE(global_col);
+          DIFF_PREC(Q_result.GetLocal(iLoc, jLoc),
+                    Q_result_El_Syrk.Get(global_row, global_col),
+                    diff_precision);
+        }
+  }
 }
 
 TEST_CASE("calculate_Block_Matrix_square")
@@ -169,6 +287,9 @@ TEST_CASE("calculate_Block_Matrix_square")
                 : max_shared_memory_bytes == 1
                   ? "Splitting P memory window"
                   : "Do not split memory windows"));
+          // Extra memory for the second set of input windows
+          // if windows are pipelined
+          size_t pipeline_extra_bytes = 0;
           if(max_shared_memory_bytes == 1)
             {
               // Do not split output window
@@ -194,11 +315,20 @@ TEST_CASE("calculate_Block_Matrix_square")
                 = (output_window_height * output_window_width
                    + 2 * input_window_height * input_window_width)
                   * num_primes * sizeof(double);
+              // Minimal input windows cannot be halved
+              pipeline_extra_bytes = 2 * input_window_height
+                                     * input_window_width * num_primes
+                                     * sizeof(double);
             }
 
+          // Some columns of P blocks are zero,
+          // as for P = L^{-1} B when a block involves only some of y's
+          const bool with_zero_columns = GENERATE(false, true);
+
           DYNAMIC_SECTION("P_height="
                           << total_block_height << " num_blocks=" << num_blocks
-                          << " maxSharedMemory=" << max_shared_memory_bytes)
+                          << " maxSharedMemory=" << max_shared_memory_bytes
+                          << " with_zero_columns=" << with_zero_columns)
           {
             int bits;
             CAPTURE(bits = El::gmp::Precision());
@@ -229,6 +359,28 @@ TEST_CASE("calculate_Block_Matrix_square")
                   // Fill with 1.0 - for easier debug:
                   // El::Fill(P_matrix, El::BigFloat(1.0));
 
+                  if(with_zero_columns)
+                    {
+                      // Zero some columns in each block,
+                      // and the last column in all blocks
+                      int global_block_offset = 0;
+                      for(size_t block_index = 0;
+                          block_index < block_heights.size(); ++block_index)
+                        {
+                          for(int j = 0; j < block_width; ++j)
+                            {
+                              if((j + block_index) % 3 != 0
+                                 && !(block_width > 1 && j == block_width - 1))
+                                continue;
+                              for(int i = 0; i < block_heights.at(block_index);
+                                  ++i)
+                                P_matrix.Set(global_block_offset + i, j,
+                                             El::BigFloat(0));
+                            }
+                          global_block_offset += block_heights.at(block_index);
+                        }
+                    }
+
                   Q_result_El_Syrk = calculate_matrix_square_El_Syrk(P_matrix);
 
                   // Double-check our result with Gemm
@@ -257,6 +409,8 @@ TEST_CASE("calculate_Block_Matrix_square")
 
             std::vector<El::DistMatrix<El::BigFloat>> P_matrix_blocks;
             std::vector<size_t> block_indices;
+            // Ranges of nonzero columns for each block in P_matrix_blocks
+            std::vector<std::vector<El::Range<El::Int>>> block_nonzero_columns;
             {
               INFO("Initialize P_matrix_blocks for FLINT+BLAS "
                    "multiplication");
@@ -288,6 +442,22 @@ TEST_CASE("calculate_Block_Matrix_square")
                       // TODO block indices for window!
                       block_indices.push_back(block_index);
                       P_matrix_blocks.push_back(block);
+
+                      auto &ranges = block_nonzero_columns.emplace_back();
+                      for(int j = 0; j < block_width; ++j)
+                        {
+                          bool is_nonzero = false;
+                          for(int i = 0; i < block_height && !is_nonzero; ++i)
+                            is_nonzero
+                              = P_matrix.Get(global_block_offset + i, j)
+                                != El::BigFloat(0);
+                          if(!is_nonzero)
+                            continue;
+                          if(!ranges.empty() && ranges.back().end == j)
+                            ++ranges.back().end;
+                          else
+                            ranges.emplace_back(j, j + 1);
+                        }
                     }
                   global_block_offset += block_height;
                 }
@@ -300,8 +470,12 @@ TEST_CASE("calculate_Block_Matrix_square")
             for(size_t blas_schedule_split_factor = 1;
                 blas_schedule_split_factor <= block_width;
                 blas_schedule_split_factor += 3)
-              DYNAMIC_SECTION(
-                "blas_split_factor=" << blas_schedule_split_factor)
+              for(bool dynamic_blas_jobs : {false, true})
+                for(bool pipeline_windows : {false, true})
+                  DYNAMIC_SECTION("blas_split_factor="
+                                  << blas_schedule_split_factor
+                                  << " dynamic_blas_jobs=" << dynamic_blas_jobs
+                                  << " pipeline_windows=" << pipeline_windows)
               {
                 INFO("P matrix is split into " << blas_schedule_split_factor
                                                << " vertical bands P_I");
@@ -349,11 +523,28 @@ TEST_CASE("calculate_Block_Matrix_square")
 
                   {
                     const Verbosity verbosity = Verbosity::regular;
+                    const size_t context_max_shared_memory_bytes
+                      = pipeline_windows
+                          ? max_shared_memory_bytes + pipeline_extra_bytes
+                          : max_shared_memory_bytes;
+                    const std::vector<size_t> procs_per_node(num_nodes,
+                                                             node_size);
                     BigInt_Shared_Memory_Syrk_Context context(
-                      node_comm, group_index_in_node,
-                      group_comm_sizes_per_node, bits, max_shared_memory_bytes,
+                      node_comm, node_index, procs_per_node,
+                      group_index_in_node, group_comm_sizes_per_node, bits,
+                      context_max_shared_memory_bytes,
                       blocks_height_per_group, block_width, block_indices,
-                      verbosity, create_job_schedule);
+                      block_nonzero_columns, verbosity, create_job_schedule,
+                      dynamic_blas_jobs, false, false, pipeline_windows);
+                    if(pipeline_windows && context.is_split())
+                      {
+                        INFO("Windows are split and there is enough memory "
+                             "for the second set of input windows, "
+                             "so the pipeline should run");
+                        REQUIRE(context.is_pipelined());
+                      }
+                    if(!pipeline_windows)
+                      REQUIRE(!context.is_pipelined());
 
                     Timers timers;
                     El::Matrix<int32_t> block_timings_ms(num_blocks, 1);
@@ -363,7 +554,8 @@ TEST_CASE("calculate_Block_Matrix_square")
                                              timers, block_timings_ms);
                   }
                   {
-                    INFO("Check that normalized Q_ii = 1:");
+                    INFO("Check that normalized Q_ii = 1 "
+                         "(or 0 for zero columns):");
                     // TODO: if check fails only on some rank!=0,
                     // rank=0 will hang, waiting for
                     for(int iLoc = 0; iLoc < Q_result.LocalHeight(); ++iLoc)
@@ -375,8 +567,13 @@ TEST_CASE("calculate_Block_Matrix_square")
                             {
                               CAPTURE(i);
                               auto value = Q_result.GetLocal(iLoc, jLoc);
+                              const El::BigFloat expected
+                                = normalizer.column_norms.at(i)
+                                      == El::BigFloat(0)
+                                    ? El::BigFloat(0)
+                                    : El::BigFloat(1);
                               DIFF_PREC(value >> 2 * normalizer.precision,
-                                        El::BigFloat(1), diff_precision);
+                                        expected, diff_precision);
                             }
                         }
                   }
@@ -408,4 +605,81 @@ TEST_CASE("calculate_Block_Matrix_square")
         }
       }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("bigint_syrk_blas for nodes of different size")
+{
+  INFO("Quasi-nodes with different number of ranks,"
+       " e.g. 2+4 ranks for mpirun -n 6");
+  {
+    El::mpi::Comm comm_shmem;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &comm_shmem.comm);
+    INFO("Quasi-nodes should share memory, i.e. run on a single node");
+    REQUIRE(El::mpi::Congruent(comm_shmem, El::mpi::COMM_WORLD));
+  }
+  const size_t num_ranks = El::mpi::Size();
+  if(num_ranks < 3)
+    SKIP("The test requires at least 3 ranks");
+  const std::vector<size_t> procs_per_node{num_ranks / 3,
+                                           num_ranks - num_ranks / 3};
+
+  const int block_width = GENERATE(1, 10);
+  const std::vector<El::Int> block_heights{3, 1, 4, 1, 5, 9};
+  const auto total_block_height = std::accumulate(
+    block_heights.begin(), block_heights.end(), El::Int(0));
+  CAPTURE(block_width);
+  CAPTURE(block_heights);
+
+  El::Matrix<El::BigFloat> P_matrix(total_block_height, block_width);
+  if(El::mpi::Rank() == 0)
+    P_matrix = Test_Util::random_matrix(total_block_height, block_width);
+  El::mpi::Broadcast(P_matrix.Buffer(), P_matrix.MemorySize(), 0,
+                     El::mpi::COMM_WORLD);
+
+  check_bigint_syrk_blas(P_matrix, block_heights, procs_per_node);
+}
+
+TEST_CASE("bigint_syrk_blas with NUMA-aware windows")
+{
+  INFO("Even and odd ranks pretend to be on different NUMA nodes, "
+       "so that BLAS jobs are split into two per-segment lists "
+       "and ranks steal jobs from the other segment.");
+  {
+    El::mpi::Comm comm_shmem;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &comm_shmem.comm);
+    INFO("Quasi-nodes should share memory, i.e. run on a single node");
+    REQUIRE(El::mpi::Congruent(comm_shmem, El::mpi::COMM_WORLD));
+  }
+  const size_t num_ranks = El::mpi::Size();
+  if(num_ranks < 2)
+    SKIP("The test requires at least 2 ranks");
+  // Single node, or two uneven quasi-nodes.
+  // Each node should have at least 2 ranks to get 2 NUMA segments.
+  std::vector<std::vector<size_t>> procs_per_node_options{{num_ranks}};
+  if(num_ranks >= 5)
+    procs_per_node_options.push_back({2, num_ranks - 2});
+  for(const auto &procs_per_node : procs_per_node_options)
+    {
+      DYNAMIC_SECTION("num_nodes=" << procs_per_node.size())
+      {
+        const int block_width = GENERATE(1, 10);
+        const std::vector<El::Int> block_heights{3, 1, 4, 1, 5, 9};
+        const auto total_block_height = std::accumulate(
+          block_heights.begin(), block_heights.end(), El::Int(0));
+        CAPTURE(block_width);
+        CAPTURE(block_heights);
+
+        El::Matrix<El::BigFloat> P_matrix(total_block_height, block_width);
+        if(El::mpi::Rank() == 0)
+          P_matrix
+            = Test_Util::random_matrix(total_block_height, block_width);
+        El::mpi::Broadcast(P_matrix.Buffer(), P_matrix.MemorySize(), 0,
+                           El::mpi::COMM_WORLD);
+
+        const bool emulate_numa_nodes = true;
+        check_bigint_syrk_blas(P_matrix, block_heights, procs_per_node,
+                               emulate_numa_nodes);
+      }
+    }
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "pmp_read/PMP_File_Index.hxx"
+
+#include <string>
+
+namespace
+{
+  PMP_File_Index index_json(const std::string &json)
+  {
+    return PMP_File_Index::create("pmp.json", json.data(),
+                                  json.data() + json.size());
+  }
+
+  std::string substr(const std::string &str, const Byte_Range &range)
+  {
+    return str.substr(range.begin, range.size());
+  }
+}
+
+TEST_CASE("index_json")
+{
+  SECTION("element boundaries")
+  {
+    const std::string objective = R"(["1", "-2.5e3"])";
+    const std::string normalization = R"([ "1" , "0" ])";
+    const std::string matrix_0
+      = R"({"DampedRational": {"constant": "1", "base": "0.5", "poles": []},)"
+        R"( "polynomials": [[[["1", "2"], ["3"]]]]})";
+    // Brackets and escaped quotes inside strings should be skipped
+    const std::string matrix_1
+      = R"({"polynomials": [[[["1"]]]], "comment": "]}\"[{"})";
+    const std::string json = "{\n  \"objective\": " + objective
+                             + ",\n  \"normalization\":" + normalization
+                             + ",\n  \"PositiveMatrixWithPrefactorArray\": [\n"
+                             + matrix_0 + " ,\n" + matrix_1 + "\n  ]\n}\n";
+
+    const auto index = index_json(json);
+    REQUIRE(index.objective.has_value());
+    REQUIRE(substr(json, index.objective.value()) == objective);
+    REQUIRE(index.normalization.has_value());
+    REQUIRE(substr(json, index.normalization.value()) == normalization);
+    REQUIRE(index.matrices.size() == 2);
+    REQUIRE(substr(json, index.matrices.at(0)) == matrix_0);
+    REQUIRE(substr(json, index.matrices.at(1)) == matrix_1);
+  }
+
+  SECTION("matrices without objective")
+  {
+    const std::string matrix = R"({"polynomials": [[[["1"]]]]})";
+    const std::string json = R"({"PositiveMatrixWithPrefactorArray":[)"
+                             + matrix + "," + matrix + "]}";
+
+    const auto index = index_json(json);
+    REQUIRE(!index.objective.has_value());
+    REQUIRE(!index.normalization.has_value());
+    REQUIRE(index.matrices.size() == 2);
+    REQUIRE(substr(json, index.matrices.at(0)) == matrix);
+    REQUIRE(substr(json, index.matrices.at(1)) == matrix);
+  }
+
+  SECTION("empty")
+  {
+    for(const std::string json :
+        {"{}", " { } ", R"({"PositiveMatrixWithPrefactorArray": []})"})
+      {
+        CAPTURE(json);
+        const auto index = index_json(json);
+        REQUIRE(!index.objective.has_value());
+        REQUIRE(index.matrices.empty());
+      }
+  }
+
+  SECTION("invalid")
+  {
+    for(const std::string json :
+        {"", "[]", R"({"foo": 1})", R"({"objective": ["1")",
+         R"({"objective": ["1"] "normalization": ["1"]})",
+         R"({"PositiveMatrixWithPrefactorArray": {}})",
+         R"({"PositiveMatrixWithPrefactorArray": [{"a": "]})"})
+      {
+        CAPTURE(json);
+        REQUIRE_THROWS(index_json(json));
+      }
+  }
+}
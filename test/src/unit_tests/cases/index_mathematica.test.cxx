@@ -0,0 +1,68 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "pmp_read/PMP_File_Index.hxx"
+
+#include <string>
+
+namespace
+{
+  PMP_File_Index index_mathematica(const std::string &input)
+  {
+    return PMP_File_Index::create("pmp.m", input.data(),
+                                  input.data() + input.size());
+  }
+
+  std::string substr(const std::string &str, const Byte_Range &range)
+  {
+    return str.substr(range.begin, range.size());
+  }
+}
+
+TEST_CASE("index_mathematica")
+{
+  SECTION("element boundaries")
+  {
+    const std::string objective = "{1, -2.5`30}";
+    // Line continuation, as written by Mathematica
+    const std::string normalization = " {1.0\\\n, 0}";
+    const std::string matrix_0
+      = "PositiveMatrixWithPrefactor[<|\"prefactor\" -> DampedRational[1, "
+        "{-1, -0.5}, 1/4, x], \"polynomials\" -> {{{1 + 2*x, x^2}}}|>]";
+    const std::string matrix_1
+      = "\nPositiveMatrixWithPrefactor[DampedRational[1, {}, 1/E, x], "
+        "{{{(1 + x), 3}, {3, 4}}}]";
+    const std::string input = "(* comment *)\nSDP[" + objective + ","
+                              + normalization + ", {" + matrix_0 + ","
+                              + matrix_1 + "}]\n";
+
+    const auto index = index_mathematica(input);
+    REQUIRE(index.objective.has_value());
+    REQUIRE(substr(input, index.objective.value()) == objective);
+    REQUIRE(index.normalization.has_value());
+    REQUIRE(substr(input, index.normalization.value()) == normalization);
+    REQUIRE(index.matrices.size() == 2);
+    REQUIRE(substr(input, index.matrices.at(0)) == matrix_0);
+    REQUIRE(substr(input, index.matrices.at(1)) == matrix_1);
+  }
+
+  SECTION("no matrices")
+  {
+    for(const std::string input : {"SDP[{1}, {1}, {}]", "SDP[{}, {}, { }]"})
+      {
+        CAPTURE(input);
+        const auto index = index_mathematica(input);
+        REQUIRE(index.matrices.empty());
+      }
+  }
+
+  SECTION("invalid")
+  {
+    for(const std::string input :
+        {"", "{1}, {1}, {}", "SDP[{1}, {1}]", "SDP[{1}, {1}, {}, {}]",
+         "SDP[{1}, {1}, 2]", "SDP[{1}, {1}, {PositiveMatrixWithPrefactor[}]"})
+      {
+        CAPTURE(input);
+        REQUIRE_THROWS(index_mathematica(input));
+      }
+  }
+}
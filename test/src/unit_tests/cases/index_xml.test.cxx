@@ -0,0 +1,88 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "pmp_read/PMP_File_Index.hxx"
+
+#include <string>
+
+namespace
+{
+  PMP_File_Index index_xml(const std::string &xml)
+  {
+    return PMP_File_Index::create("pmp.xml", xml.data(),
+                                  xml.data() + xml.size());
+  }
+
+  std::string substr(const std::string &str, const Byte_Range &range)
+  {
+    return str.substr(range.begin, range.size());
+  }
+}
+
+TEST_CASE("index_xml")
+{
+  SECTION("element boundaries")
+  {
+    const std::string objective
+      = "<objective>\n<elt>1</elt>\n<elt>-2</elt>\n</objective>";
+    const std::string matrix_0
+      = "<polynomialVectorMatrix>\n"
+        "  <rows>1</rows><cols>1</cols>\n"
+        "  <elements><polynomialVector><polynomial><coeff>1</coeff>"
+        "</polynomial></polynomialVector></elements>\n"
+        "</polynomialVectorMatrix>";
+    // Nested tags (including ones named as top-level elements),
+    // attributes, self-closing tags, comments and CDATA containing markup
+    const std::string matrix_1
+      = "<polynomialVectorMatrix attr=\"a>b\">"
+        "<!-- </polynomialVectorMatrix> <objective> -->"
+        "<elements><![CDATA[</elements></polynomialVectorMatrix>]]>"
+        "<polynomialVector><polynomial><coeff>2</coeff></polynomial>"
+        "</polynomialVector></elements>"
+        "<objective><elt>3</elt></objective><empty/>"
+        "</polynomialVectorMatrix>";
+    const std::string xml
+      = "<?xml version=\"1.0\"?>\n"
+        "<!-- <sdp> comment before root -->\n"
+        "<sdp>\n"
+        + objective
+        + "\n<polynomialVectorMatrices>\n" + matrix_0
+        + "\n<!-- <polynomialVectorMatrix> -->\n" + matrix_1
+        + "\n</polynomialVectorMatrices>\n</sdp>\n";
+
+    const auto index = index_xml(xml);
+    REQUIRE(index.objective.has_value());
+    REQUIRE(substr(xml, index.objective.value()) == objective);
+    REQUIRE(!index.normalization.has_value());
+    REQUIRE(index.matrices.size() == 2);
+    REQUIRE(substr(xml, index.matrices.at(0)) == matrix_0);
+    REQUIRE(substr(xml, index.matrices.at(1)) == matrix_1);
+  }
+
+  SECTION("matrices without objective")
+  {
+    const std::string matrix
+      = "<polynomialVectorMatrix><rows>1</rows></polynomialVectorMatrix>";
+    const std::string xml = "<sdp><polynomialVectorMatrices>" + matrix
+                            + matrix + "</polynomialVectorMatrices></sdp>";
+
+    const auto index = index_xml(xml);
+    REQUIRE(!index.objective.has_value());
+    REQUIRE(index.matrices.size() == 2);
+    REQUIRE(substr(xml, index.matrices.at(0)) == matrix);
+    REQUIRE(substr(xml, index.matrices.at(1)) == matrix);
+  }
+
+  SECTION("invalid")
+  {
+    for(const std::string xml :
+        {"<notsdp/>", "<sdp><objective></sdp>", "<sdp><objective>",
+         "<sdp><!-- unterminated comment",
+         "<sdp><polynomialVectorMatrices><foo/></polynomialVectorMatrices>"
+         "</sdp>",
+         "<sdp><matrices/></sdp>"})
+      {
+        CAPTURE(xml);
+        REQUIRE_THROWS(index_xml(xml));
+      }
+  }
+}
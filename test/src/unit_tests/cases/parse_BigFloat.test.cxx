@@ -0,0 +1,97 @@
+#include <catch2/catch_amalgamated.hpp>
+
+#include "test_util/diff.hxx"
+#include "sdpb_util/parse_BigFloat.hxx"
+
+#include <string>
+
+using Test_Util::REQUIRE_Equal::diff;
+
+namespace
+{
+  El::BigFloat parse(const std::string &input)
+  {
+    return parse_BigFloat(input.data(), input.data() + input.size());
+  }
+}
+
+TEST_CASE("parse_BigFloat")
+{
+  SECTION("valid")
+  {
+    // Last ulp may differ from GMP string conversion
+    const int diff_precision = El::gmp::Precision() - 4;
+    for(const std::string input :
+        {"0", "-0", "0.000", "1", "-1.5", "2.25e3", "2.25E+03", ".5", "5.",
+         "1e-300", "-7e300", "0.000000000000001000", "1234567890e-10",
+         "3.14159265358979323846264338327950288419716939937510582097494459230"
+         "78164062862089986280348253421170679821480865132823066470938446095"
+         "505822317253594081284811174502841027019385211055596446229489549303"
+         "8196e-25"})
+      {
+        CAPTURE(input);
+        // GMP does not accept leading '+'
+        DIFF_PREC(parse(input), El::BigFloat(input), diff_precision);
+      }
+    DIFF(parse("+2.5"), El::BigFloat(2.5));
+  }
+
+  SECTION("leading whitespace")
+  {
+    // Leading whitespace is accepted, as in mpf_set_str()
+    DIFF(parse(" 1.5"), El::BigFloat(1.5));
+    DIFF(parse("\t\n -2.5e1"), El::BigFloat(-25));
+    DIFF(parse("  +0.5"), El::BigFloat(0.5));
+    DIFF(parse(" 1e100000000"), El::BigFloat("1e100000000"));
+    REQUIRE_THROWS(parse(" "));
+    REQUIRE_THROWS(parse(" - 1"));
+  }
+
+  SECTION("precision")
+  {
+    El::BigFloat result;
+    result.SetPrecision(64);
+    const std::string input = "0.1";
+    parse_BigFloat(input.data(), input.data() + input.size(), result);
+    REQUIRE(result.Precision() == 64);
+  }
+
+  SECTION("huge exponents")
+  {
+    // Exponents far beyond working precision are handled by mpf_set_str()
+    // instead of computing exact 10^|exponent|
+    const int diff_precision = El::gmp::Precision() - 4;
+    for(const std::string input :
+        {"1e100000000", "-2.5e-100000000", "123.456e+2000000000",
+         "0.001e-2000000000"})
+      {
+        CAPTURE(input);
+        DIFF_PREC(parse(input), El::BigFloat(input), diff_precision);
+      }
+    // Zero does not depend on exponent
+    DIFF(parse("0e100000000"), El::BigFloat(0));
+    DIFF(parse("+1e100000000"), El::BigFloat("1e100000000"));
+  }
+
+  SECTION("exponent out of range")
+  {
+    for(const std::string input :
+        {"1e3000000000", "1e-3000000000", "1e9223372036854775807",
+         "1e-9223372036854775808", "1e99999999999999999999",
+         "1e-99999999999999999999"})
+      {
+        CAPTURE(input);
+        REQUIRE_THROWS(parse(input));
+      }
+  }
+
+  SECTION("invalid")
+  {
+    for(const std::string input :
+        {"", "-", ".", "e5", "1.2.3", "1e", "1e+-5", "1x", "abc", "1 "})
+      {
+        CAPTURE(input);
+        REQUIRE_THROWS(parse(input));
+      }
+  }
+}
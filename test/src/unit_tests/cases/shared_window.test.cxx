@@ -8,6 +8,8 @@
 
 #include <El.hpp>
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 using Test_Util::REQUIRE_Equal::diff;
@@ -36,6 +38,86 @@ TEST_CASE("MPI_Shared_Window")
       }
   }
 
+  SECTION("NUMA-aware Shared_Window_Array")
+  {
+    size_t size = 100000;
+    Shared_Window_Array<double> array(comm, size, true);
+
+    INFO("Segments should cover the whole array");
+    REQUIRE(array.num_segments() > 0);
+    REQUIRE(array.num_segments() <= (size_t)El::mpi::Size(comm));
+    REQUIRE(array.segment_begin.front() == 0);
+    REQUIRE(array.segment_begin.back() == size);
+    REQUIRE(std::is_sorted(array.segment_begin.begin(),
+                           array.segment_begin.end()));
+    REQUIRE(array.segment_index < array.num_segments());
+    for(size_t s = 0; s < array.num_segments(); ++s)
+      {
+        CAPTURE(s);
+        const auto begin = array.segment_begin.at(s);
+        const auto end = array.segment_begin.at(s + 1);
+        if(begin < end)
+          {
+            REQUIRE(array.segment_of(begin) == s);
+            REQUIRE(array.segment_of(end - 1) == s);
+          }
+      }
+
+    INFO("The array is zeroed after first touch");
+    for(size_t i = 0; i < size; ++i)
+      {
+        CAPTURE(i);
+        REQUIRE(array[i] == 0);
+      }
+  }
+
+  SECTION("NUMA-aware Shared_Window_Array with emulated NUMA nodes")
+  {
+    INFO("Even and odd ranks pretend to be on different NUMA nodes");
+    const size_t rank = El::mpi::Rank(comm);
+    const size_t num_ranks = El::mpi::Size(comm);
+    size_t size = 100000;
+    Shared_Window_Array<double> array(comm, size, true, false,
+                                      static_cast<int>(rank % 2));
+
+    REQUIRE(array.num_segments() == std::min<size_t>(num_ranks, 2));
+    REQUIRE(array.segment_index == rank % 2);
+    REQUIRE(array.segment_begin.front() == 0);
+    REQUIRE(array.segment_begin.back() == size);
+    if(num_ranks > 1)
+      {
+        INFO("Segment size is proportional to the number of ranks,"
+             " rounded up to pages");
+        const size_t num_even_ranks = (num_ranks + 1) / 2;
+        CAPTURE(num_even_ranks);
+        CAPTURE(array.segment_begin);
+        REQUIRE(array.segment_begin.at(1)
+                >= size * num_even_ranks / num_ranks);
+        REQUIRE(array.segment_begin.at(1) < size);
+      }
+  }
+
+  SECTION("Shared_Window_Array with huge pages")
+  {
+    INFO("Huge pages may be unavailable, "
+         "but the window should work in any case");
+    // 32MB, enough for several 2MB pages
+    size_t size = 4 * 1024 * 1024;
+    Shared_Window_Array<double> array(comm, size, false, true);
+
+    for(size_t i = 0; i < size; ++i)
+      {
+        if(El::mpi::Rank(comm) == i % El::mpi::Size(comm))
+          array[i] = i;
+      }
+
+    array.Fence();
+    std::vector<double> expected(size);
+    std::iota(expected.begin(), expected.end(), 0.0);
+    // Single check instead of a REQUIRE for each element
+    REQUIRE(std::equal(expected.begin(), expected.end(), array.data));
+  }
+
   SECTION("Residue_Matrices_Window")
   {
     size_t num_primes = 10;
@@ -0,0 +1,101 @@
+#include <catch2/catch_amalgamated.hpp>
+#include <El.hpp>
+
+#include "pmp2sdp/Archive_Writer.hxx"
+#include "sdp_solve/Archive_Reader.hxx"
+#include "sdp_solve/Zip_Index.hxx"
+
+#include <filesystem>
+#include <map>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  std::string read_all(std::istream &stream)
+  {
+    std::stringstream ss;
+    ss << stream.rdbuf();
+    return ss.str();
+  }
+}
+
+TEST_CASE("zip_index")
+{
+  const auto zip_path
+    = fs::temp_directory_path()
+      / ("sdpb_unit_tests_zip_index_" + std::to_string(El::mpi::Rank())
+         + ".zip");
+
+  // Entries of different sizes, including empty and multi-buffer ones
+  std::map<std::string, std::string> contents;
+  contents["control.json"] = R"({"num_blocks": 3})";
+  contents["empty.json"] = "";
+  for(size_t index = 0; index < 3; ++index)
+    {
+      std::string data;
+      for(size_t i = 0; i < 5000 * (index + 1); ++i)
+        data += static_cast<char>('a' + (i * (index + 7)) % 26);
+      contents["block_data_" + std::to_string(index) + ".bin"] = data;
+    }
+
+  {
+    Archive_Writer writer(zip_path);
+    for(const auto &[name, data] : contents)
+      {
+        std::stringstream stream(data);
+        writer.write_entry(Archive_Entry(name, data.size()), stream);
+      }
+  }
+
+  const auto zip_index = Zip_Index::try_read(zip_path);
+  REQUIRE(zip_index.has_value());
+  REQUIRE(zip_index->entries.size() == contents.size());
+  CHECK(zip_index->find("block_data_3.bin") == nullptr);
+
+  // Read entries in reverse order, to check that we don't depend on scanning
+  for(auto it = contents.rbegin(); it != contents.rend(); ++it)
+    {
+      const auto &[name, data] = *it;
+      DYNAMIC_SECTION(name)
+      {
+        const auto *entry = zip_index->find(name);
+        REQUIRE(entry != nullptr);
+        REQUIRE(entry->is_stored());
+        CHECK(entry->uncompressed_size == data.size());
+
+        Zip_Entry_Reader entry_reader(zip_path, *entry);
+        std::istream stream(&entry_reader);
+        CHECK(read_all(stream) == data);
+      }
+    }
+
+  // Zip_Index and Archive_Reader should give the same result
+  {
+    Archive_Reader reader(zip_path);
+    size_t num_entries = 0;
+    while(reader.next_entry())
+      {
+        const std::string name = archive_entry_pathname(reader.entry_ptr);
+        std::istream stream(&reader);
+        CHECK(read_all(stream) == contents.at(name));
+        ++num_entries;
+      }
+    CHECK(num_entries == contents.size());
+  }
+
+  fs::remove(zip_path);
+
+  SECTION("not a zip")
+  {
+    const auto txt_path = zip_path.parent_path()
+                          / (zip_path.stem().string() + ".txt");
+    {
+      std::ofstream os(txt_path);
+      os << "This is not a zip archive";
+    }
+    CHECK(!Zip_Index::try_read(txt_path).has_value());
+    fs::remove(txt_path);
+  }
+}